@@ -16,11 +16,12 @@ additive-synth: an example implementing an additive synthesiser based on an
 #include <libraries/Gui/Gui.h>
 #include <libraries/GuiController/GuiController.h>
 #include <libraries/Scope/Scope.h>
+#include <libraries/DspCore/FastMath.h>
 #include <cmath>
 #include <vector>
 #include <sstream>
 
-#include "wavetable.h"	// This is needed for the Wavetable class
+#include <libraries/DspCore/Wavetable.h>	// This is needed for the Wavetable class
 
 // Constants that define the program behaviour
 const unsigned int kWavetableSize = 512;
@@ -88,8 +89,8 @@ void render(BelaContext *context, void *userData)
 	float midiNote = gGuiController.getSliderValue(0);		// MIDI note is first slider
 	float amplitudeDB = gGuiController.getSliderValue(1);	// Amplitude is second slider	
 	
-	float frequency = 440.0 * powf(2.0, (midiNote - 69.0) / 12.0);	// MIDI to frequency
-	float amplitude = powf(10.0, amplitudeDB / 20);		// Convert dB to linear amplitude
+	float frequency = midiToHz(midiNote);	// MIDI to frequency
+	float amplitude = dbToGain(amplitudeDB);		// Convert dB to linear amplitude
 	
 	for(unsigned int i = 0; i < gOscillators.size(); i++) {
 		// TODO 1:
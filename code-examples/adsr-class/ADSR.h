@@ -14,7 +14,7 @@ C++ Real-Time Audio Programming with Bela - Lecture 14: ADSR
 
 #pragma once
 
-#include "Ramp.h"
+#include <libraries/DspCore/Ramp.h>
 
 class ADSR {
 private:
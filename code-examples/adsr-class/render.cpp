@@ -16,11 +16,11 @@ adsr-class: Attack-Decay-Sustain-Release envelope implemented as a class
 #include <libraries/GuiController/GuiController.h>
 #include <libraries/Scope/Scope.h>
 #include <cmath>
-#include "Wavetable.h"
-#include "Ramp.h"
-#include "Debouncer.h"
+#include <libraries/DspCore/Wavetable.h>
+#include <libraries/DspCore/Ramp.h>
+#include <libraries/DspCore/Debouncer.h>
 #include "ADSR.h"
-#include "Filter.h"
+#include <libraries/DspCore/Filter.h>
 
 // Pin declarations
 const unsigned int kButtonPin = 1;
@@ -16,9 +16,9 @@ adsr: Attack-Decay-Sustain-Release envelope controlled by a button
 #include <libraries/GuiController/GuiController.h>
 #include <libraries/Scope/Scope.h>
 #include <cmath>
-#include "Wavetable.h"
-#include "Ramp.h"
-#include "Debouncer.h"
+#include <libraries/DspCore/Wavetable.h>
+#include <libraries/DspCore/Ramp.h>
+#include <libraries/DspCore/Debouncer.h>
 
 // Pin declarations
 const unsigned int kButtonPin = 1;
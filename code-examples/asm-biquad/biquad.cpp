@@ -0,0 +1,64 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 21: ARM assembly language
+asm-biquad: biquad filter in ARM assembly language, compared against C++
+*/
+
+#include "biquad.h"
+
+// One channel, with the state in local variables during the loop
+void biquadC(const float *coefficients, float *state, const float *input, float *output, unsigned int frames)
+{
+	const float b0 = coefficients[0], b1 = coefficients[1], b2 = coefficients[2];
+	const float a1 = coefficients[3], a2 = coefficients[4];
+	float x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+
+	for(unsigned int n = 0; n < frames; n++) {
+		float x = input[n];
+		float y = x * b0 + x1 * b1 + x2 * b2 - y1 * a1 - y2 * a2;
+		x2 = x1;
+		x1 = x;
+		y2 = y1;
+		y1 = y;
+		output[n] = y;
+	}
+
+	state[0] = x1;
+	state[1] = x2;
+	state[2] = y1;
+	state[3] = y2;
+}
+
+// Four channels, one after the other. The compiler may well vectorise this,
+// but nothing guarantees it.
+void biquad4C(const float *coefficients, float *state, const float *input, float *output, unsigned int frames)
+{
+	for(unsigned int channel = 0; channel < 4; channel++) {
+		const float b0 = coefficients[channel], b1 = coefficients[4 + channel], b2 = coefficients[8 + channel];
+		const float a1 = coefficients[12 + channel], a2 = coefficients[16 + channel];
+		float x1 = state[channel], x2 = state[4 + channel];
+		float y1 = state[8 + channel], y2 = state[12 + channel];
+
+		for(unsigned int n = 0; n < frames; n++) {
+			float x = input[4 * n + channel];
+			float y = x * b0 + x1 * b1 + x2 * b2 - y1 * a1 - y2 * a2;
+			x2 = x1;
+			x1 = x;
+			y2 = y1;
+			y1 = y;
+			output[4 * n + channel] = y;
+		}
+
+		state[channel] = x1;
+		state[4 + channel] = x2;
+		state[8 + channel] = y1;
+		state[12 + channel] = y2;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 21: ARM assembly language
+asm-biquad: biquad filter in ARM assembly language, compared against C++
+*/
+
+// biquad.h: block biquad filters with the same arguments in C++ and in
+// assembly language (biquad.S). All of them work out each output as
+//   y = x*b0 + x1*b1 + x2*b2 - y1*a1 - y2*a2
+// in that order, like Filter::process() in DspCore, so they give the same
+// results.
+//
+// coefficients: b0, b1, b2, a1, a2
+// state: x1, x2, y1, y2, updated at the end of the block
+// The 4-channel versions have four of each coefficient and state variable
+// (b0 for channels 0-3, then b1, ...), and interleaved input and output.
+
+#pragma once
+
+// Portable C++ versions, which run everywhere
+void biquadC(const float *coefficients, float *state, const float *input, float *output, unsigned int frames);
+void biquad4C(const float *coefficients, float *state, const float *input, float *output, unsigned int frames);
+
+// The assembly language versions are only built for ARMv7, as on Bela
+#if defined(__arm__) && defined(__ARM_ARCH_7A__)
+#define BIQUAD_ASM
+extern "C" {
+	void biquadVfp(const float *coefficients, float *state, const float *input, float *output, unsigned int frames);
+	void biquadNeon4(const float *coefficients, float *state, const float *input, float *output, unsigned int frames);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,192 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 21: ARM assembly language
+asm-biquad: biquad filter in ARM assembly language, compared against C++
+*/
+
+#include <Bela.h>
+#include <libraries/DspCore/Filter.h>
+#include <libraries/DspCore/CpuFeatures.h>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include "biquad.h"
+
+// This example runs once in setup() and then stops. It checks that each
+// version of the biquad filter gives the same output as the Filter class,
+// then times them. On Bela the assembly versions in biquad.S are included;
+// elsewhere only the C++ versions are compared.
+
+const unsigned int kBlockSize = 16;		// Frames per call, as in render()
+const unsigned int kNumBlocks = 4096;	// Blocks in the test signal
+const unsigned int kNumFrames = kBlockSize * kNumBlocks;
+const unsigned int kRepeats = 20;		// Times to run each version when timing
+const float kClockRate = 1e9;			// Bela's processor clock in Hz
+
+// Cut-off frequencies of the four filters
+const float kFrequencies[4] = {200.0, 1000.0, 4000.0, 12000.0};
+
+// Signature shared by every version
+typedef void (*BiquadFunction)(const float*, float*, const float*, float*, unsigned int);
+
+// Return the current time in seconds
+double now()
+{
+	timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Run a version over the whole signal in blocks, starting from silence
+void runBiquad(BiquadFunction biquad, const float *coefficients, const float *input, float *output, unsigned int channels)
+{
+	float state[16] = {0};
+	for(unsigned int n = 0; n < kNumFrames; n += kBlockSize)
+		biquad(coefficients, state, &input[n * channels], &output[n * channels], kBlockSize);
+}
+
+// Count how many samples of two outputs are identical, and find the
+// largest difference between them
+void compare(const char *name, const std::vector<float>& reference, const std::vector<float>& output)
+{
+	unsigned int identical = 0;
+	float maxDifference = 0;
+	for(unsigned int n = 0; n < reference.size(); n++) {
+		if(output[n] == reference[n])
+			identical++;
+		maxDifference = fmaxf(maxDifference, fabsf(output[n] - reference[n]));
+	}
+	rt_printf("%-12s %u of %u samples identical, largest difference %g\n", name,
+				identical, (unsigned int)reference.size(), maxDifference);
+}
+
+// Time a version, printing nanoseconds and clock cycles per sample
+void benchmark(const char *name, BiquadFunction biquad, const float *coefficients, const float *input, float *output, unsigned int channels)
+{
+	// Run once first, so the buffers are in the cache
+	runBiquad(biquad, coefficients, input, output, channels);
+
+	double start = now();
+	for(unsigned int i = 0; i < kRepeats; i++)
+		runBiquad(biquad, coefficients, input, output, channels);
+	double perSample = (now() - start) / ((double)kRepeats * kNumFrames * channels);
+
+	rt_printf("%-12s %6.2f ns per sample, %5.1f cycles at 1 GHz\n", name,
+				perSample * 1e9, perSample * kClockRate);
+}
+
+// The 4-channel version for this processor. biquad.S is assembled for NEON
+// whatever the compiler flags say, so check that this processor really has
+// NEON before using it.
+BiquadFunction selectBiquad4()
+{
+#ifdef BIQUAD_ASM
+	if(cpuFeatures().neon)
+		return biquadNeon4;
+#endif
+	return biquad4C;
+}
+
+// The Filter class itself, with the same signature as the others
+Filter gFilter;
+
+void filterProcess(const float *coefficients, float *state, const float *input, float *output, unsigned int frames)
+{
+	gFilter.process(input, output, frames);
+}
+
+bool setup(BelaContext *context, void *userData)
+{
+	BiquadFunction biquad4 = selectBiquad4();
+	rt_printf("Using %s for 4 channels\n", biquad4 == biquad4C ? "biquad4C" : "biquadNeon4");
+
+	// Test signal: white noise, in mono and interleaved across 4 channels
+	std::vector<float> input(kNumFrames), input4(kNumFrames * 4);
+	srand(1);
+	for(unsigned int n = 0; n < kNumFrames; n++)
+		input[n] = 2.0 * rand() / (float)RAND_MAX - 1.0;
+	for(unsigned int n = 0; n < kNumFrames * 4; n++)
+		input4[n] = 2.0 * rand() / (float)RAND_MAX - 1.0;
+
+	// Four filters, and their coefficients in the layouts biquad.h uses
+	Filter filters[4];
+	float coefficients4[20];
+	for(unsigned int channel = 0; channel < 4; channel++) {
+		filters[channel].setSampleRate(context->audioSampleRate);
+		filters[channel].setFrequency(kFrequencies[channel]);
+		filters[channel].setQ(0.707);
+		for(unsigned int i = 0; i < 5; i++)
+			coefficients4[4 * i + channel] = filters[channel].getCoefficients()[i];
+	}
+	const float *coefficients = filters[0].getCoefficients();
+
+	// Reference outputs from the Filter class
+	std::vector<float> reference(kNumFrames), reference4(kNumFrames * 4);
+	std::vector<float> output(kNumFrames), output4(kNumFrames * 4);
+	std::vector<float> channelIn(kNumFrames), channelOut(kNumFrames);
+	gFilter = filters[0];
+	runBiquad(filterProcess, coefficients, input.data(), reference.data(), 1);
+	for(unsigned int channel = 0; channel < 4; channel++) {
+		for(unsigned int n = 0; n < kNumFrames; n++)
+			channelIn[n] = input4[4 * n + channel];
+		gFilter = filters[channel];
+		runBiquad(filterProcess, coefficients, channelIn.data(), channelOut.data(), 1);
+		for(unsigned int n = 0; n < kNumFrames; n++)
+			reference4[4 * n + channel] = channelOut[n];
+	}
+
+	// Check each version against the Filter class
+	rt_printf("One channel:\n");
+	runBiquad(biquadC, coefficients, input.data(), output.data(), 1);
+	compare("biquadC", reference, output);
+#ifdef BIQUAD_ASM
+	runBiquad(biquadVfp, coefficients, input.data(), output.data(), 1);
+	compare("biquadVfp", reference, output);
+#endif
+	rt_printf("Four channels:\n");
+	runBiquad(biquad4C, coefficients4, input4.data(), output4.data(), 4);
+	compare("biquad4C", reference4, output4);
+#ifdef BIQUAD_ASM
+	if(biquad4 == biquadNeon4) {
+		runBiquad(biquadNeon4, coefficients4, input4.data(), output4.data(), 4);
+		compare("biquadNeon4", reference4, output4);
+	}
+#endif
+
+	// Then time them
+	rt_printf("Timing, %u frames in blocks of %u:\n", kNumFrames, kBlockSize);
+	benchmark("Filter", filterProcess, coefficients, input.data(), output.data(), 1);
+	benchmark("biquadC", biquadC, coefficients, input.data(), output.data(), 1);
+#ifdef BIQUAD_ASM
+	benchmark("biquadVfp", biquadVfp, coefficients, input.data(), output.data(), 1);
+#endif
+	benchmark("biquad4C", biquad4C, coefficients4, input4.data(), output4.data(), 4);
+#ifdef BIQUAD_ASM
+	if(biquad4 == biquadNeon4)
+		benchmark("biquadNeon4", biquadNeon4, coefficients4, input4.data(), output4.data(), 4);
+	else
+		rt_printf("(This processor has no NEON, so biquad4C is used for 4 channels)\n");
+#else
+	rt_printf("(The assembly language versions only run on Bela)\n");
+#endif
+
+	return true;
+}
+
+void render(BelaContext *context, void *userData)
+{
+	gShouldStop = true;		// Stop the audio rendering
+}
+
+void cleanup(BelaContext *context, void *userData)
+{
+
+}
\ No newline at end of file
@@ -13,7 +13,7 @@ circular-buffer: template code for implementing delays
 
 #include <Bela.h>
 #include <vector>
-#include "MonoFilePlayer.h"
+#include <libraries/DspCore/MonoFilePlayer.h>
 
 // Name of the sound file (in project folder)
 std::string gFilename = "slow-drum-loop.wav";
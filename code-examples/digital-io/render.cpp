@@ -13,6 +13,7 @@ digital-io: a test project using a button and LED to control a noise source
 
 #include <Bela.h>
 #include <libraries/Scope/Scope.h>
+#include <libraries/DspCore/Noise.h>
 
 // Pin definitions: see the pin diagram in the IDE for the wiring
 const int kButtonPin = 1;
@@ -21,6 +22,9 @@ const int kLedPin = 0;
 // Bela oscilloscope
 Scope gScope;
 
+// White noise generator: unlike rand(), it is fast and never takes a lock
+WhiteNoise gNoise;
+
 bool setup(BelaContext *context, void *userData)
 {
 	// Check that audio and digital have the same number of frames
@@ -53,7 +57,7 @@ void render(BelaContext *context, void *userData)
 			// Reading LOW (0) means button was pressed
 			
 			// Generate white noise: random values between -1 and 1
-			float noise = 2.0 * (float)rand() / (float)RAND_MAX - 1.0;
+			float noise = gNoise.process();
 			out = noise * 0.1;
 			
 			// Turn on LED
@@ -7,7 +7,7 @@
 
 http://bela.io
 
-C++ Real-Time Audio Programming with Bela - Lecture 15: MIDI part 1
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
 */
 
 // ADSR.cpp: implement the ADSR (attack-decay-sustain-release) class
@@ -7,7 +7,7 @@
 
 http://bela.io
 
-C++ Real-Time Audio Programming with Bela - Lecture 16: MIDI part 2
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
 */
 
 // ADSR.h: header file for defining the ADSR class
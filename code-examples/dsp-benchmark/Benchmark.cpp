@@ -0,0 +1,76 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+*/
+
+// Benchmark.cpp: CPU pinning and reporting for the benchmarks
+
+#include <Bela.h>
+#include <algorithm>
+#include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+#include "Benchmark.h"
+
+// Pin the thread and open the output file
+bool Benchmark::setup(const std::string& filename, int cpu)
+{
+#ifdef __linux__
+	// Running on the same CPU every time keeps the caches warm and stops the
+	// scheduler moving us to a core which may be running at another speed
+	if(cpu < 0)
+		cpu = sysconf(_SC_NPROCESSORS_ONLN) - 1;
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	CPU_SET(cpu, &cpus);
+	if(sched_setaffinity(0, sizeof(cpus), &cpus) != 0)
+		rt_printf("Warning: unable to pin the benchmark to CPU %d\n", cpu);
+	else
+		rt_printf("Benchmarks running on CPU %d\n", cpu);
+#endif
+
+	file_ = fopen(filename.c_str(), "w");
+	if(file_ == nullptr) {
+		rt_printf("Unable to open '%s' for writing\n", filename.c_str());
+		return false;
+	}
+	fprintf(file_, "benchmark,parameter,value,unit,median_ns,min_ns,max_ns,calls_per_run\n");
+
+	rt_printf("%-28s %-10s %6s %12s %12s %12s\n", "benchmark", "parameter", "value",
+			  "median (ns)", "min (ns)", "max (ns)");
+	return true;
+}
+
+// Print one line to the console and one line to the CSV file
+void Benchmark::report(const char *name, const char *parameter, int value, const char *unit,
+					   std::vector<double>& nsPerUnit, unsigned int callsPerRepetition)
+{
+	std::sort(nsPerUnit.begin(), nsPerUnit.end());
+	double median = nsPerUnit[nsPerUnit.size() / 2];
+	double fastest = nsPerUnit.front();
+	double slowest = nsPerUnit.back();
+
+	rt_printf("%-28s %-10s %6d %9.2f/%-3s %12.2f %12.2f\n", name, parameter, value,
+			  median, unit, fastest, slowest);
+
+	if(file_ != nullptr) {
+		fprintf(file_, "%s,%s,%d,%s,%.3f,%.3f,%.3f,%u\n", name, parameter, value, unit,
+				median, fastest, slowest, callsPerRepetition);
+		fflush(file_);
+	}
+}
+
+// Destructor
+Benchmark::~Benchmark()
+{
+	if(file_ != nullptr)
+		fclose(file_);
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+*/
+
+// Benchmark.h: time small pieces of DSP code and report the cost per sample
+// (or per FFT hop). Each benchmark is warmed up until its timing settles,
+// then measured several times; the median, fastest and slowest runs are
+// printed and saved to a CSV file so results can be compared between builds.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
+
+class Benchmark {
+public:
+	static const int kRepetitions = 15;				// Measurements kept per benchmark
+	static const int kMaxWarmupRepetitions = 50;	// Give up waiting for stable timing after this
+	static constexpr double kRepetitionTime = 0.01;	// Target length of one measurement in seconds
+	static constexpr double kStableRatio = 0.02;	// Warm-up ends when runs agree within 2%
+
+	// Constructor
+	Benchmark() {}
+
+	// Pin this thread to one CPU (the last one if cpu < 0) and open the CSV
+	// file for the results. Returns true on success.
+	bool setup(const std::string& filename, int cpu = -1);
+
+	// Measure a function which processes unitsPerCall units (samples, hops...)
+	// each time it is called and returns a value which depends on its output.
+	// The result is reported as nanoseconds per unit.
+	template<class Function>
+	void run(const char *name, const char *parameter, int value,
+			 unsigned int unitsPerCall, const char *unit, Function function);
+
+	// Destructor
+	~Benchmark();
+
+private:
+	// Time in nanoseconds from the monotonic clock
+	static uint64_t now() {
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+	}
+
+	// Print and save the measurements of one benchmark
+	void report(const char *name, const char *parameter, int value, const char *unit,
+				std::vector<double>& nsPerUnit, unsigned int callsPerRepetition);
+
+	FILE *file_ = nullptr;			// CSV output
+	volatile float sink_ = 0;		// Keeps the compiler from removing the code being timed
+};
+
+// Run the function repeatedly in timed batches. The number of calls in each
+// batch is chosen so that a batch lasts about kRepetitionTime, which is much
+// longer than the resolution of the clock.
+template<class Function>
+void Benchmark::run(const char *name, const char *parameter, int value,
+					unsigned int unitsPerCall, const char *unit, Function function)
+{
+	// Find how many calls make up one batch
+	unsigned int calls = 1;
+	while(1) {
+		uint64_t start = now();
+		for(unsigned int i = 0; i < calls; i++)
+			sink_ = sink_ + function();
+		uint64_t elapsed = now() - start;
+		if(elapsed >= kRepetitionTime * 1e9 || calls >= (1U << 30))
+			break;
+		calls *= 2;
+	}
+
+	// Time one batch, returning nanoseconds per unit
+	auto measure = [&]() {
+		uint64_t start = now();
+		for(unsigned int i = 0; i < calls; i++)
+			sink_ = sink_ + function();
+		return (double)(now() - start) / ((double)calls * unitsPerCall);
+	};
+
+	// Warm up the caches, branch predictors and CPU clock: keep going until
+	// three batches in a row agree with each other
+	double previous[2] = {measure(), measure()};
+	for(int i = 0; i < kMaxWarmupRepetitions; i++) {
+		double current = measure();
+		double lowest = std::min(current, std::min(previous[0], previous[1]));
+		double highest = std::max(current, std::max(previous[0], previous[1]));
+		previous[0] = previous[1];
+		previous[1] = current;
+		if(highest - lowest <= kStableRatio * lowest)
+			break;
+	}
+
+	// Take the measurements which will be reported
+	std::vector<double> nsPerUnit(kRepetitions);
+	for(int i = 0; i < kRepetitions; i++)
+		nsPerUnit[i] = measure();
+
+	report(name, parameter, value, unit, nsPerUnit, calls);
+}
\ No newline at end of file
@@ -7,7 +7,7 @@
 
 http://bela.io
 
-C++ Real-Time Audio Programming with Bela - Lecture 12: Envelopes
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
 */
 
 // Filter.cpp: implement a second-order lowpass filter of variable frequency and Q
@@ -0,0 +1,150 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+*/
+
+// FixedPointBlocks.cpp: see FixedPointBlocks.h
+
+#include <libraries/DspCore/Wavetable.h>
+#include <libraries/DspCore/WavetableQ15.h>
+#include <libraries/DspCore/Filter.h>
+#include <libraries/DspCore/FilterQ31.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "FixedPointBlocks.h"
+
+static const float kOscillatorFrequency = 440.0;
+static const float kFilterFrequency = 1000.0;
+static const float kFilterQ = 0.707;
+
+static float gSampleRate;
+static std::vector<float> gSineTable(512);
+static dsp::Wavetable gWavetable;
+static WavetableQ15 gWavetableQ15;
+static dsp::Filter gFilter;
+static FilterQ31 gFilterQ31;
+
+// Noise input for the filters, and output blocks, in both formats
+static std::vector<float> gInput, gOutput;
+static std::vector<Q31> gInputQ31, gOutputQ31;
+static std::vector<Q15> gOutputQ15;
+
+// Set up a pair of filters the same way
+template<class FilterType>
+static void setupFilter(FilterType& filter, float sampleRate)
+{
+	filter.setSampleRate(sampleRate);
+	filter.setFrequency(kFilterFrequency);
+	filter.setQ(kFilterQ);
+}
+
+void fixedPointSetup(float sampleRate, unsigned int maxBlockSize)
+{
+	gSampleRate = sampleRate;
+	for(unsigned int n = 0; n < gSineTable.size(); n++)
+		gSineTable[n] = sinf(2.0 * M_PI * n / gSineTable.size());
+
+	gWavetable.setup(sampleRate, gSineTable);
+	gWavetable.setFrequency(kOscillatorFrequency);
+	gWavetableQ15.setup(sampleRate, gSineTable);
+	gWavetableQ15.setFrequency(kOscillatorFrequency);
+	setupFilter(gFilter, sampleRate);
+	setupFilter(gFilterQ31, sampleRate);
+
+	gInput.resize(maxBlockSize);
+	gOutput.resize(maxBlockSize);
+	gInputQ31.resize(maxBlockSize);
+	gOutputQ31.resize(maxBlockSize);
+	gOutputQ15.resize(maxBlockSize);
+	for(unsigned int n = 0; n < maxBlockSize; n++)
+		gInput[n] = rand() / (float)RAND_MAX - 0.5;
+	toFixed(gInput.data(), gInputQ31.data(), maxBlockSize);
+}
+
+float wavetableFloatProcess(unsigned int frames)
+{
+	gWavetable.process(gOutput.data(), frames);
+	return gOutput[frames - 1];
+}
+
+float wavetableQ15Process(unsigned int frames)
+{
+	gWavetableQ15.process(gOutputQ15.data(), frames);
+	return gOutputQ15[frames - 1].raw();
+}
+
+float filterFloatProcess(unsigned int frames)
+{
+	gFilter.process(gInput.data(), gOutput.data(), frames);
+	return gOutput[frames - 1];
+}
+
+float filterQ31Process(unsigned int frames)
+{
+	gFilterQ31.process(gInputQ31.data(), gOutputQ31.data(), frames);
+	return gOutputQ31[frames - 1].raw();
+}
+
+// Signal-to-noise ratio in dB from the sums of the squares
+static float snr(double signal, double noise)
+{
+	return 10.0 * log10(signal / noise);
+}
+
+float wavetableSnr(bool fixedPoint)
+{
+	dsp::Wavetable oscillator(gSampleRate, gSineTable);
+	WavetableQ15 oscillatorQ15(gSampleRate, gSineTable);
+	oscillator.setFrequency(kOscillatorFrequency);
+	oscillatorQ15.setFrequency(kOscillatorFrequency);
+
+	// Each oscillator moves its phase before reading the table, so the first
+	// output is one sample into the sine wave
+	double signal = 0, noise = 0;
+	for(unsigned int n = 1; n <= gSampleRate; n++) {
+		double reference = sin(2.0 * M_PI * kOscillatorFrequency * n / gSampleRate);
+		double out = fixedPoint ? oscillatorQ15.process().toFloat() : oscillator.process();
+		signal += reference * reference;
+		noise += (out - reference) * (out - reference);
+	}
+	return snr(signal, noise);
+}
+
+float filterSnr(bool fixedPoint)
+{
+	dsp::Filter filter;
+	FilterQ31 filterQ31;
+	setupFilter(filter, gSampleRate);
+	setupFilter(filterQ31, gSampleRate);
+
+	// The reference uses the same coefficients, so only the rounding of the
+	// arithmetic is measured
+	const float *coefficients = filter.getCoefficients();
+	double b0 = coefficients[0], b1 = coefficients[1], b2 = coefficients[2];
+	double a1 = coefficients[3], a2 = coefficients[4];
+	double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+	double signal = 0, noise = 0;
+	for(unsigned int n = 0; n < gSampleRate; n++) {
+		Q31 input = Q31::fromFloat(rand() / (float)RAND_MAX - 0.5);
+		double x = input.toFloat();
+		double reference = x * b0 + x1 * b1 + x2 * b2 - y1 * a1 - y2 * a2;
+		x2 = x1;
+		x1 = x;
+		y2 = y1;
+		y1 = reference;
+
+		double out = fixedPoint ? filterQ31.process(input).toFloat() : filter.process(input.toFloat());
+		signal += reference * reference;
+		noise += (out - reference) * (out - reference);
+	}
+	return snr(signal, noise);
+}
\ No newline at end of file
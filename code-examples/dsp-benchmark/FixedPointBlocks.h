@@ -0,0 +1,33 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+*/
+
+// FixedPointBlocks.h: the DspCore wavetable oscillator and filter against
+// their fixed-point versions (WavetableQ15 and FilterQ31), block by block,
+// and a measure of how accurate each version is. They are in their own file
+// because this folder has its own Wavetable and Filter classes.
+
+#pragma once
+
+// Set up every version. The oscillators play a sine wave at 440Hz and the
+// filters are 1kHz low-pass filters fed with noise.
+void fixedPointSetup(float sampleRate, unsigned int maxBlockSize);
+
+// Calculate one block with each version
+float wavetableFloatProcess(unsigned int frames);
+float wavetableQ15Process(unsigned int frames);
+float filterFloatProcess(unsigned int frames);
+float filterQ31Process(unsigned int frames);
+
+// Signal-to-noise ratio in dB of one second of output, against the same
+// calculation in double precision
+float wavetableSnr(bool fixedPoint);
+float filterSnr(bool fixedPoint);
\ No newline at end of file
@@ -0,0 +1,54 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+*/
+
+// FmSynthBlocks.cpp: see FmSynthBlocks.h
+
+#include <libraries/DspCore/FmSynth.h>
+#include "FmSynthBlocks.h"
+
+static FmSynth<4> gSynth4;
+static FmSynth<6> gSynth6;
+
+// Every operator at a different whole-number ratio, with a sustained
+// envelope so the voices keep playing through the measurements
+template<unsigned int kOperators>
+static void setupSynth(FmSynth<kOperators>& synth, const FmAlgorithm& algorithm,
+					   float sampleRate, unsigned int numVoices)
+{
+	synth.setup(sampleRate, numVoices);
+	synth.setAlgorithm(algorithm);
+	for(unsigned int op = 0; op < kOperators; op++) {
+		synth.setOperator(op, op + 1, 1);
+		synth.setEnvelope(op, 0.01, 0.5, 0.8, 0.5);
+	}
+	synth.setFeedback(0.5);
+	for(unsigned int voice = 0; voice < numVoices; voice++)
+		synth.noteOn(48 + voice, 0.8);
+}
+
+void fmSynthSetup(float sampleRate, unsigned int numVoices)
+{
+	setupSynth(gSynth4, fm::kStack, sampleRate, numVoices);
+	setupSynth(gSynth6, fm::kDx7Algorithm5, sampleRate, numVoices);
+}
+
+float fmSynth4Process(float *output, unsigned int frames)
+{
+	gSynth4.process(output, frames);
+	return output[frames - 1];
+}
+
+float fmSynth6Process(float *output, unsigned int frames)
+{
+	gSynth6.process(output, frames);
+	return output[frames - 1];
+}
\ No newline at end of file
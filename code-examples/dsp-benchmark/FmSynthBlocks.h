@@ -0,0 +1,24 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+*/
+
+// FmSynthBlocks.h: the DspCore FM synth with 4 and 6 operators, block by
+// block. They are in their own file because this folder has its own ADSR
+// class.
+
+#pragma once
+
+// Set up both synths with every voice playing a note
+void fmSynthSetup(float sampleRate, unsigned int numVoices);
+
+// Calculate one block of each synth
+float fmSynth4Process(float *output, unsigned int frames);
+float fmSynth6Process(float *output, unsigned int frames);
\ No newline at end of file
@@ -0,0 +1,108 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+*/
+
+// GraphVoices.cpp: see GraphVoices.h
+
+#include <libraries/DspCore/Wavetable.h>
+#include <libraries/DspCore/Filter.h>
+#include <libraries/DspCore/ADSR.h>
+#include <libraries/DspCore/ProcessingGraph.h>
+#include <memory>
+#include <cstring>
+#include "GraphVoices.h"
+
+// The objects for one voice
+struct GraphVoice {
+	dsp::Wavetable oscillator;
+	dsp::Filter filter;
+	dsp::ADSR envelope;
+
+	void setup(float sampleRate, std::vector<float>& wavetable, int index) {
+		oscillator.setup(sampleRate, wavetable);
+		oscillator.setFrequency(110.0 * (index + 1));
+		filter.setSampleRate(sampleRate);
+		filter.setFrequency(2000.0);
+		filter.setQ(2.0);
+		envelope.setSampleRate(sampleRate);
+		envelope.setSustainLevel(0.5);
+		envelope.trigger();
+	}
+};
+
+// Separate objects for each version, so they run from the same state
+static std::vector<GraphVoice> gHandWiredVoices;
+static std::vector<GraphVoice> gGraphVoices;
+static std::vector<GraphVoice> gParallelVoices;
+static std::unique_ptr<ProcessingGraph> gGraph;
+static std::unique_ptr<ProcessingGraph> gParallelGraph;
+
+// Connect each voice's nodes and mix them together
+static ProcessingGraph* buildGraph(std::vector<GraphVoice>& voices)
+{
+	ProcessingGraph *graph = new ProcessingGraph;
+	ProcessorNode *mixer = graph->add<MixerNode>(voices.size());
+	for(unsigned int v = 0; v < voices.size(); v++) {
+		ProcessorNode *oscillator = graph->add<SourceNode<dsp::Wavetable>>(voices[v].oscillator);
+		ProcessorNode *filter = graph->add<EffectNode<dsp::Filter>>(voices[v].filter);
+		ProcessorNode *envelope = graph->add<SourceNode<dsp::ADSR>>(voices[v].envelope);
+		ProcessorNode *vca = graph->add<MultiplyNode>();
+		graph->connect(oscillator, filter);
+		graph->connect(filter, vca, 0);
+		graph->connect(envelope, vca, 1);
+		graph->connect(vca, mixer, v);
+	}
+	graph->setOutput(mixer);
+	return graph;
+}
+
+void graphVoicesSetup(float sampleRate, std::vector<float>& wavetable, int voices, unsigned int maxBlockSize,
+					  ParallelScheduler *scheduler)
+{
+	gHandWiredVoices = std::vector<GraphVoice>(voices);
+	gGraphVoices = std::vector<GraphVoice>(voices);
+	gParallelVoices = std::vector<GraphVoice>(voices);
+	for(int v = 0; v < voices; v++) {
+		gHandWiredVoices[v].setup(sampleRate, wavetable, v);
+		gGraphVoices[v].setup(sampleRate, wavetable, v);
+		gParallelVoices[v].setup(sampleRate, wavetable, v);
+	}
+
+	gGraph.reset(buildGraph(gGraphVoices));
+	gGraph->setup(maxBlockSize);
+	gParallelGraph.reset(buildGraph(gParallelVoices));
+	// Share out every block size, so the benchmark shows where it starts to pay
+	gParallelGraph->setScheduler(scheduler, 0);
+	gParallelGraph->setup(maxBlockSize);
+}
+
+float handWiredVoicesProcess(float *output, unsigned int frames)
+{
+	for(unsigned int n = 0; n < frames; n++) {
+		float out = 0;
+		for(GraphVoice& voice : gHandWiredVoices)
+			out += voice.filter.process(voice.oscillator.process()) * voice.envelope.process();
+		output[n] = out;
+	}
+	return output[frames - 1];
+}
+
+float graphVoicesProcess(float *output, unsigned int frames)
+{
+	memcpy(output, gGraph->process(frames), frames * sizeof(float));
+	return output[frames - 1];
+}
+
+float parallelGraphVoicesProcess(float *output, unsigned int frames)
+{
+	memcpy(output, gParallelGraph->process(frames), frames * sizeof(float));
+	return output[frames - 1];
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+*/
+
+// GraphVoices.h: the synth voices from benchmarkVoices(), built from the
+// DspCore classes in three ways: wired together by hand in a loop over every
+// sample, connected as a ProcessingGraph which processes a block per node,
+// and the same graph running its voices on a ParallelScheduler.
+
+#pragma once
+
+#include <vector>
+#include <libraries/DspCore/ParallelScheduler.h>
+
+// Set up the given number of voices for every version
+void graphVoicesSetup(float sampleRate, std::vector<float>& wavetable, int voices, unsigned int maxBlockSize,
+					  ParallelScheduler *scheduler);
+
+// Calculate one block of the sum of the voices
+float handWiredVoicesProcess(float *output, unsigned int frames);
+float graphVoicesProcess(float *output, unsigned int frames);
+float parallelGraphVoicesProcess(float *output, unsigned int frames);
\ No newline at end of file
@@ -60,7 +60,7 @@ float MonoFilePlayer::process()
     readPointer_++;
     
     // If we reach the end, decide whether to loop or stop
-    if(readPointer_ >= sampleBuffer_.size()) {
+    if(readPointer_ >= (int)sampleBuffer_.size()) {
      	readPointer_ = 0;
      	if(!loop_)
      		isPlaying_ = false;
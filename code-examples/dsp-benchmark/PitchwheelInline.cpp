@@ -0,0 +1,31 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+*/
+
+// PitchwheelInline.cpp: the midi-pitchwheel loop using the header-only
+// DspCore library, where the compiler can inline every process()
+
+#include <libraries/DspCore/Wavetable.h>
+#include <libraries/DspCore/Filter.h>
+#include <libraries/DspCore/ADSR.h>
+#include "PitchwheelVoice.h"
+
+static PitchwheelVoice<dsp::Wavetable, dsp::Filter, dsp::ADSR> gVoice;
+
+void pitchwheelInlineSetup(float sampleRate, std::vector<float>& wavetable)
+{
+	gVoice.setup(sampleRate, wavetable);
+}
+
+float pitchwheelInlineProcess(float *output, unsigned int frames)
+{
+	return gVoice.process(output, frames);
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+*/
+
+// PitchwheelOutOfLine.cpp: the midi-pitchwheel loop using the classes in this
+// folder, where every process() is a call into another file
+
+#include "Wavetable.h"
+#include "Filter.h"
+#include "ADSR.h"
+#include "PitchwheelVoice.h"
+
+static PitchwheelVoice<Wavetable, Filter, ADSR> gVoice;
+
+void pitchwheelOutOfLineSetup(float sampleRate, std::vector<float>& wavetable)
+{
+	gVoice.setup(sampleRate, wavetable);
+}
+
+float pitchwheelOutOfLineProcess(float *output, unsigned int frames)
+{
+	return gVoice.process(output, frames);
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+*/
+
+// PitchwheelVoice.h: the loop from render() in midi-pitchwheel, written as a
+// template so that it can be built against two versions of the classes:
+// the ones in this folder, whose process() methods are in .cpp files, and
+// the header-only DspCore library, whose process() methods can be inlined.
+// Each version is built in its own file: PitchwheelOutOfLine.cpp and
+// PitchwheelInline.cpp.
+
+#pragma once
+
+#include <vector>
+
+template<class WavetableType, class FilterType, class ADSRType>
+class PitchwheelVoice {
+public:
+	// Set up the objects the same way as midi-pitchwheel with its default sliders
+	void setup(float sampleRate, std::vector<float>& wavetable) {
+		sampleRate_ = sampleRate;
+		oscillator_.setup(sampleRate, wavetable);
+		filter_.setSampleRate(sampleRate);
+		filter_.setQ(4);
+		amplitudeADSR_.setSampleRate(sampleRate);
+		amplitudeADSR_.setAttackTime(0.01);
+		amplitudeADSR_.setDecayTime(0.05);
+		amplitudeADSR_.setSustainLevel(0.3);
+		amplitudeADSR_.setReleaseTime(0.2);
+		filterADSR_.setSampleRate(sampleRate);
+		filterADSR_.setAttackTime(0.05);
+		filterADSR_.setDecayTime(0.1);
+		filterADSR_.setSustainLevel(0.6);
+		filterADSR_.setReleaseTime(0.3);
+	}
+
+	// Calculate one block. A note is played for half a second, then released.
+	float process(float *output, unsigned int frames) {
+		if(noteFrames_ == 0) {
+			amplitudeADSR_.trigger();
+			filterADSR_.trigger();
+			noteOn_ = true;
+		}
+		else if(noteOn_ && noteFrames_ >= 0.5 * sampleRate_) {
+			amplitudeADSR_.release();
+			filterADSR_.release();
+			noteOn_ = false;
+		}
+		noteFrames_ += frames;
+		if(noteFrames_ >= sampleRate_)
+			noteFrames_ = 0;
+
+		for(unsigned int n = 0; n < frames; n++) {
+			oscillator_.setFrequency(frequency_);
+			float amplitude = amplitude_ * amplitudeADSR_.process();
+			float filterControl = filterADSR_.process();
+			filter_.setFrequency(filterBase_ + filterSensitivity_ * filterControl);
+			float out = oscillator_.process() * amplitude;
+			output[n] = 0.5 * filter_.process(out);
+		}
+		return output[frames - 1];
+	}
+
+private:
+	WavetableType oscillator_;
+	FilterType filter_;
+	ADSRType amplitudeADSR_, filterADSR_;
+	float sampleRate_ = 44100;
+	float frequency_ = 440.0;
+	float amplitude_ = 0.5;
+	float filterBase_ = 200;
+	float filterSensitivity_ = 3000;
+	unsigned int noteFrames_ = 0;
+	bool noteOn_ = false;
+};
+
+// Each function runs a single voice, built against one version of the classes
+void pitchwheelOutOfLineSetup(float sampleRate, std::vector<float>& wavetable);
+float pitchwheelOutOfLineProcess(float *output, unsigned int frames);
+void pitchwheelInlineSetup(float sampleRate, std::vector<float>& wavetable);
+float pitchwheelInlineProcess(float *output, unsigned int frames);
\ No newline at end of file
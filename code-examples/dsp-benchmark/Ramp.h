@@ -7,7 +7,7 @@
 
 http://bela.io
 
-C++ Real-Time Audio Programming with Bela - Lecture 15: MIDI part 1
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
 */
 
 // Ramp.h: header file for defining a second order resonant kow pass filter
@@ -7,7 +7,7 @@
 
 http://bela.io
 
-C++ Real-Time Audio Programming with Bela - Lecture 16: MIDI part 2
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
 */
 
 // Wavetable.cpp: file for implementing the wavetable oscillator class
@@ -63,7 +63,7 @@ float Wavetable::process() {
 		// If we get to the end of the buffer, wrap around to 0.
 		int indexBelow = floorf(readPointer_);
 		int indexAbove = indexBelow + 1;
-		if(indexAbove >= table_.size())
+		if(indexAbove >= (int)table_.size())
 			indexAbove = 0;
 	
 		// For linear interpolation, we need to decide how much to weigh each
@@ -7,7 +7,7 @@
 
 http://bela.io
 
-C++ Real-Time Audio Programming with Bela - Lecture 14: ADSR
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
 */
 
 // Wavetable.h: header file for wavetable oscillator class
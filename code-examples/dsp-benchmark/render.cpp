@@ -0,0 +1,923 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+dsp-benchmark: measure the cost of the DSP building blocks used in the course
+*/
+
+#include <Bela.h>
+#include <libraries/Fft/Fft.h>
+#include <libraries/AudioFile/AudioFile.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/Kernels.h>
+#include <libraries/DspCore/PolyBlep.h>
+#include <libraries/DspCore/WavetableScanner.h>
+#include <libraries/DspCore/UnisonOscillator.h>
+#include <libraries/DspCore/Noise.h>
+#include <libraries/DspCore/LfoBank.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <string>
+#include "Benchmark.h"
+#include "Wavetable.h"
+#include "Filter.h"
+#include "Ramp.h"
+#include "ADSR.h"
+#include "ExponentialSegment.h"
+#include "MonoFilePlayer.h"
+#include "PitchwheelVoice.h"
+#include "GraphVoices.h"
+#include "FixedPointBlocks.h"
+#include "FmSynthBlocks.h"
+
+// Where the results are saved (in the project folder)
+std::string gResultsFilename = "benchmark.csv";
+
+// Sound file generated for the MonoFilePlayer benchmark
+std::string gSourceFilename = "benchmark-source.wav";
+
+// Sizes to measure: audio block sizes, number of synth voices and FFT sizes
+std::vector<int> gBlockSizes = {16, 64, 256};
+std::vector<int> gVoiceCounts = {1, 4, 16};
+std::vector<int> gFftSizes = {256, 512, 1024, 2048, 4096};
+
+// Block size used for the benchmarks that vary something else
+const int gDefaultBlockSize = 16;
+
+Benchmark gBenchmark;
+
+// Buffer that each benchmark writes its output into
+std::vector<float> gBlock;
+
+// Everything needed by the process_fft() bodies for one FFT size. These are
+// the same steps as the phase vocoder examples, but with the size passed in
+// instead of fixed at compile time.
+struct FftState {
+	Fft fft;
+	int fftSize;
+	int hopSize;
+	int bufferSize;
+	std::vector<float> inputBuffer;
+	std::vector<float> outputBuffer;
+	std::vector<float> unwrappedBuffer;
+	std::vector<float> window;
+	std::vector<float> lastInputPhases;
+	std::vector<float> lastOutputPhases;
+	std::vector<float> magnitudes;
+	std::vector<float> frequencies;
+	unsigned int pointer;
+
+	void setup(int size) {
+		fftSize = size;
+		hopSize = size / 4;
+		bufferSize = 4 * size;
+		fft.setup(fftSize);
+		inputBuffer.resize(bufferSize);
+		outputBuffer.resize(bufferSize);
+		unwrappedBuffer.resize(fftSize);
+		window.resize(fftSize);
+		lastInputPhases.resize(fftSize / 2 + 1);
+		lastOutputPhases.resize(fftSize / 2 + 1);
+		magnitudes.resize(fftSize / 2 + 1);
+		frequencies.resize(fftSize / 2 + 1);
+		pointer = 0;
+
+		// Hann window and an input of low-level noise
+		for(int n = 0; n < fftSize; n++)
+			window[n] = 0.5f * (1.0f - cosf(2.0 * M_PI * n / (float)(fftSize - 1)));
+		for(int n = 0; n < bufferSize; n++)
+			inputBuffer[n] = 0.1 * (rand() / (float)RAND_MAX - 0.5);
+	}
+
+	// Copy one window of the circular input buffer into the FFT input
+	void unwrapInput() {
+		for(int n = 0; n < fftSize; n++) {
+			int circularBufferIndex = (pointer + n - fftSize + bufferSize) % bufferSize;
+			unwrappedBuffer[n] = inputBuffer[circularBufferIndex] * window[n];
+		}
+	}
+
+	// Add the FFT output into the circular output buffer and move on one hop
+	float overlapAddOutput() {
+		for(int n = 0; n < fftSize; n++) {
+			int circularBufferIndex = (pointer + n) % bufferSize;
+			outputBuffer[circularBufferIndex] += fft.td(n) * window[n];
+		}
+		float out = outputBuffer[pointer];
+		for(int n = 0; n < hopSize; n++)
+			outputBuffer[(pointer + n) % bufferSize] = 0;
+		pointer = (pointer + hopSize) % bufferSize;
+		return out;
+	}
+};
+
+// Wrap a phase value to the range -pi to pi
+float wrapPhase(float phaseIn)
+{
+	if (phaseIn >= 0)
+		return fmodf(phaseIn + M_PI, 2.0 * M_PI) - M_PI;
+	else
+		return fmodf(phaseIn - M_PI, -2.0 * M_PI) + M_PI;
+}
+
+// process_fft() body from fft-overlap-add: FFT and inverse FFT with no changes
+float process_fft_passthrough(FftState& state)
+{
+	state.unwrapInput();
+	state.fft.fft(state.unwrappedBuffer);
+	state.fft.ifft();
+	return state.overlapAddOutput();
+}
+
+// process_fft() body from fft-robotisation: set every phase to zero
+float process_fft_robotisation(FftState& state)
+{
+	state.unwrapInput();
+	state.fft.fft(state.unwrappedBuffer);
+	for(int n = 0; n < state.fftSize; n++) {
+		float amplitude = state.fft.fda(n);
+		state.fft.fdr(n) = amplitude;
+		state.fft.fdi(n) = 0;
+	}
+	state.fft.ifft();
+	return state.overlapAddOutput();
+}
+
+// process_fft() body from the phase vocoder lectures: analyse the exact
+// frequency in each bin, then resynthesise it (with no pitch shift)
+float process_fft_phase_vocoder(FftState& state)
+{
+	int fftSize = state.fftSize;
+	int hopSize = state.hopSize;
+
+	state.unwrapInput();
+	state.fft.fft(state.unwrappedBuffer);
+
+	// Analysis: convert each bin to magnitude and frequency
+	for(int n = 0; n <= fftSize / 2; n++) {
+		float amplitude = state.fft.fda(n);
+		float phase = atan2f(state.fft.fdi(n), state.fft.fdr(n));
+		float binCentreFrequency = 2.0 * M_PI * (float)n / (float)fftSize;
+		float phaseDiff = wrapPhase(phase - state.lastInputPhases[n] - binCentreFrequency * hopSize);
+		state.frequencies[n] = binCentreFrequency + phaseDiff / (float)hopSize;
+		state.magnitudes[n] = amplitude;
+		state.lastInputPhases[n] = phase;
+	}
+
+	// Synthesis: advance each phase by its frequency and convert back
+	for(int n = 0; n <= fftSize / 2; n++) {
+		float outPhase = wrapPhase(state.lastOutputPhases[n] + state.frequencies[n] * hopSize);
+		state.fft.fdr(n) = state.magnitudes[n] * cosf_neon(outPhase);
+		state.fft.fdi(n) = state.magnitudes[n] * sinf_neon(outPhase);
+		if(n > 0 && n < fftSize / 2) {
+			state.fft.fdr(fftSize - n) = state.fft.fdr(n);
+			state.fft.fdi(fftSize - n) = -state.fft.fdi(n);
+		}
+		state.lastOutputPhases[n] = outPhase;
+	}
+
+	state.fft.ifft();
+	return state.overlapAddOutput();
+}
+
+// Benchmarks of objects which produce one sample at a time, for each block size
+void benchmarkPerSample(BelaContext *context)
+{
+	std::vector<float> sawtooth(512);
+	for(unsigned int n = 0; n < sawtooth.size(); n++)
+		sawtooth[n] = -1.0 + 2.0 * n / (float)sawtooth.size();
+
+	for(int blockSize : gBlockSizes) {
+		// Wavetable oscillator, with and without interpolation
+		Wavetable oscillator(context->audioSampleRate, sawtooth, true);
+		oscillator.setFrequency(220.0);
+		gBenchmark.run("Wavetable::process", "block", blockSize, blockSize, "smp", [&]() {
+			for(int n = 0; n < blockSize; n++)
+				gBlock[n] = oscillator.process();
+			return gBlock[blockSize - 1];
+		});
+
+		Wavetable oscillatorNoInterpolation(context->audioSampleRate, sawtooth, false);
+		oscillatorNoInterpolation.setFrequency(220.0);
+		gBenchmark.run("Wavetable::process(nearest)", "block", blockSize, blockSize, "smp", [&]() {
+			for(int n = 0; n < blockSize; n++)
+				gBlock[n] = oscillatorNoInterpolation.process();
+			return gBlock[blockSize - 1];
+		});
+
+		// Resonant lowpass filter on a sawtooth
+		Filter filter(context->audioSampleRate);
+		filter.setFrequency(1000.0);
+		filter.setQ(4.0);
+		gBenchmark.run("Filter::process", "block", blockSize, blockSize, "smp", [&]() {
+			for(int n = 0; n < blockSize; n++)
+				gBlock[n] = filter.process(sawtooth[n]);
+			return gBlock[blockSize - 1];
+		});
+
+		// Linear ramp, restarted whenever it finishes
+		Ramp ramp(context->audioSampleRate);
+		float rampTarget = 1.0;
+		gBenchmark.run("Ramp::process", "block", blockSize, blockSize, "smp", [&]() {
+			if(ramp.finished()) {
+				rampTarget = 1.0 - rampTarget;
+				ramp.rampTo(rampTarget, 0.1);
+			}
+			for(int n = 0; n < blockSize; n++)
+				gBlock[n] = ramp.process();
+			return gBlock[blockSize - 1];
+		});
+
+		// ADSR, triggered and released in turn so that every state is visited
+		ADSR envelope;
+		envelope.setSampleRate(context->audioSampleRate);
+		envelope.setAttackTime(0.01);
+		envelope.setDecayTime(0.05);
+		envelope.setSustainLevel(0.5);
+		envelope.setReleaseTime(0.1);
+		unsigned int envelopeFrames = 0;
+		gBenchmark.run("ADSR::process", "block", blockSize, blockSize, "smp", [&]() {
+			if(envelopeFrames == 0)
+				envelope.trigger();
+			else if(envelopeFrames == (unsigned int)(0.2 * context->audioSampleRate))
+				envelope.release();
+			envelopeFrames += blockSize;
+			if(envelopeFrames >= 0.4 * context->audioSampleRate)
+				envelopeFrames = 0;
+			for(int n = 0; n < blockSize; n++)
+				gBlock[n] = envelope.process();
+			return gBlock[blockSize - 1];
+		});
+
+		// Exponential segment, restarted whenever it finishes
+		ExponentialSegment segment(context->audioSampleRate);
+		float segmentTarget = 1.0;
+		gBenchmark.run("ExponentialSegment::process", "block", blockSize, blockSize, "smp", [&]() {
+			if(segment.finished()) {
+				segmentTarget = 1.0 - segmentTarget;
+				segment.rampTo(segmentTarget, 0.1);
+			}
+			for(int n = 0; n < blockSize; n++)
+				gBlock[n] = segment.process();
+			return gBlock[blockSize - 1];
+		});
+
+		// Looping playback of a sound file
+		MonoFilePlayer player(gSourceFilename, true, true);
+		gBenchmark.run("MonoFilePlayer::process", "block", blockSize, blockSize, "smp", [&]() {
+			for(int n = 0; n < blockSize; n++)
+				gBlock[n] = player.process();
+			return gBlock[blockSize - 1];
+		});
+	}
+
+	// Changing the filter frequency, which recalculates the coefficients
+	Filter filter(context->audioSampleRate);
+	float frequency = 100.0;
+	gBenchmark.run("Filter::setFrequency", "none", 0, 1, "call", [&]() {
+		frequency += 1.0;
+		if(frequency > 5000.0)
+			frequency = 100.0;
+		filter.setFrequency(frequency);
+		return filter.process(0.5);
+	});
+}
+
+// Benchmark of a complete synth voice (oscillator, filter and envelope) for
+// several numbers of voices, reported per frame of output
+void benchmarkVoices(BelaContext *context)
+{
+	std::vector<float> sawtooth(512);
+	for(unsigned int n = 0; n < sawtooth.size(); n++)
+		sawtooth[n] = -1.0 + 2.0 * n / (float)sawtooth.size();
+
+	for(int voices : gVoiceCounts) {
+		std::vector<Wavetable> oscillators(voices);
+		std::vector<Filter> filters(voices);
+		std::vector<ADSR> envelopes(voices);
+
+		for(int v = 0; v < voices; v++) {
+			oscillators[v].setup(context->audioSampleRate, sawtooth);
+			oscillators[v].setFrequency(110.0 * (v + 1));
+			filters[v].setSampleRate(context->audioSampleRate);
+			filters[v].setFrequency(2000.0);
+			filters[v].setQ(2.0);
+			envelopes[v].setSampleRate(context->audioSampleRate);
+			envelopes[v].setSustainLevel(0.5);
+			envelopes[v].trigger();
+		}
+
+		gBenchmark.run("synth voice", "voices", voices, gDefaultBlockSize, "frm", [&]() {
+			for(int n = 0; n < gDefaultBlockSize; n++) {
+				float out = 0;
+				for(int v = 0; v < voices; v++)
+					out += filters[v].process(oscillators[v].process()) * envelopes[v].process();
+				gBlock[n] = out;
+			}
+			return gBlock[gDefaultBlockSize - 1];
+		});
+	}
+}
+
+// The same synth voices built from DspCore classes, wired by hand sample by
+// sample and as a ProcessingGraph running a block per node
+void benchmarkGraph(BelaContext *context)
+{
+	std::vector<float> sawtooth(512);
+	for(unsigned int n = 0; n < sawtooth.size(); n++)
+		sawtooth[n] = -1.0 + 2.0 * n / (float)sawtooth.size();
+
+	for(int voices : gVoiceCounts) {
+		graphVoicesSetup(context->audioSampleRate, sawtooth, voices, gBlock.size(), nullptr);
+		std::string handWired = std::to_string(voices) + " voices(hand wired)";
+		std::string graph = std::to_string(voices) + " voices(graph)";
+		for(int blockSize : gBlockSizes) {
+			gBenchmark.run(handWired.c_str(), "block", blockSize, blockSize * voices, "smp", [&]() {
+				return handWiredVoicesProcess(gBlock.data(), blockSize);
+			});
+			gBenchmark.run(graph.c_str(), "block", blockSize, blockSize * voices, "smp", [&]() {
+				return graphVoicesProcess(gBlock.data(), blockSize);
+			});
+		}
+	}
+}
+
+// The cost of spreading work across cores: an empty run() of a
+// ParallelScheduler, then the voices from benchmarkGraph() on one core and
+// with their branches spread across the others
+void benchmarkParallel(BelaContext *context)
+{
+	unsigned int cores = std::thread::hardware_concurrency();
+	unsigned int workers = (cores > 1) ? cores - 1 : 0;
+	ParallelScheduler scheduler;
+	scheduler.setup(workers);
+	rt_printf("ParallelScheduler: %u workers (%s)\n", scheduler.numWorkers(),
+			  scheduler.isRealTime() ? "real-time" : "not real-time");
+
+	for(int tasks : gVoiceCounts) {
+		gBenchmark.run("ParallelScheduler::run(empty)", "tasks", tasks, 1, "run", [&]() {
+			scheduler.run([](void *, unsigned int) {}, nullptr, tasks);
+			return 0.0f;
+		});
+	}
+
+	std::vector<float> sawtooth(512);
+	for(unsigned int n = 0; n < sawtooth.size(); n++)
+		sawtooth[n] = -1.0 + 2.0 * n / (float)sawtooth.size();
+
+	for(int voices : gVoiceCounts) {
+		graphVoicesSetup(context->audioSampleRate, sawtooth, voices, gBlock.size(), &scheduler);
+		std::string serial = std::to_string(voices) + " voices(graph)";
+		std::string parallel = std::to_string(voices) + " voices(parallel graph)";
+		for(int blockSize : gBlockSizes) {
+			gBenchmark.run(serial.c_str(), "block", blockSize, blockSize * voices, "smp", [&]() {
+				return graphVoicesProcess(gBlock.data(), blockSize);
+			});
+			gBenchmark.run(parallel.c_str(), "block", blockSize, blockSize * voices, "smp", [&]() {
+				return parallelGraphVoicesProcess(gBlock.data(), blockSize);
+			});
+		}
+	}
+}
+
+// Largest relative difference between two buffers
+float maxRelativeError(const std::vector<float>& values, const std::vector<float>& reference)
+{
+	float largest = 0;
+	for(unsigned int n = 0; n < values.size(); n++) {
+		float error = fabsf(values[n] / reference[n] - 1.0f);
+		if(error > largest)
+			largest = error;
+	}
+	return largest;
+}
+
+// The FastMath functions against the libm functions they replace, one value
+// at a time and a whole buffer at a time, then a check of their accuracy
+void benchmarkFastMath(BelaContext *context)
+{
+	const int kValues = 256;
+	std::vector<float> exponents(kValues), positives(kValues), decibels(kValues), notes(kValues);
+	std::vector<float> phases(kValues), prewarps(kValues);
+	std::vector<float> output(kValues), reference(kValues);
+
+	for(int n = 0; n < kValues; n++) {
+		exponents[n] = -10.0 + 20.0 * n / kValues;
+		positives[n] = 0.001 + 1000.0 * n / kValues;
+		decibels[n] = -80.0 + 100.0 * n / kValues;
+		notes[n] = 127.0 * n / kValues;
+		phases[n] = -M_PI + 2.0 * M_PI * n / kValues;
+		prewarps[n] = M_PI * (20.0 + 20000.0 * n / kValues) / context->audioSampleRate;
+	}
+
+	// Time a loop over every value, or a single call for the whole buffer
+	auto perValue = [&](const char *name, std::vector<float>& input, float (*function)(float)) {
+		gBenchmark.run(name, "values", kValues, kValues, "val", [&]() {
+			for(int n = 0; n < kValues; n++)
+				output[n] = function(input[n]);
+			return output[kValues - 1];
+		});
+	};
+	auto perBuffer = [&](const char *name, std::vector<float>& input,
+						 void (*function)(const float *, float *, unsigned int)) {
+		gBenchmark.run(name, "values", kValues, kValues, "val", [&]() {
+			function(input.data(), output.data(), kValues);
+			return output[kValues - 1];
+		});
+	};
+
+	perValue("powf(2, x)", exponents, [](float x) { return powf(2.0, x); });
+	perValue("fastExp2", exponents, fastExp2);
+	perBuffer("fastExp2[]", exponents, fastExp2);
+
+	perValue("log2f", positives, [](float x) { return log2f(x); });
+	perValue("fastLog2", positives, fastLog2);
+	perBuffer("fastLog2[]", positives, fastLog2);
+
+	perValue("powf(x, 0.7)", positives, [](float x) { return powf(x, 0.7); });
+	perValue("fastPow(x, 0.7)", positives, [](float x) { return fastPow(x, 0.7); });
+
+	perValue("powf(10, dB / 20)", decibels, [](float db) { return powf(10.0, db / 20.0); });
+	perValue("dbToGain", decibels, dbToGain);
+	perBuffer("dbToGain[]", decibels, dbToGain);
+
+	perValue("440 * powf(2, (note-69)/12)", notes, [](float note) { return 440.0f * powf(2.0, (note - 69) / 12.0); });
+	perValue("midiToHz", notes, midiToHz);
+	perBuffer("midiToHz[]", notes, midiToHz);
+
+	perValue("sinf", phases, [](float x) { return sinf(x); });
+	perValue("fastSin", phases, fastSin);
+	perBuffer("fastSin[]", phases, fastSin);
+
+	perValue("cosf", phases, [](float x) { return cosf(x); });
+	perValue("fastCos", phases, fastCos);
+	perBuffer("fastCos[]", phases, fastCos);
+
+	// tan(pi * f / fs) as used for filter coefficients, 20Hz to 20kHz
+	perValue("tanf(pi*f/fs)", prewarps, [](float x) { return tanf(x); });
+	perValue("fastTan(pi*f/fs)", prewarps, fastTan);
+	perBuffer("fastTan[](pi*f/fs)", prewarps, fastTan);
+
+	// Accuracy against double-precision libm over the same inputs
+	for(int n = 0; n < kValues; n++)
+		reference[n] = exp2((double)exponents[n]);
+	fastExp2(exponents.data(), output.data(), kValues);
+	rt_printf("fastExp2: largest relative error %g\n", maxRelativeError(output, reference));
+
+	float largestLog2Error = 0;
+	fastLog2(positives.data(), output.data(), kValues);
+	for(int n = 0; n < kValues; n++)
+		largestLog2Error = std::max(largestLog2Error, (float)fabs(output[n] - log2((double)positives[n])));
+	rt_printf("fastLog2: largest absolute error %g\n", largestLog2Error);
+
+	for(int n = 0; n < kValues; n++)
+		reference[n] = pow(10.0, decibels[n] / 20.0);
+	dbToGain(decibels.data(), output.data(), kValues);
+	rt_printf("dbToGain: largest relative error %g\n", maxRelativeError(output, reference));
+
+	for(int n = 0; n < kValues; n++)
+		reference[n] = 440.0 * pow(2.0, (notes[n] - 69.0) / 12.0);
+	midiToHz(notes.data(), output.data(), kValues);
+	rt_printf("midiToHz: largest relative error %g\n", maxRelativeError(output, reference));
+
+	std::vector<float> cosines(kValues);
+	float largestSinCosError = 0;
+	fastSinCos(phases.data(), output.data(), cosines.data(), kValues);
+	for(int n = 0; n < kValues; n++) {
+		largestSinCosError = std::max(largestSinCosError, (float)fabs(output[n] - sin((double)phases[n])));
+		largestSinCosError = std::max(largestSinCosError, (float)fabs(cosines[n] - cos((double)phases[n])));
+	}
+	rt_printf("fastSinCos: largest absolute error %g\n", largestSinCosError);
+
+	for(int n = 0; n < kValues; n++)
+		reference[n] = tan((double)prewarps[n]);
+	fastTan(prewarps.data(), output.data(), kValues);
+	rt_printf("fastTan: largest relative error %g\n", maxRelativeError(output, reference));
+}
+
+// The buffer kernels, each version that this processor can run timed in
+// turn. Every version except the reference is then checked to give exactly
+// the same results as the reference version over a range of lengths.
+void benchmarkKernels(BelaContext *context)
+{
+	const int kSources = 4;
+	const int kMaxLength = 256;
+	std::vector<float> a(kMaxLength), b(kMaxLength), output(kMaxLength), expected(kMaxLength);
+	std::vector<float> sources[kSources];
+	const float *sourcePointers[kSources];
+	const float gains[kSources] = {0.5, 0.25, -0.75, 0.1};
+
+	for(int n = 0; n < kMaxLength; n++) {
+		a[n] = rand() / (float)RAND_MAX * 2.0 - 1.0;
+		b[n] = rand() / (float)RAND_MAX * 2.0 - 1.0;
+	}
+	for(int i = 0; i < kSources; i++) {
+		sources[i].resize(kMaxLength);
+		for(int n = 0; n < kMaxLength; n++)
+			sources[i][n] = rand() / (float)RAND_MAX * 2.0 - 1.0;
+		sourcePointers[i] = sources[i].data();
+	}
+
+	kernels::Variant best = kernels::currentVariant();
+	rt_printf("Kernels: using the %s version on this processor\n", kernels::variantName(best));
+
+	for(int v = 0; v < kernels::kNumVariants; v++) {
+		kernels::Variant variant = (kernels::Variant)v;
+		if(!kernels::useVariant(variant))
+			continue;
+
+		// Name each benchmark after the kernel and the version, e.g. "mul(avx)"
+		std::string suffix = std::string("(") + kernels::variantName(variant) + ")";
+		auto name = [&](const char *kernel) { return kernel + suffix; };
+
+		for(int blockSize : gBlockSizes) {
+			gBenchmark.run(name("mul").c_str(), "block", blockSize, blockSize, "smp", [&]() {
+				kernels::mul(a.data(), b.data(), output.data(), blockSize);
+				return output[0];
+			});
+			gBenchmark.run(name("mac").c_str(), "block", blockSize, blockSize, "smp", [&]() {
+				kernels::mac(a.data(), b.data(), output.data(), blockSize);
+				return output[0];
+			});
+			gBenchmark.run(name("mixN4").c_str(), "block", blockSize, blockSize, "smp", [&]() {
+				kernels::mixN(sourcePointers, gains, kSources, output.data(), blockSize);
+				return output[0];
+			});
+			gBenchmark.run(name("gainRamp").c_str(), "block", blockSize, blockSize, "smp", [&]() {
+				kernels::gainRamp(a.data(), output.data(), blockSize, 0.2, 0.8);
+				return output[0];
+			});
+			gBenchmark.run(name("clip").c_str(), "block", blockSize, blockSize, "smp", [&]() {
+				kernels::clip(a.data(), output.data(), blockSize, -0.5, 0.5);
+				return output[0];
+			});
+			gBenchmark.run(name("dot").c_str(), "block", blockSize, blockSize, "smp", [&]() {
+				return kernels::dot(a.data(), b.data(), blockSize);
+			});
+		}
+
+		// There is nothing to check the reference version against
+		if(variant == kernels::kReference)
+			continue;
+
+		// Every length up to kMaxLength, so the leftover values after each
+		// group of four or eight are checked too
+		int mismatches = 0;
+		auto check = [&](const char *name, int length) {
+			if(memcmp(output.data(), expected.data(), length * sizeof(float)) != 0) {
+				rt_printf("%s%s: results differ from the reference for %d values\n", name, suffix.c_str(), length);
+				mismatches++;
+			}
+		};
+		for(int length = 0; length <= kMaxLength; length++) {
+			kernels::reference::mul(a.data(), b.data(), expected.data(), length);
+			kernels::mul(a.data(), b.data(), output.data(), length);
+			check("mul", length);
+			kernels::reference::mul(a.data(), 0.3f, expected.data(), length);
+			kernels::mul(a.data(), 0.3f, output.data(), length);
+			check("mul(gain)", length);
+			std::copy(b.begin(), b.end(), expected.begin());
+			std::copy(b.begin(), b.end(), output.begin());
+			kernels::reference::mac(a.data(), sourcePointers[0], expected.data(), length);
+			kernels::mac(a.data(), sourcePointers[0], output.data(), length);
+			check("mac", length);
+			kernels::reference::mac(a.data(), 0.3f, expected.data(), length);
+			kernels::mac(a.data(), 0.3f, output.data(), length);
+			check("mac(gain)", length);
+			kernels::reference::mixN(sourcePointers, gains, kSources, expected.data(), length);
+			kernels::mixN(sourcePointers, gains, kSources, output.data(), length);
+			check("mixN", length);
+			kernels::reference::gainRamp(a.data(), expected.data(), length, 0.2, 0.8);
+			kernels::gainRamp(a.data(), output.data(), length, 0.2, 0.8);
+			check("gainRamp", length);
+			kernels::reference::clip(a.data(), expected.data(), length, -0.5, 0.5);
+			kernels::clip(a.data(), output.data(), length, -0.5, 0.5);
+			check("clip", length);
+			expected[0] = kernels::reference::dot(a.data(), b.data(), length);
+			output[0] = kernels::dot(a.data(), b.data(), length);
+			check("dot", 1);
+		}
+		if(mismatches == 0)
+			rt_printf("Kernels: %s results identical to the reference for 0 to %d values\n",
+					  kernels::variantName(variant), kMaxLength);
+	}
+
+	// Go back to the version chosen for this processor
+	kernels::useVariant(best);
+}
+
+// The wavetable oscillator and filter in floating point against their Q15
+// and Q31 versions, then the accuracy of each against double precision
+void benchmarkFixedPoint(BelaContext *context)
+{
+	fixedPointSetup(context->audioSampleRate, gBlock.size());
+
+	for(int blockSize : gBlockSizes) {
+		gBenchmark.run("Wavetable[]", "block", blockSize, blockSize, "smp", [&]() {
+			return wavetableFloatProcess(blockSize);
+		});
+		gBenchmark.run("WavetableQ15[]", "block", blockSize, blockSize, "smp", [&]() {
+			return wavetableQ15Process(blockSize);
+		});
+		gBenchmark.run("Filter[]", "block", blockSize, blockSize, "smp", [&]() {
+			return filterFloatProcess(blockSize);
+		});
+		gBenchmark.run("FilterQ31[]", "block", blockSize, blockSize, "smp", [&]() {
+			return filterQ31Process(blockSize);
+		});
+	}
+
+	rt_printf("Wavetable: SNR %.1fdB, WavetableQ15: SNR %.1fdB\n", wavetableSnr(false), wavetableSnr(true));
+	rt_printf("Filter: SNR %.1fdB, FilterQ31: SNR %.1fdB\n", filterSnr(false), filterSnr(true));
+}
+
+// The PolyBLEP oscillators, one at a time and four at once (reported per
+// oscillator), for each waveform
+void benchmarkPolyBlep(BelaContext *context)
+{
+	const char *names[3] = {"saw", "square", "triangle"};
+	std::vector<float> block4(4 * gBlock.size());
+
+	for(int waveform = 0; waveform < 3; waveform++) {
+		PolyBlepOscillator oscillator(context->audioSampleRate, (PolyBlepWaveform)waveform);
+		PolyBlepOscillator4 oscillators(context->audioSampleRate, (PolyBlepWaveform)waveform);
+		oscillator.setFrequency(220.0);
+		for(unsigned int i = 0; i < 4; i++)
+			oscillators.setFrequency(i, 220.0 * (i + 1));
+
+		for(int blockSize : gBlockSizes) {
+			std::string name = std::string("PolyBlepOscillator(") + names[waveform] + ")";
+			gBenchmark.run(name.c_str(), "block", blockSize, blockSize, "smp", [&]() {
+				oscillator.process(gBlock.data(), blockSize);
+				return gBlock[blockSize - 1];
+			});
+			name = std::string("PolyBlepOscillator4(") + names[waveform] + ")";
+			gBenchmark.run(name.c_str(), "block", blockSize, 4 * blockSize, "smp", [&]() {
+				oscillators.process(block4.data(), blockSize);
+				return block4[4 * blockSize - 1];
+			});
+		}
+	}
+}
+
+// The wavetable scanner with 64 frames of 2048 samples, in a row and in an
+// 8x8 grid, moving to a new position every block. Building the tables is
+// timed once, since it happens when the frames are loaded.
+void benchmarkWavetableScanner(BelaContext *context)
+{
+	const unsigned int kFrameSize = 2048;
+	const unsigned int kNumFrames = 64;
+	std::vector<float> frames(kNumFrames * kFrameSize);
+	for(unsigned int frame = 0; frame < kNumFrames; frame++) {
+		for(unsigned int n = 0; n < kFrameSize; n++) {
+			float phase = (float)n / kFrameSize;
+			float mix = (float)frame / (kNumFrames - 1);
+			frames[frame * kFrameSize + n] = (1.0f - mix) * sinf(2.0 * M_PI * phase) + mix * (1.0f - 2.0f * phase);
+		}
+	}
+
+	WavetableScanner row, grid;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	row.setup(context->audioSampleRate, frames, kFrameSize);
+	double setupTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	grid.setup(context->audioSampleRate, frames, kFrameSize, 8);
+	row.setFrequency(220.0);
+	grid.setFrequency(220.0);
+	rt_printf("WavetableScanner: %u levels of %u frames built in %.1fms\n",
+			  row.getNumLevels(), row.getNumFrames(), 1000.0 * setupTime);
+
+	float position = 0;
+	for(int blockSize : gBlockSizes) {
+		gBenchmark.run("WavetableScanner(row)", "block", blockSize, blockSize, "smp", [&]() {
+			position = position < 1.0f ? position + 0.001f : 0;
+			row.setPosition(position);
+			row.process(gBlock.data(), blockSize);
+			return gBlock[blockSize - 1];
+		});
+		gBenchmark.run("WavetableScanner(grid)", "block", blockSize, blockSize, "smp", [&]() {
+			position = position < 1.0f ? position + 0.001f : 0;
+			grid.setPosition(position, 1.0f - position);
+			grid.process(gBlock.data(), blockSize);
+			return gBlock[blockSize - 1];
+		});
+	}
+}
+
+// White noise from rand(), as in digital-io, against WhiteNoise one value
+// at a time and a block at a time, and PinkNoise
+void benchmarkNoise(BelaContext *context)
+{
+	WhiteNoise white;
+	PinkNoise pink;
+
+	for(int blockSize : gBlockSizes) {
+		gBenchmark.run("rand()", "block", blockSize, blockSize, "smp", [&]() {
+			for(int n = 0; n < blockSize; n++)
+				gBlock[n] = 2.0 * (float)rand() / (float)RAND_MAX - 1.0;
+			return gBlock[blockSize - 1];
+		});
+		gBenchmark.run("WhiteNoise::process", "block", blockSize, blockSize, "smp", [&]() {
+			for(int n = 0; n < blockSize; n++)
+				gBlock[n] = white.process();
+			return gBlock[blockSize - 1];
+		});
+		gBenchmark.run("WhiteNoise[]", "block", blockSize, blockSize, "smp", [&]() {
+			white.process(gBlock.data(), blockSize);
+			return gBlock[blockSize - 1];
+		});
+		gBenchmark.run("PinkNoise[]", "block", blockSize, blockSize, "smp", [&]() {
+			pink.process(gBlock.data(), blockSize);
+			return gBlock[blockSize - 1];
+		});
+	}
+}
+
+// Sixteen sine LFOs as full-rate Wavetables with 512-sample tables, as in
+// vco-analog-out, against an LfoBank worked out every 16 and every 32
+// samples, reading every LFO on every sample. Reported per LFO per sample.
+void benchmarkLfoBank(BelaContext *context)
+{
+	const unsigned int kLfos = 16;
+	std::vector<float> table(512);
+	for(unsigned int n = 0; n < table.size(); n++)
+		table[n] = sinf(2.0 * M_PI * (float)n / (float)table.size());
+
+	Wavetable wavetables[kLfos];
+	LfoBank bank16(context->audioSampleRate, kLfos, 16);
+	LfoBank bank32(context->audioSampleRate, kLfos, 32);
+	for(unsigned int i = 0; i < kLfos; i++) {
+		wavetables[i].setup(context->audioSampleRate, table);
+		wavetables[i].setFrequency(0.5 + 0.25 * i);
+		bank16.setFrequency(i, 0.5 + 0.25 * i);
+		bank32.setFrequency(i, 0.5 + 0.25 * i);
+	}
+
+	for(int blockSize : gBlockSizes) {
+		gBenchmark.run("Wavetable LFOs", "block", blockSize, kLfos * blockSize, "smp", [&]() {
+			for(int n = 0; n < blockSize; n++) {
+				float sum = 0;
+				for(unsigned int i = 0; i < kLfos; i++)
+					sum += wavetables[i].process();
+				gBlock[n] = sum;
+			}
+			return gBlock[blockSize - 1];
+		});
+		gBenchmark.run("LfoBank(16)", "block", blockSize, kLfos * blockSize, "smp", [&]() {
+			for(int n = 0; n < blockSize; n++) {
+				float sum = 0;
+				for(unsigned int i = 0; i < kLfos; i++)
+					sum += bank16.getValue(i);
+				bank16.process();
+				gBlock[n] = sum;
+			}
+			return gBlock[blockSize - 1];
+		});
+		gBenchmark.run("LfoBank(32)", "block", blockSize, kLfos * blockSize, "smp", [&]() {
+			for(int n = 0; n < blockSize; n++) {
+				float sum = 0;
+				for(unsigned int i = 0; i < kLfos; i++)
+					sum += bank32.getValue(i);
+				bank32.process();
+				gBlock[n] = sum;
+			}
+			return gBlock[blockSize - 1];
+		});
+	}
+}
+
+// The unison oscillator with 1, 4, 8 and 16 copies, reported per stereo
+// sample, to show how little each extra copy costs
+void benchmarkUnison(BelaContext *context)
+{
+	UnisonOscillator oscillator(context->audioSampleRate);
+	oscillator.setFrequency(220.0);
+	std::vector<float> right(gBlock.size());
+
+	for(unsigned int voices : {1, 4, 8, 16}) {
+		oscillator.setNumVoices(voices);
+		std::string name = "UnisonOscillator(" + std::to_string(voices) + ")";
+		for(int blockSize : gBlockSizes) {
+			gBenchmark.run(name.c_str(), "block", blockSize, blockSize, "smp", [&]() {
+				oscillator.process(gBlock.data(), right.data(), blockSize);
+				return right[blockSize - 1];
+			});
+		}
+	}
+}
+
+// The FM synth with 4 and 6 operators and 16 voices all playing, reported
+// per voice, so it can be compared with a single oscillator
+void benchmarkFmSynth(BelaContext *context)
+{
+	const unsigned int kVoices = 16;
+	fmSynthSetup(context->audioSampleRate, kVoices);
+
+	for(int blockSize : gBlockSizes) {
+		gBenchmark.run("FmSynth<4>(stack)", "block", blockSize, kVoices * blockSize, "smp", [&]() {
+			return fmSynth4Process(gBlock.data(), blockSize);
+		});
+		gBenchmark.run("FmSynth<6>(DX7 5)", "block", blockSize, kVoices * blockSize, "smp", [&]() {
+			return fmSynth6Process(gBlock.data(), blockSize);
+		});
+	}
+}
+
+// The loop from midi-pitchwheel, built against the classes in this folder
+// (process() in a .cpp file) and against the header-only DspCore library
+// (process() inlined), to show the cost of the function calls
+void benchmarkInlining(BelaContext *context)
+{
+	std::vector<float> sawtooth(512);
+	for(unsigned int n = 0; n < sawtooth.size(); n++)
+		sawtooth[n] = -1.0 + 2.0 * n / (float)sawtooth.size();
+
+	pitchwheelOutOfLineSetup(context->audioSampleRate, sawtooth);
+	pitchwheelInlineSetup(context->audioSampleRate, sawtooth);
+
+	for(int blockSize : gBlockSizes) {
+		gBenchmark.run("midi-pitchwheel(out of line)", "block", blockSize, blockSize, "smp", [&]() {
+			return pitchwheelOutOfLineProcess(gBlock.data(), blockSize);
+		});
+		gBenchmark.run("midi-pitchwheel(DspCore)", "block", blockSize, blockSize, "smp", [&]() {
+			return pitchwheelInlineProcess(gBlock.data(), blockSize);
+		});
+	}
+}
+
+// Benchmarks of the process_fft() bodies, reported per hop
+void benchmarkFft(BelaContext *context)
+{
+	for(int fftSize : gFftSizes) {
+		FftState state;
+		state.setup(fftSize);
+
+		gBenchmark.run("process_fft(passthrough)", "fft_size", fftSize, 1, "hop", [&]() {
+			return process_fft_passthrough(state);
+		});
+		gBenchmark.run("process_fft(robotisation)", "fft_size", fftSize, 1, "hop", [&]() {
+			return process_fft_robotisation(state);
+		});
+		gBenchmark.run("process_fft(phase vocoder)", "fft_size", fftSize, 1, "hop", [&]() {
+			return process_fft_phase_vocoder(state);
+		});
+	}
+}
+
+bool setup(BelaContext *context, void *userData)
+{
+	// Use the fastest version of the buffer kernels this processor can run
+	kernels::init();
+
+	// Make a second of noise for the file player to read
+	std::vector<float> source(context->audioSampleRate);
+	for(unsigned int n = 0; n < source.size(); n++)
+		source[n] = rand() / (float)RAND_MAX - 0.5;
+	AudioFileUtilities::write(gSourceFilename, source.data(), 1, source.size(), context->audioSampleRate);
+
+	gBlock.resize(*std::max_element(gBlockSizes.begin(), gBlockSizes.end()));
+
+	// The benchmarks run here, before the audio starts, so they don't have to
+	// share the CPU with the audio thread
+	if(!gBenchmark.setup(gResultsFilename))
+		return false;
+
+	benchmarkPerSample(context);
+	benchmarkVoices(context);
+	benchmarkGraph(context);
+	benchmarkParallel(context);
+	benchmarkInlining(context);
+	benchmarkFastMath(context);
+	benchmarkKernels(context);
+	benchmarkFixedPoint(context);
+	benchmarkPolyBlep(context);
+	benchmarkWavetableScanner(context);
+	benchmarkUnison(context);
+	benchmarkNoise(context);
+	benchmarkLfoBank(context);
+	benchmarkFmSynth(context);
+	benchmarkFft(context);
+
+	rt_printf("Results saved to '%s'\n", gResultsFilename.c_str());
+	return true;
+}
+
+void render(BelaContext *context, void *userData)
+{
+	gShouldStop = true;		// Stop the audio rendering
+}
+
+void cleanup(BelaContext *context, void *userData)
+{
+
+}
\ No newline at end of file
@@ -16,8 +16,8 @@ envelope-follower: control the frequency of a resonant filter based on the envel
 #include <libraries/Gui/Gui.h>
 #include <libraries/GuiController/GuiController.h>
 #include <libraries/Scope/Scope.h>
-#include "MonoFilePlayer.h"
-#include "Filter.h"
+#include <libraries/DspCore/MonoFilePlayer.h>
+#include <libraries/DspCore/Filter.h>
 
 // Name of the sound file (in project folder)
 std::string gFilename = "guitar-loop.wav";
@@ -18,7 +18,8 @@ fft-circular-buffer: show spectrum of signal from overlapping FFT windows
 #include <cstring>
 #include <vector>
 #include <algorithm>
-#include "MonoFilePlayer.h"
+#include <libraries/DspCore/MonoFilePlayer.h>
+#include <libraries/DspCore/Arena.h>
 
 // FFT-related variables
 Fft gFft;					// FFT processing object
@@ -31,6 +32,11 @@ std::vector<float> gInputBuffer;
 int gInputBufferPointer = 0;
 int gHopCounter = 0;
 
+// Memory for the spectrum sent to the GUI, reserved and touched in setup()
+const size_t gArenaSize = 16 * 1024;
+Arena gArena;
+float *gFftCurrentOut;				// Current FFT energy
+
 // Name of the sound file (in project folder)
 std::string gFilename = "drumloop.wav"; 
 
@@ -57,6 +63,18 @@ bool setup(BelaContext *context, void *userData)
 	gFft.setup(gFftSize);
 	gInputBuffer.resize(gBufferSize);
 	
+	// Take the spectrum buffer from the arena
+	if(!gArena.setup(gArenaSize)) {
+		rt_printf("Error: unable to reserve %u bytes of memory\n", (unsigned int)gArenaSize);
+		return false;
+	}
+	gFftCurrentOut = gArena.allocate<float>(gFftSize / 2);
+	if(gArena.failedAllocations() > 0) {
+		rt_printf("Error: buffers don't fit in the %u byte arena\n", (unsigned int)gArena.size());
+		return false;
+	}
+	gArena.finishSetup();
+	
 	// GUI to emulate the LEDs
 	gSpectrumGui.setup(context->projectName);
 
@@ -68,13 +86,12 @@ bool setup(BelaContext *context, void *userData)
 
 void process_fft(std::vector<float> const& buffer, unsigned int starting_loc)
 {
-	static std::vector<float> fftCurrentOut(gFftSize / 2);	// Current FFT energy
-	static std::vector<float> unwrappedBuffer(gFftSize);	// Container to hold the unwrapped values
+	float *fftCurrentOut = gFftCurrentOut;	// Local name for the buffer allocated in setup()
 	
-	// TODO: copy/unwrap buffer into FFT input (buffer --> unwrappedBuffer, with the right indexing)
+	// TODO: copy/unwrap buffer into FFT input (buffer --> gFft.td(n), with the right indexing)
 	
 	// Process the FFT based on the time domain input
-	gFft.fft(unwrappedBuffer);
+	gFft.fft();
 		
 	// Copy the lower half of the FFT bins to a buffer,
 	// and also calculate a recent peak value for each bin
@@ -86,7 +103,7 @@ void process_fft(std::vector<float> const& buffer, unsigned int starting_loc)
 	}
 	
 	// Send the current values to the GUI
-	gSpectrumGui.sendBuffer(0, fftCurrentOut);	
+	gSpectrumGui.sendBuffer(0, fftCurrentOut, gFftSize / 2);	
 	
 	// TODO: optionally send the peak values to the GUI
 }
@@ -114,5 +131,7 @@ void render(BelaContext *context, void *userData)
 
 void cleanup(BelaContext *context, void *userData)
 {
-
+	// Anything that tried to allocate after setup() would have failed
+	if(gArena.lateAllocations() > 0)
+		rt_printf("Error: %u allocations from the arena after setup()\n", gArena.lateAllocations());
 }
@@ -17,7 +17,7 @@ fft-led: blink LEDs in response to frequency content of a signal
 #include <cmath>
 #include <cstring>
 #include <vector>
-#include "MonoFilePlayer.h"
+#include <libraries/DspCore/MonoFilePlayer.h>
 
 // FFT-related variables
 Fft gFft;					// FFT processing object
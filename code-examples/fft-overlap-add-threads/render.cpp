@@ -18,7 +18,8 @@ fft-overlap-add-threads: overlap-add framework doing FFT in a low-priority threa
 #include <cstring>
 #include <vector>
 #include <algorithm>
-#include "MonoFilePlayer.h"
+#include <libraries/DspCore/MonoFilePlayer.h>
+#include <libraries/DspCore/Kernels.h>
 
 // FFT-related variables
 Fft gFft;					// FFT processing object
@@ -53,6 +54,9 @@ void process_fft_background(void *);
 
 bool setup(BelaContext *context, void *userData)
 {
+	// Use the fastest version of the buffer kernels this processor can run
+	kernels::init();
+
 	// Load the audio file
 	if(!gPlayer.setup(gFilename)) {
     	rt_printf("Error loading audio file '%s'\n", gFilename.c_str());
@@ -81,17 +85,16 @@ bool setup(BelaContext *context, void *userData)
 
 void process_fft(std::vector<float> const& inBuffer, unsigned int inPointer, std::vector<float>& outBuffer, unsigned int outPointer)
 {
-	static std::vector<float> unwrappedBuffer(gFftSize);	// Container to hold the unwrapped values
-	
-	// Copy buffer into FFT input, starting one window ago
-	for(int n = 0; n < gFftSize; n++) {
-		// Use modulo arithmetic to calculate the circular buffer index
-		int circularBufferIndex = (inPointer + n - gFftSize + gBufferSize) % gBufferSize;
-		unwrappedBuffer[n] = inBuffer[circularBufferIndex];
-	}
+	// Copy buffer straight into the FFT's input, starting one window ago. The
+	// window may wrap around the end of the circular buffer, in which case it
+	// is copied in two parts.
+	int inStart = (inPointer - gFftSize + gBufferSize) % gBufferSize;
+	int inFirstPart = std::min(gFftSize, gBufferSize - inStart);
+	std::copy(inBuffer.begin() + inStart, inBuffer.begin() + inStart + inFirstPart, &gFft.td(0));
+	std::copy(inBuffer.begin(), inBuffer.begin() + (gFftSize - inFirstPart), &gFft.td(inFirstPart));
 	
 	// Process the FFT based on the time domain input
-	gFft.fft(unwrappedBuffer);
+	gFft.fft();
 		
 	// Robotise the output
 	// for(int n = 0; n < gFftSize; n++) {
@@ -103,11 +106,12 @@ void process_fft(std::vector<float> const& inBuffer, unsigned int inPointer, std
 	// Run the inverse FFT
 	gFft.ifft();
 	
-	// Add timeDomainOut into the output buffer starting at the write pointer
-	for(int n = 0; n < gFftSize; n++) {
-		int circularBufferIndex = (outPointer + n) % gBufferSize;
-		outBuffer[circularBufferIndex] += gFft.td(n);
-	}
+	// Add timeDomainOut into the output buffer starting at the write pointer,
+	// in two parts if it wraps around
+	int outStart = outPointer % gBufferSize;
+	int outFirstPart = std::min(gFftSize, gBufferSize - outStart);
+	kernels::mac(&gFft.td(0), 1.0f, outBuffer.data() + outStart, outFirstPart);
+	kernels::mac(&gFft.td(outFirstPart), 1.0f, outBuffer.data(), gFftSize - outFirstPart);
 }
 
 // This function runs in an auxiliary task on Bela, calling process_fft
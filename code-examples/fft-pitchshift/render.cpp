@@ -16,11 +16,14 @@ fft-pitchshift: change the pitch of a sound without changing its timing using FF
 #include <libraries/Scope/Scope.h>
 #include <libraries/Gui/Gui.h>
 #include <libraries/GuiController/GuiController.h>
+#include <libraries/DspCore/FastMath.h>
 #include <cmath>
 #include <cstring>
 #include <vector>
 #include <algorithm>
-#include "MonoFilePlayer.h"
+#include <libraries/DspCore/MonoFilePlayer.h>
+#include <libraries/DspCore/Arena.h>
+#include <libraries/DspCore/Kernels.h>
 
 // FFT-related variables
 Fft gFft;							// FFT processing object
@@ -29,22 +32,38 @@ const int gHopSize = 128;			// How often we calculate a window
 float gScaleFactor = 0.5;			// How much to scale the output, based on window type and overlap
 float gPitchShift = 1.0;			// Ratio of output to input frequency
 
+// Memory for every buffer below, reserved, locked and touched in setup() so
+// that nothing is allocated or paged in once the audio is running
+const size_t gArenaSize = 256 * 1024;
+Arena gArena;
+
 // Circular buffer and pointer for assembling a window of samples
 const int gBufferSize = 16384;
-std::vector<float> gInputBuffer;
+float *gInputBuffer;
 int gInputBufferPointer = 0;
 int gHopCounter = 0;
 
 // Circular buffer for collecting the output of the overlap-add process
-std::vector<float> gOutputBuffer;
+float *gOutputBuffer;
 
 // Start the write pointer ahead of the read pointer by at least window + hop, with some margin
 int gOutputBufferWritePointer = gFftSize + 2*gHopSize;
 int gOutputBufferReadPointer = 0;
 
 // Buffer to hold the windows for FFT analysis and synthesis
-std::vector<float> gAnalysisWindowBuffer;
-std::vector<float> gSynthesisWindowBuffer;
+float *gAnalysisWindowBuffer;
+float *gSynthesisWindowBuffer;
+
+// State kept by process_fft() from one hop to the next
+float *gLastInputPhases;			// Hold the phases from the previous hop of input signal
+float *gLastOutputPhases;			// and output (synthesised) signal
+
+// These buffers hold the converted representation from magnitude-phase
+// into magnitude-frequency, used for pitch shifting
+float *gAnalysisMagnitudes;
+float *gAnalysisFrequencies;
+float *gSynthesisMagnitudes;
+float *gSynthesisFrequencies;
 
 // Name of the sound file (in project folder)
 std::string gFilename = "voice.wav"; 
@@ -67,6 +86,9 @@ GuiController gGuiController;
 
 bool setup(BelaContext *context, void *userData)
 {
+	// Use the fastest version of the buffer kernels this processor can run
+	kernels::init();
+
 	// Load the audio file
 	if(!gPlayer.setup(gFilename)) {
     	rt_printf("Error loading audio file '%s'\n", gFilename.c_str());
@@ -78,14 +100,31 @@ bool setup(BelaContext *context, void *userData)
     			gFilename.c_str(), gPlayer.size(),
     			gPlayer.size() / context->audioSampleRate);
 	
-	// Set up the FFT and its buffers
+	// Set up the FFT, and take all the other buffers from the arena
 	gFft.setup(gFftSize);
-	gInputBuffer.resize(gBufferSize);
-	gOutputBuffer.resize(gBufferSize);
+	if(!gArena.setup(gArenaSize)) {
+		rt_printf("Error: unable to reserve %u bytes of memory\n", (unsigned int)gArenaSize);
+		return false;
+	}
+	gInputBuffer = gArena.allocate<float>(gBufferSize);
+	gOutputBuffer = gArena.allocate<float>(gBufferSize);
+	gAnalysisWindowBuffer = gArena.allocate<float>(gFftSize);
+	gSynthesisWindowBuffer = gArena.allocate<float>(gFftSize);
+	gLastInputPhases = gArena.allocate<float>(gFftSize);
+	gLastOutputPhases = gArena.allocate<float>(gFftSize);
+	gAnalysisMagnitudes = gArena.allocate<float>(gFftSize / 2 + 1);
+	gAnalysisFrequencies = gArena.allocate<float>(gFftSize / 2 + 1);
+	gSynthesisMagnitudes = gArena.allocate<float>(gFftSize / 2 + 1);
+	gSynthesisFrequencies = gArena.allocate<float>(gFftSize / 2 + 1);
+	if(gArena.failedAllocations() > 0) {
+		rt_printf("Error: buffers don't fit in the %u byte arena\n", (unsigned int)gArena.size());
+		return false;
+	}
+	gArena.finishSetup();
+	rt_printf("Using %u of %u bytes of arena memory (%s)\n", (unsigned int)gArena.used(),
+			  (unsigned int)gArena.size(), gArena.isLocked() ? "locked" : "not locked");
 	
 	// Calculate the windows
-	gAnalysisWindowBuffer.resize(gFftSize);
-	gSynthesisWindowBuffer.resize(gFftSize);
 	for(int n = 0; n < gFftSize; n++) {
 		// Hann window, split across analysis and synthesis windows
 		gAnalysisWindowBuffer[n] = 0.5f * (1.0f - cosf(2.0 * M_PI * n / (float)(gFftSize - 1)));
@@ -120,29 +159,27 @@ float wrapPhase(float phaseIn)
 // This function handles the FFT processing in this example once the buffer has
 // been assembled.
 
-void process_fft(std::vector<float> const& inBuffer, unsigned int inPointer, std::vector<float>& outBuffer, unsigned int outPointer)
+void process_fft(const float *inBuffer, unsigned int inPointer, float *outBuffer, unsigned int outPointer)
 {
-	static std::vector<float> unwrappedBuffer(gFftSize);	// Container to hold the unwrapped time-domain values
-	
-	static std::vector<float> lastInputPhases(gFftSize);	// Hold the phases from the previous hop of input signal
-	static std::vector<float> lastOutputPhases(gFftSize);	// and output (synthesised) signal
+	// Local names for the buffers allocated in setup()
+	float *lastInputPhases = gLastInputPhases;
+	[[maybe_unused]] float *lastOutputPhases = gLastOutputPhases;
+	float *analysisMagnitudes = gAnalysisMagnitudes;
+	float *analysisFrequencies = gAnalysisFrequencies;
+	float *synthesisMagnitudes = gSynthesisMagnitudes;
+	float *synthesisFrequencies = gSynthesisFrequencies;
 	
-	// These containers hold the converted representation from magnitude-phase
-	// into magnitude-frequency, used for pitch shifting
-	static std::vector<float> analysisMagnitudes(gFftSize / 2 + 1);
-	static std::vector<float> analysisFrequencies(gFftSize / 2 + 1);
-	static std::vector<float> synthesisMagnitudes(gFftSize / 2 + 1);
-	static std::vector<float> synthesisFrequencies(gFftSize / 2 + 1);
-	
-	// Copy buffer into FFT input
-	for(int n = 0; n < gFftSize; n++) {
-		// Use modulo arithmetic to calculate the circular buffer index
-		int circularBufferIndex = (inPointer + n - gFftSize + gBufferSize) % gBufferSize;
-		unwrappedBuffer[n] = inBuffer[circularBufferIndex] * gAnalysisWindowBuffer[n];
-	}
+	// Copy buffer into FFT input, unwrapping it into the FFT's own buffer and
+	// multiplying by the window. The window starts one FFT ago and may wrap
+	// around the end of the circular buffer, in which case it is copied in
+	// two parts.
+	int inStart = (inPointer - gFftSize + gBufferSize) % gBufferSize;
+	int inFirstPart = std::min(gFftSize, gBufferSize - inStart);
+	kernels::mul(inBuffer + inStart, gAnalysisWindowBuffer, &gFft.td(0), inFirstPart);
+	kernels::mul(inBuffer, gAnalysisWindowBuffer + inFirstPart, &gFft.td(inFirstPart), gFftSize - inFirstPart);
 	
 	// Process the FFT based on the time domain input
-	gFft.fft(unwrappedBuffer);
+	gFft.fft();
 		
 	// Analyse the lower half of the spectrum. The upper half is just
 	// the complex conjugate and does not contain any unique information
@@ -195,7 +232,7 @@ void process_fft(std::vector<float> const& inBuffer, unsigned int inPointer, std
 		
 	// Synthesise frequencies into new magnitude and phase values for FFT bins
 	for(int n = 0; n <= gFftSize / 2; n++) {
-		float amplitude = synthesisMagnitudes[n];
+		[[maybe_unused]] float amplitude = synthesisMagnitudes[n];
 		
 		// TODO: Get the fractional offset from the bin centre frequency
 
@@ -221,11 +258,13 @@ void process_fft(std::vector<float> const& inBuffer, unsigned int inPointer, std
 	// Run the inverse FFT
 	gFft.ifft();
 	
-	// Add timeDomainOut into the output buffer
-	for(int n = 0; n < gFftSize; n++) {
-		int circularBufferIndex = (outPointer + n - gFftSize + gBufferSize) % gBufferSize;
-		outBuffer[circularBufferIndex] += gFft.td(n) * gSynthesisWindowBuffer[n];
-	}
+	// Add timeDomainOut into the output buffer, multiplied by the synthesis
+	// window, in two parts if it wraps around
+	int outStart = (outPointer - gFftSize + gBufferSize) % gBufferSize;
+	int outFirstPart = std::min(gFftSize, gBufferSize - outStart);
+	kernels::mac(&gFft.td(0), gSynthesisWindowBuffer, outBuffer + outStart, outFirstPart);
+	kernels::mac(&gFft.td(outFirstPart), gSynthesisWindowBuffer + outFirstPart,
+				 outBuffer, gFftSize - outFirstPart);
 }
 
 // This function runs in an auxiliary task on Bela, calling process_fft
@@ -241,7 +280,7 @@ void render(BelaContext *context, void *userData)
 {
 	// Get the pitch shift in semitones from the GUI slider and convert to ratio
 	float pitchShiftSemitones = gGuiController.getSliderValue(0);
-	gPitchShift = powf(2.0, pitchShiftSemitones / 12.0);
+	gPitchShift = fastExp2(pitchShiftSemitones / 12.0);
 	
 	for(unsigned int n = 0; n < context->audioFrames; n++) {
         // Read the next sample from the buffer
@@ -291,5 +330,7 @@ void render(BelaContext *context, void *userData)
 
 void cleanup(BelaContext *context, void *userData)
 {
-
+	// Anything that tried to allocate after setup() would have failed
+	if(gArena.lateAllocations() > 0)
+		rt_printf("Error: %u allocations from the arena after setup()\n", gArena.lateAllocations());
 }
@@ -20,7 +20,10 @@ fft-robotisation-v2: round the frequency of each component to a multiple of a fu
 #include <cstring>
 #include <vector>
 #include <algorithm>
-#include "MonoFilePlayer.h"
+#include <libraries/DspCore/MonoFilePlayer.h>
+#include <libraries/DspCore/Arena.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/Kernels.h>
 
 // FFT-related variables
 Fft gFft;							// FFT processing object
@@ -49,6 +52,23 @@ std::vector<float> gSynthesisWindowBuffer;
 
 std::vector<float> gBinFrequencies(gFftSize/2 + 1);
 
+// Memory for the state kept by process_fft(), reserved, locked and touched
+// in setup() so that nothing is allocated in the FFT thread
+const size_t gArenaSize = 64 * 1024;
+Arena gArena;
+
+// State kept by process_fft() from one hop to the next
+float *gLastInputPhases;			// Hold the phases from the previous hop of input signal
+float *gLastOutputPhases;			// and output (synthesised) signal
+
+// These buffers hold the converted representation from magnitude-phase
+// into magnitude-frequency, used for robotisation
+float *gAnalysisMagnitudes;
+float *gAnalysisFrequencies;
+float *gSynthesisMagnitudes;
+float *gSynthesisFrequencies;
+int *gSynthesisCount;
+
 // Name of the sound file (in project folder)
 std::string gFilename = "voice.wav"; 
 
@@ -70,6 +90,9 @@ GuiController gGuiController;
 
 bool setup(BelaContext *context, void *userData)
 {
+	// Use the fastest version of the buffer kernels this processor can run
+	kernels::init();
+
 	// Load the audio file
 	if(!gPlayer.setup(gFilename)) {
     	rt_printf("Error loading audio file '%s'\n", gFilename.c_str());
@@ -103,6 +126,24 @@ bool setup(BelaContext *context, void *userData)
 		gBinFrequencies[n] = 2.0 * M_PI * (float)n / (float)gFftSize;
 	}
 	
+	// Take the state for process_fft() from the arena
+	if(!gArena.setup(gArenaSize)) {
+		rt_printf("Error: unable to reserve %u bytes of memory\n", (unsigned int)gArenaSize);
+		return false;
+	}
+	gLastInputPhases = gArena.allocate<float>(gFftSize);
+	gLastOutputPhases = gArena.allocate<float>(gFftSize);
+	gAnalysisMagnitudes = gArena.allocate<float>(gFftSize / 2 + 1);
+	gAnalysisFrequencies = gArena.allocate<float>(gFftSize / 2 + 1);
+	gSynthesisMagnitudes = gArena.allocate<float>(gFftSize / 2 + 1);
+	gSynthesisFrequencies = gArena.allocate<float>(gFftSize / 2 + 1);
+	gSynthesisCount = gArena.allocate<int>(gFftSize / 2 + 1);
+	if(gArena.failedAllocations() > 0) {
+		rt_printf("Error: buffers don't fit in the %u byte arena\n", (unsigned int)gArena.size());
+		return false;
+	}
+	gArena.finishSetup();
+	
 	// Initialise the oscilloscope
 	gScope.setup(2, context->audioSampleRate);
 	
@@ -133,28 +174,26 @@ float wrapPhase(float phaseIn)
 
 void process_fft(std::vector<float> const& inBuffer, unsigned int inPointer, std::vector<float>& outBuffer, unsigned int outPointer)
 {
-	static std::vector<float> unwrappedBuffer(gFftSize);	// Container to hold the unwrapped time-domain values
+	// Local names for the buffers allocated in setup()
+	float *lastInputPhases = gLastInputPhases;
+	float *lastOutputPhases = gLastOutputPhases;
+	float *analysisMagnitudes = gAnalysisMagnitudes;
+	float *analysisFrequencies = gAnalysisFrequencies;
+	float *synthesisMagnitudes = gSynthesisMagnitudes;
+	float *synthesisFrequencies = gSynthesisFrequencies;
+	int *synthesisCount = gSynthesisCount;
 	
-	static std::vector<float> lastInputPhases(gFftSize);	// Hold the phases from the previous hop of input signal
-	static std::vector<float> lastOutputPhases(gFftSize);	// and output (synthesised) signal
-	
-	// These containers hold the converted representation from magnitude-phase
-	// into magnitude-frequency, used for pitch shifting
-	static std::vector<float> analysisMagnitudes(gFftSize / 2 + 1);
-	static std::vector<float> analysisFrequencies(gFftSize / 2 + 1);
-	static std::vector<float> synthesisMagnitudes(gFftSize / 2 + 1);
-	static std::vector<float> synthesisFrequencies(gFftSize / 2 + 1);
-	static std::vector<int> synthesisCount(gFftSize / 2 + 1);
-	
-	// Copy buffer into FFT input
-	for(int n = 0; n < gFftSize; n++) {
-		// Use modulo arithmetic to calculate the circular buffer index
-		int circularBufferIndex = (inPointer + n - gFftSize + gBufferSize) % gBufferSize;
-		unwrappedBuffer[n] = inBuffer[circularBufferIndex] * gAnalysisWindowBuffer[n];
-	}
+	// Copy buffer straight into the FFT's input, multiplying by the window. The
+	// window starts one FFT ago and may wrap around the end of the circular
+	// buffer, in which case it is copied in two parts.
+	int inStart = (inPointer - gFftSize + gBufferSize) % gBufferSize;
+	int inFirstPart = std::min(gFftSize, gBufferSize - inStart);
+	kernels::mul(inBuffer.data() + inStart, gAnalysisWindowBuffer.data(), &gFft.td(0), inFirstPart);
+	kernels::mul(inBuffer.data(), gAnalysisWindowBuffer.data() + inFirstPart,
+				 &gFft.td(inFirstPart), gFftSize - inFirstPart);
 	
 	// Process the FFT based on the time domain input
-	gFft.fft(unwrappedBuffer);
+	gFft.fft();
 		
 	// Analyse the lower half of the spectrum. The upper half is just
 	// the complex conjugate and does not contain any unique information
@@ -217,8 +256,10 @@ void process_fft(std::vector<float> const& inBuffer, unsigned int inPointer, std
 		float outPhase = wrapPhase(lastOutputPhases[n] + phaseDiff);
 		
 		// Now convert magnitude and phase back to real and imaginary components
-		gFft.fdr(n) = synthesisMagnitudes[n] * cosf_neon(outPhase);
-		gFft.fdi(n) = synthesisMagnitudes[n] * sinf_neon(outPhase);
+		float sine, cosine;
+		fastSinCos(outPhase, sine, cosine);
+		gFft.fdr(n) = synthesisMagnitudes[n] * cosine;
+		gFft.fdi(n) = synthesisMagnitudes[n] * sine;
 		
 		// Also store the complex conjugate in the upper half of the spectrum
 		if(n > 0 && n < gFftSize / 2) {
@@ -233,11 +274,13 @@ void process_fft(std::vector<float> const& inBuffer, unsigned int inPointer, std
 	// Run the inverse FFT
 	gFft.ifft();
 	
-	// Add timeDomainOut into the output buffer
-	for(int n = 0; n < gFftSize; n++) {
-		int circularBufferIndex = (outPointer + n - gFftSize + gBufferSize) % gBufferSize;
-		outBuffer[circularBufferIndex] += gFft.td(n) * gSynthesisWindowBuffer[n];
-	}
+	// Add timeDomainOut into the output buffer, multiplied by the synthesis
+	// window, in two parts if it wraps around
+	int outStart = (outPointer - gFftSize + gBufferSize) % gBufferSize;
+	int outFirstPart = std::min(gFftSize, gBufferSize - outStart);
+	kernels::mac(&gFft.td(0), gSynthesisWindowBuffer.data(), outBuffer.data() + outStart, outFirstPart);
+	kernels::mac(&gFft.td(outFirstPart), gSynthesisWindowBuffer.data() + outFirstPart,
+				 outBuffer.data(), gFftSize - outFirstPart);
 }
 
 // This function runs in an auxiliary task on Bela, calling process_fft
@@ -302,5 +345,7 @@ void render(BelaContext *context, void *userData)
 
 void cleanup(BelaContext *context, void *userData)
 {
-
+	// Anything that tried to allocate after setup() would have failed
+	if(gArena.lateAllocations() > 0)
+		rt_printf("Error: %u allocations from the arena after setup()\n", gArena.lateAllocations());
 }
@@ -20,7 +20,8 @@ fft-robotisation: zero the phase for each FFT bin, producing a robot voice effec
 #include <cstring>
 #include <vector>
 #include <algorithm>
-#include "MonoFilePlayer.h"
+#include <libraries/DspCore/MonoFilePlayer.h>
+#include <libraries/DspCore/Kernels.h>
 
 // FFT-related variables
 Fft gFft;					// FFT processing object
@@ -62,6 +63,9 @@ GuiController gGuiController;
 
 bool setup(BelaContext *context, void *userData)
 {
+	// Use the fastest version of the buffer kernels this processor can run
+	kernels::init();
+
 	// Load the audio file
 	if(!gPlayer.setup(gFilename)) {
     	rt_printf("Error loading audio file '%s'\n", gFilename.c_str());
@@ -99,17 +103,17 @@ bool setup(BelaContext *context, void *userData)
 
 void process_fft(std::vector<float> const& inBuffer, unsigned int inPointer, std::vector<float>& outBuffer, unsigned int outPointer)
 {
-	static std::vector<float> unwrappedBuffer(gFftSize);	// Container to hold the unwrapped values
-	
-	// Copy buffer into FFT input
-	for(int n = 0; n < gFftSize; n++) {
-		// Use modulo arithmetic to calculate the circular buffer index
-		int circularBufferIndex = (inPointer + n - gFftSize + gBufferSize) % gBufferSize;
-		unwrappedBuffer[n] = inBuffer[circularBufferIndex] * gAnalysisWindowBuffer[n];
-	}
+	// Copy buffer straight into the FFT's input, multiplying by the window. The
+	// window starts one FFT ago and may wrap around the end of the circular
+	// buffer, in which case it is copied in two parts.
+	int inStart = (inPointer - gFftSize + gBufferSize) % gBufferSize;
+	int inFirstPart = std::min(gFftSize, gBufferSize - inStart);
+	kernels::mul(inBuffer.data() + inStart, gAnalysisWindowBuffer.data(), &gFft.td(0), inFirstPart);
+	kernels::mul(inBuffer.data(), gAnalysisWindowBuffer.data() + inFirstPart,
+				 &gFft.td(inFirstPart), gFftSize - inFirstPart);
 	
 	// Process the FFT based on the time domain input
-	gFft.fft(unwrappedBuffer);
+	gFft.fft();
 		
 	// Robotise the output
 	for(int n = 0; n < gFftSize; n++) {
@@ -121,11 +125,11 @@ void process_fft(std::vector<float> const& inBuffer, unsigned int inPointer, std
 	// Run the inverse FFT
 	gFft.ifft();
 	
-	// Add timeDomainOut into the output buffer
-	for(int n = 0; n < gFftSize; n++) {
-		int circularBufferIndex = (outPointer + n - gFftSize + gBufferSize) % gBufferSize;
-		outBuffer[circularBufferIndex] += gFft.td(n);
-	}
+	// Add timeDomainOut into the output buffer, in two parts if it wraps around
+	int outStart = (outPointer - gFftSize + gBufferSize) % gBufferSize;
+	int outFirstPart = std::min(gFftSize, gBufferSize - outStart);
+	kernels::mac(&gFft.td(0), 1.0f, outBuffer.data() + outStart, outFirstPart);
+	kernels::mac(&gFft.td(outFirstPart), 1.0f, outBuffer.data(), gFftSize - outFirstPart);
 }
 
 // This function runs in an auxiliary task on Bela, calling process_fft
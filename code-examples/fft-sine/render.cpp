@@ -16,6 +16,8 @@ fft-sine: display the FFT of a sine wave and calculate its frequency from the FF
 #include <libraries/Scope/Scope.h>
 #include <libraries/Gui/Gui.h>
 #include <libraries/GuiController/GuiController.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/Arena.h>
 #include <cmath>
 #include <cstring>
 #include <vector>
@@ -32,6 +34,19 @@ std::vector<float> gInputBuffer(gBufferSize);
 int gInputBufferPointer = 0;
 int gHopCounter = 0;
 
+// Memory for the state kept by process_fft(), reserved, locked and touched
+// in setup() so that nothing is allocated in the FFT thread
+const size_t gArenaSize = 16 * 1024;
+Arena gArena;
+
+// State kept by process_fft() from one hop to the next
+float *gLastInputPhases;			// Hold the phases from the previous hop of input signal
+
+// These buffers hold the converted representation from magnitude-phase
+// into magnitude-frequency
+// TODO: add a buffer to hold calculated frequencies for each bin, and allocate it in setup()
+float *gAnalysisMagnitudes;
+
 // Thread for FFT processing
 AuxiliaryTask gFftTask;
 int gCachedInputBufferPointer = 0;
@@ -66,6 +81,17 @@ bool setup(BelaContext *context, void *userData)
 {
 	// Set up the FFT and its buffers
 	gFft.setup(gFftSize);
+	if(!gArena.setup(gArenaSize)) {
+		rt_printf("Error: unable to reserve %u bytes of memory\n", (unsigned int)gArenaSize);
+		return false;
+	}
+	gLastInputPhases = gArena.allocate<float>(gFftSize);
+	gAnalysisMagnitudes = gArena.allocate<float>(gFftSize / 2 + 1);
+	if(gArena.failedAllocations() > 0) {
+		rt_printf("Error: buffers don't fit in the %u byte arena\n", (unsigned int)gArena.size());
+		return false;
+	}
+	gArena.finishSetup();
 	
 	// Initialise the oscilloscope
 	gScope.setup(1, context->audioSampleRate);
@@ -94,30 +120,26 @@ float wrapPhase(float phaseIn)
 
 void process_fft(std::vector<float> const& inBuffer, unsigned int inPointer)
 {
-	static std::vector<float> unwrappedBuffer(gFftSize);	// Container to hold the unwrapped time-domain values
-	static std::vector<float> lastInputPhases(gFftSize);	// Hold the phases from the previous hop of input signal
-
-	// These containers hold the converted representation from magnitude-phase
-	// into magnitude-frequency, used for pitch shifting
-	// TODO: add a vector to hold calculated frequencies for each bin
-	static std::vector<float> analysisMagnitudes(gFftSize / 2 + 1);
+	// Local names for the buffers allocated in setup()
+	float *lastInputPhases = gLastInputPhases;
+	float *analysisMagnitudes = gAnalysisMagnitudes;
 
 	// This array holds other calculations to be sent to the GUI such as detected frequency 
-	static std::vector<float> calculationsForGui(2);
+	float calculationsForGui[2];
 
 	static int guiCounter = 0;	// Used to throttle how often we send the FFT to the GUI	
 	int maxBinIndex = 0;		// Index of the bin with peak magnitude
 	float maxBinValue = 0;		// Magnitude of the peak bin
 
-	// Copy buffer into FFT input
+	// Copy buffer straight into the FFT's input
 	for(int n = 0; n < gFftSize; n++) {
 		// Use modulo arithmetic to calculate the circular buffer index
 		int circularBufferIndex = (inPointer + n - gFftSize + gBufferSize) % gBufferSize;
-		unwrappedBuffer[n] = inBuffer[circularBufferIndex];
+		gFft.td(n) = inBuffer[circularBufferIndex];
 	}
 	
 	// Process the FFT based on the time domain input
-	gFft.fft(unwrappedBuffer);
+	gFft.fft();
 		
 	// Analyse the lower half of the spectrum. The upper half is just
 	// the complex conjugate and does not contain any unique information
@@ -155,7 +177,7 @@ void process_fft(std::vector<float> const& inBuffer, unsigned int inPointer)
 		guiCounter = 0;
 		
 		// Send the current magnitude spectrum 
-		gSpectrumGui.sendBuffer(0, analysisMagnitudes);	
+		gSpectrumGui.sendBuffer(0, analysisMagnitudes, gFftSize / 2 + 1);	
 		
 		// Send the detected bin number and frequency
 		// TODO: change this to display the calculated frequency for maxBinIndex 
@@ -175,7 +197,7 @@ void render(BelaContext *context, void *userData)
 {
 	for(unsigned int n = 0; n < context->audioFrames; n++) {
         // Generate a sine wave
-        float in = 0.5 * sinf(gPhase);
+        float in = 0.5 * fastSin(gPhase);
         gPhase += 2.0 * M_PI * gFrequency / context->audioSampleRate;
         if(gPhase >= 2.0 * M_PI)
         	gPhase -= 2.0 * M_PI;
@@ -210,5 +232,7 @@ void render(BelaContext *context, void *userData)
 
 void cleanup(BelaContext *context, void *userData)
 {
-
+	// Anything that tried to allocate after setup() would have failed
+	if(gArena.lateAllocations() > 0)
+		rt_printf("Error: %u allocations from the arena after setup()\n", gArena.lateAllocations());
 }
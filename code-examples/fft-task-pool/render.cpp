@@ -0,0 +1,252 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 20: Phase vocoder, part 3
+fft-task-pool: two FFT effects and a spectrum display sharing one pool of background threads
+*/
+
+#include <Bela.h>
+#include <libraries/Fft/Fft.h>
+#include <libraries/Gui/Gui.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <libraries/DspCore/MonoFilePlayer.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/Kernels.h>
+#include <libraries/DspCore/TaskPool.h>
+
+// FFT-related variables
+const int gFftSize = 1024;	// FFT window size in samples
+int gHopSize = 256;			// How often we calculate a window
+
+// Circular buffer and pointer for assembling a window of samples, shared by
+// all the FFT tasks
+const int gBufferSize = 16384;
+std::vector<float> gInputBuffer;
+int gInputBufferPointer = 0;
+int gHopCounter = 0;
+
+// Buffer to hold the window for FFT analysis
+std::vector<float> gAnalysisWindowBuffer;
+
+// One FFT effect with its own output buffer, run as a task in the pool.
+// Each effect has its own Fft object, as the effects can run at the same time.
+struct SpectralEffect {
+	Fft fft;
+	void (*processBins)(Fft& fft);			// Changes the spectrum
+	std::vector<float> outputBuffer;
+	int outputBufferWritePointer = gFftSize + 2*gHopSize;	// Window + hop ahead of the read pointer, with some margin
+	int outputBufferReadPointer = 0;
+	int cachedInputBufferPointer = 0;
+	TaskPool::Task *task;
+};
+
+// Robotisation: keep the magnitude of each bin and set its phase to zero
+void robotise(Fft& fft)
+{
+	for(int n = 0; n <= gFftSize / 2; n++) {
+		fft.fdr(n) = fft.fda(n);
+		fft.fdi(n) = 0;
+	}
+}
+
+// Whisperisation: keep the magnitude of each bin and give it a random phase
+void whisperise(Fft& fft)
+{
+	for(int n = 0; n <= gFftSize / 2; n++) {
+		float amplitude = fft.fda(n);
+		float phase = 2.0 * M_PI * rand() / (float)RAND_MAX;
+		float sine, cosine;
+		fastSinCos(phase, sine, cosine);
+		fft.fdr(n) = amplitude * cosine;
+		fft.fdi(n) = amplitude * sine;
+	}
+}
+
+// Robot voice on the left output, whisper on the right
+const int kNumEffects = 2;
+SpectralEffect gEffects[kNumEffects];
+
+// Spectrum of the input for the GUI, calculated less often and at a lower
+// priority than the effects
+Fft gSpectrumFft;
+std::vector<float> gSpectrum;
+int gSpectrumInputPointer = 0;
+int gHopsPerSpectrum = 4;
+int gSpectrumHopCounter = 0;
+TaskPool::Task *gSpectrumTask;
+
+// The pool of threads which runs all the tasks
+TaskPool gTaskPool;
+const int kNumWorkers = 2;
+
+// Name of the sound file (in project folder)
+std::string gFilename = "voice.wav"; 
+
+// Object that handles playing sound from a buffer
+MonoFilePlayer gPlayer;
+
+// Browser-based GUI to display the spectrum
+Gui gGui;
+
+void process_effect_background(void *arg);
+void process_spectrum_background(void *);
+
+bool setup(BelaContext *context, void *userData)
+{
+	// Use the fastest version of the buffer kernels this processor can run
+	kernels::init();
+
+	// Load the audio file
+	if(!gPlayer.setup(gFilename)) {
+    	rt_printf("Error loading audio file '%s'\n", gFilename.c_str());
+    	return false;
+	}
+
+	// Print some useful info
+    rt_printf("Loaded the audio file '%s' with %d frames (%.1f seconds)\n", 
+    			gFilename.c_str(), gPlayer.size(),
+    			gPlayer.size() / context->audioSampleRate);
+	
+	// Set up the input buffer and the window
+	gInputBuffer.resize(gBufferSize);
+	gAnalysisWindowBuffer.resize(gFftSize);
+	for(int n = 0; n < gFftSize; n++) {
+		// Hann window
+		gAnalysisWindowBuffer[n] = 0.5f * (1.0f - cosf(2.0 * M_PI * n / (float)(gFftSize - 1)));
+	}
+	
+	// Start the threads, then create a task for each job
+	if(!gTaskPool.setup(kNumWorkers, 50)) {
+		rt_printf("Error: unable to start the task pool\n");
+		return false;
+	}
+	gEffects[0].processBins = robotise;
+	gEffects[1].processBins = whisperise;
+	for(int i = 0; i < kNumEffects; i++) {
+		gEffects[i].fft.setup(gFftSize);
+		gEffects[i].outputBuffer.resize(gBufferSize);
+		gEffects[i].task = gTaskPool.createTask(process_effect_background, &gEffects[i],
+												TaskPool::kPriorityHigh, "spectral-effect");
+	}
+	gSpectrumFft.setup(gFftSize);
+	gSpectrum.resize(gFftSize / 2 + 1);
+	gSpectrumTask = gTaskPool.createTask(process_spectrum_background, nullptr,
+										 TaskPool::kPriorityLow, "spectrum-display");
+	
+	// Set up the GUI
+	gGui.setup(context->projectName);
+
+	return true;
+}
+
+// Copy the latest window of input into an FFT object and transform it. The
+// window may wrap around the end of the circular buffer, in which case it is
+// copied in two parts.
+void analyse(Fft& fft, unsigned int inPointer)
+{
+	int start = (inPointer - gFftSize + gBufferSize) % gBufferSize;
+	int firstPart = std::min(gFftSize, gBufferSize - start);
+	kernels::mul(gInputBuffer.data() + start, gAnalysisWindowBuffer.data(), &fft.td(0), firstPart);
+	kernels::mul(gInputBuffer.data(), gAnalysisWindowBuffer.data() + firstPart,
+				 &fft.td(firstPart), gFftSize - firstPart);
+	fft.fft();
+}
+
+// This function runs in the task pool, processing one hop of one effect
+void process_effect_background(void *arg)
+{
+	SpectralEffect& effect = *(SpectralEffect *)arg;
+	
+	analyse(effect.fft, effect.cachedInputBufferPointer);
+	effect.processBins(effect.fft);
+	effect.fft.ifft();
+	
+	// Add the result into the output buffer, in two parts if it wraps around
+	int start = (effect.outputBufferWritePointer - gFftSize + gBufferSize) % gBufferSize;
+	int firstPart = std::min(gFftSize, gBufferSize - start);
+	kernels::mac(&effect.fft.td(0), 1.0f, effect.outputBuffer.data() + start, firstPart);
+	kernels::mac(&effect.fft.td(firstPart), 1.0f, effect.outputBuffer.data(), gFftSize - firstPart);
+
+	// Update the output buffer write pointer to start at the next hop
+	effect.outputBufferWritePointer = (effect.outputBufferWritePointer + gHopSize) % gBufferSize;
+}
+
+// This function runs in the task pool, sending the input spectrum to the GUI
+void process_spectrum_background(void *)
+{
+	analyse(gSpectrumFft, gSpectrumInputPointer);
+	for(int n = 0; n <= gFftSize / 2; n++)
+		gSpectrum[n] = gSpectrumFft.fda(n);
+	gGui.sendBuffer(0, gSpectrum);
+}
+
+void render(BelaContext *context, void *userData)
+{
+	// Let the pool know the time, so it can tell which deadlines were missed
+	gTaskPool.setCurrentFrame(context->audioFramesElapsed);
+
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+        // Read the next sample from the buffer
+        float in = gPlayer.process();
+
+		// Store the sample in the buffer for the FFTs
+		gInputBuffer[gInputBufferPointer++] = in;
+		if(gInputBufferPointer >= gBufferSize)
+			gInputBufferPointer = 0;
+		
+		// Get each effect's output sample, clearing the buffer for the next overlap-add
+		for(int i = 0; i < kNumEffects; i++) {
+			SpectralEffect& effect = gEffects[i];
+			float out = effect.outputBuffer[effect.outputBufferReadPointer];
+			effect.outputBuffer[effect.outputBufferReadPointer] = 0;
+			if(++effect.outputBufferReadPointer >= gBufferSize)
+				effect.outputBufferReadPointer = 0;
+			
+			// Scale the output down by the overlap factor
+			out *= (float)gHopSize / (float)gFftSize;
+			if(i < (int)context->audioOutChannels)
+				audioWrite(context, n, i, out);
+		}
+		
+		// Every hop, start all the effects; every few hops, update the spectrum.
+		// An effect adds this hop's output gFftSize before its write pointer,
+		// which is gFftSize + 2*gHopSize ahead of the read pointer. So the
+		// first sample is read gHopSize frames after the next one, and the
+		// effects need to be finished by then.
+		if(++gHopCounter >= gHopSize) {
+			gHopCounter = 0;
+			uint64_t deadline = context->audioFramesElapsed + n + 1 + gHopSize;
+			for(int i = 0; i < kNumEffects; i++) {
+				gEffects[i].cachedInputBufferPointer = gInputBufferPointer;
+				gTaskPool.schedule(gEffects[i].task, deadline);
+			}
+			if(++gSpectrumHopCounter >= gHopsPerSpectrum) {
+				gSpectrumHopCounter = 0;
+				gSpectrumInputPointer = gInputBufferPointer;
+				gTaskPool.schedule(gSpectrumTask);
+			}
+		}
+	}
+}
+
+void cleanup(BelaContext *context, void *userData)
+{
+	// Stop the threads before the buffers they use are freed
+	gTaskPool.cleanup();
+	rt_printf("Hops processed: %u robot, %u whisper; spectra sent: %u\n",
+			  gTaskPool.numRuns(gEffects[0].task), gTaskPool.numRuns(gEffects[1].task),
+			  gTaskPool.numRuns(gSpectrumTask));
+	for(int i = 0; i < kNumEffects; i++) {
+		rt_printf("Effect %d missed %u deadlines, by up to %u frames\n", i,
+				  gTaskPool.numMisses(gEffects[i].task), gTaskPool.maxLateness(gEffects[i].task));
+	}
+}
\ No newline at end of file
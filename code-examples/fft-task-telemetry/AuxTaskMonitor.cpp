@@ -0,0 +1,178 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 18: Phase vocoder, part 1
+*/
+
+// AuxTaskMonitor.cpp: auxiliary task with timing statistics
+
+#include <unistd.h>
+#include "AuxTaskMonitor.h"
+
+// Create the task and its reporting thread
+bool AuxTaskMonitor::setup(void (*callback)(void*), int priority, const char *name, void *arg,
+						   float reportInterval, const std::string& filename)
+{
+	name_ = name;
+	callback_ = callback;
+	arg_ = arg;
+
+	ticksPerMicrosecond_ = RenderProfiler::calibrate();
+	reportIntervalTicks_ = (uint64_t)(reportInterval * 1000000.0 * ticksPerMicrosecond_);
+	lastReportTime_ = readCycleCounter();
+
+	// Open the output file if one was requested
+	if(filename != "") {
+		file_ = fopen(filename.c_str(), "w");
+		if(file_ == nullptr) {
+			rt_printf("AuxTaskMonitor: unable to open '%s'\n", filename.c_str());
+			return false;
+		}
+		fprintf(file_, "report,task,metric,bucket_start_us,count\n");
+	}
+
+	// Our own callback runs in the task, timing the user's callback
+	task_ = Bela_createAuxiliaryTask(taskCallback, priority, name, this);
+	if(task_ == 0)
+		return false;
+
+	// Reports are produced at a low priority so they never disturb the work
+	std::string reportName = name_ + "-report";
+	reportTask_ = Bela_createAuxiliaryTask(reportCallback, 1, reportName.c_str(), this);
+	if(reportTask_ == 0)
+		return false;
+
+	return true;
+}
+
+// Ask for the task to run. This is called from render().
+void AuxTaskMonitor::schedule()
+{
+	uint64_t now = readCycleCounter();
+
+	scheduled_.store(scheduled_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	// The previous request is still being processed
+	if(running_.load(std::memory_order_acquire))
+		overlapping_.store(overlapping_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	// Record the time of this request in the next slot. The time has to be
+	// stored before scheduling, as the task may start straight away on another
+	// core; it only counts as a request once Bela has accepted it.
+	unsigned int sequence = acceptedRequests_;
+	if(sequence - startedRuns_.load(std::memory_order_acquire) >= kRequestRingSize) {
+		// The slot may still be waiting to be read: leave it alone
+		unmeasured_.store(unmeasured_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+	else {
+		RequestSlot& slot = requestSlots_[sequence % kRequestRingSize];
+		slot.time.store(now, std::memory_order_relaxed);
+		slot.sequence.store(sequence, std::memory_order_release);
+	}
+
+	if(Bela_scheduleAuxiliaryTask(task_) == 0)
+		acceptedRequests_ = sequence + 1;
+	else
+		dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	// Start a report from time to time, unless the last one is still going
+	if(now - lastReportTime_ >= reportIntervalTicks_) {
+		lastReportTime_ = now;
+		if(!stopped_.load(std::memory_order_relaxed) &&
+		   !reportBusy_.exchange(true, std::memory_order_acq_rel)) {
+			if(Bela_scheduleAuxiliaryTask(reportTask_) != 0)
+				reportBusy_.store(false, std::memory_order_release);
+		}
+	}
+}
+
+// Callback that runs in the auxiliary task: time the user's function
+void AuxTaskMonitor::taskCallback(void *arg)
+{
+	AuxTaskMonitor *monitor = static_cast<AuxTaskMonitor*>(arg);
+	uint64_t startTime = readCycleCounter();
+
+	// Find out how long the request for this run waited. If its slot holds
+	// a different request, the ring was full when it was made.
+	unsigned int run = monitor->startedRuns_.load(std::memory_order_relaxed);
+	RequestSlot& slot = monitor->requestSlots_[run % kRequestRingSize];
+	if(slot.sequence.load(std::memory_order_acquire) == run)
+		monitor->latency_.record(startTime - slot.time.load(std::memory_order_relaxed));
+	monitor->startedRuns_.store(run + 1, std::memory_order_release);
+
+	monitor->running_.store(true, std::memory_order_release);
+	monitor->callback_(monitor->arg_);
+	monitor->running_.store(false, std::memory_order_release);
+
+	monitor->duration_.record(readCycleCounter() - startTime);
+	monitor->completed_.store(monitor->completed_.load(std::memory_order_relaxed) + 1,
+							  std::memory_order_relaxed);
+}
+
+// Callback that runs in the reporting task
+void AuxTaskMonitor::reportCallback(void *arg)
+{
+	AuxTaskMonitor *monitor = static_cast<AuxTaskMonitor*>(arg);
+	monitor->report();
+	monitor->reportBusy_.store(false, std::memory_order_release);
+}
+
+// Wait for the background report to finish. Bela only stops auxiliary
+// tasks after cleanup() returns, so a scheduled report always runs and
+// there is no need for a timeout.
+void AuxTaskMonitor::stop()
+{
+	stopped_.store(true, std::memory_order_relaxed);
+	while(reportBusy_.load(std::memory_order_acquire))
+		usleep(1000);
+}
+
+// Print the current statistics
+void AuxTaskMonitor::report()
+{
+	reportCounter_++;
+
+	rt_printf("--- Task '%s' report %u ---\n", name_.c_str(), reportCounter_);
+	rt_printf("scheduled %u  completed %u  overlapping %u  dropped %u  unmeasured %u\n",
+			  scheduled(), completed(), overlapping(), dropped(), unmeasured());
+	rt_printf("latency   p50 %8.2fus  p99 %8.2fus  max %8.2fus\n",
+			  latency_.percentile(0.5) / ticksPerMicrosecond_,
+			  latency_.percentile(0.99) / ticksPerMicrosecond_,
+			  latency_.maximum() / ticksPerMicrosecond_);
+	rt_printf("duration  p50 %8.2fus  p99 %8.2fus  max %8.2fus\n",
+			  duration_.percentile(0.5) / ticksPerMicrosecond_,
+			  duration_.percentile(0.99) / ticksPerMicrosecond_,
+			  duration_.maximum() / ticksPerMicrosecond_);
+
+	if(file_ != nullptr) {
+		writeHistogram("latency", latency_);
+		writeHistogram("duration", duration_);
+		fflush(file_);
+	}
+}
+
+// Write the non-empty buckets of one histogram to the output file
+void AuxTaskMonitor::writeHistogram(const char *metric, ProfilerHistogram& histogram)
+{
+	for(int i = 0; i < ProfilerHistogram::kNumBuckets; i++) {
+		uint32_t count = histogram.bucketCount(i);
+		if(count == 0)
+			continue;
+		fprintf(file_, "%u,%s,%s,%.3f,%u\n", reportCounter_, name_.c_str(), metric,
+				ProfilerHistogram::valueForBucket(i) / ticksPerMicrosecond_, count);
+	}
+}
+
+// Destructor: close the output file, unless stop() wasn't called and a
+// background report could still be writing to it
+AuxTaskMonitor::~AuxTaskMonitor()
+{
+	if(file_ != nullptr && !reportBusy_.load(std::memory_order_acquire))
+		fclose(file_);
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 18: Phase vocoder, part 1
+*/
+
+// AuxTaskMonitor.h: an auxiliary task which keeps statistics about itself.
+// It replaces Bela_createAuxiliaryTask() and Bela_scheduleAuxiliaryTask(),
+// and measures how long each request waits before the task starts, how long
+// the task runs, how many requests arrive while the task is still running
+// and how many requests Bela refused to queue.
+
+#pragma once
+
+#include <Bela.h>
+#include <atomic>
+#include <string>
+#include <cstdio>
+#include <libraries/DspCore/RenderProfiler.h>
+
+class AuxTaskMonitor {
+public:
+	// Constructor
+	AuxTaskMonitor() {}
+
+	// Create the task with the same arguments as Bela_createAuxiliaryTask().
+	// Statistics are printed every reportInterval seconds; if filename is not
+	// empty, the histograms are also written to that file in CSV format.
+	// Returns true on success.
+	bool setup(void (*callback)(void*), int priority, const char *name, void *arg = nullptr,
+			   float reportInterval = 1.0, const std::string& filename = "");
+
+	// Ask for the task to run: call this from render() instead of
+	// Bela_scheduleAuxiliaryTask()
+	void schedule();
+
+	// Methods for getting the counters
+	unsigned int scheduled() { return scheduled_.load(std::memory_order_relaxed); }
+	unsigned int completed() { return completed_.load(std::memory_order_relaxed); }
+	unsigned int overlapping() { return overlapping_.load(std::memory_order_relaxed); }
+	unsigned int dropped() { return dropped_.load(std::memory_order_relaxed); }
+	unsigned int unmeasured() { return unmeasured_.load(std::memory_order_relaxed); }
+
+	// Print the current statistics (called automatically in the background,
+	// and can be called from cleanup() for a final summary after stop())
+	void report();
+
+	// Stop starting background reports and wait for one in progress to
+	// finish, so that report() can safely be called from cleanup()
+	void stop();
+
+	// Destructor
+	~AuxTaskMonitor();
+
+private:
+	// Callbacks that run in the auxiliary tasks
+	static void taskCallback(void *arg);
+	static void reportCallback(void *arg);
+
+	// Write one histogram to the output file
+	void writeHistogram(const char *metric, ProfilerHistogram& histogram);
+
+	std::string name_;							// Name of the task
+	void (*callback_)(void*) = nullptr;			// User function to run
+	void *arg_ = nullptr;						// Argument to pass to the user function
+	AuxiliaryTask task_ = 0;					// The task doing the work
+	AuxiliaryTask reportTask_ = 0;				// Low-priority task for reporting
+
+	// Times at which each request was made. Request n uses slot n % size and
+	// the task's run n reads it back; the sequence number in the slot shows
+	// whether it really belongs to that run. render() fills in the next slot
+	// before asking Bela, as the task may start straight away on another core,
+	// but only counts the request once Bela has accepted it, so a refused one
+	// is simply overwritten by the next. A request made while the task is a
+	// whole ring behind still goes to Bela, but its wait isn't measured.
+	static const unsigned int kRequestRingSize = 64;
+	struct RequestSlot {
+		std::atomic<uint64_t> time{0};
+		std::atomic<unsigned int> sequence{~0u};
+	};
+	RequestSlot requestSlots_[kRequestRingSize];
+	unsigned int acceptedRequests_ = 0;			// Requests Bela accepted (render() only)
+	std::atomic<unsigned int> startedRuns_{0};	// Runs of the task that have started
+	std::atomic<bool> running_{false};			// Whether the task is running now
+
+	ProfilerHistogram latency_;					// Time from schedule() to the task starting
+	ProfilerHistogram duration_;				// Time the task takes to run
+	std::atomic<unsigned int> scheduled_{0};	// Number of calls to schedule()
+	std::atomic<unsigned int> completed_{0};	// Number of times the task finished
+	std::atomic<unsigned int> overlapping_{0};	// Requests made while the task was running
+	std::atomic<unsigned int> dropped_{0};		// Requests which Bela refused
+	std::atomic<unsigned int> unmeasured_{0};	// Requests made while the ring was full
+
+	double ticksPerMicrosecond_ = 1.0;			// Conversion from counter ticks to time
+	uint64_t reportIntervalTicks_ = 0;			// How often to produce a report
+	uint64_t lastReportTime_ = 0;				// When the last report was requested
+	std::atomic<bool> reportBusy_{false};		// A report is scheduled or running
+	std::atomic<bool> stopped_{false};			// Set by stop(): no more background reports
+	unsigned int reportCounter_ = 0;			// Number of reports so far
+	FILE *file_ = nullptr;						// CSV output, if requested
+};
\ No newline at end of file
@@ -0,0 +1,161 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 16: MIDI part 2
+fm-synth: polyphonic 4-operator FM synth, with the voices worked out four at a time
+*/
+
+#include <Bela.h>
+#include <libraries/Midi/Midi.h>
+#include <libraries/Gui/Gui.h>
+#include <libraries/GuiController/GuiController.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/FmSynth.h>
+#include <libraries/DspCore/LockFreeQueue.h>
+#include <vector>
+
+// Device for handling MIDI messages
+Midi gMidi;
+
+// Name of the MIDI port to use. Run 'amidi -l' on the console to see a list.
+// Typical values: 
+//   "hw:0,0,0" for a virtual device (from the computer)
+//   "hw:1,0,0" for a USB device plugged into the Bela board
+const char* gMidiPort0 = "hw:1,0,0";
+
+// A note on or off, passed from the MIDI thread to the audio thread
+struct NoteEvent {
+	int noteNumber;
+	int velocity;			// 0 for a note off
+};
+LockFreeQueue<NoteEvent, 64> gNoteEvents;
+
+// The synth: 16 voices, in four groups of four
+const unsigned int kNumVoices = 16;
+FmSynth<4> gSynth;
+
+// The algorithms to choose from with the first slider
+const FmAlgorithm kAlgorithms[4] = {fm::kStack, fm::kPairs, fm::kBranch, fm::kAdditive};
+
+// Mix of all the voices for one block
+std::vector<float> gMixBlock;
+
+// Browser-based GUI to adjust parameters
+Gui gGui;
+GuiController gGuiController;
+
+// MIDI callback function
+void midiEvent(MidiChannelMessage message, void *arg);
+
+bool setup(BelaContext *context, void *userData)
+{
+	// Initialise the MIDI device
+	if(gMidi.readFrom(gMidiPort0) < 0) {
+		rt_printf("Unable to read from MIDI port %s\n", gMidiPort0);
+		return false;
+	}
+	gMidi.writeTo(gMidiPort0);
+	gMidi.enableParser(true);
+	gMidi.setParserCallback(midiEvent, (void *)gMidiPort0);
+
+	gSynth.setup(context->audioSampleRate, kNumVoices);
+
+	// Operator 0 is heard in every algorithm. The modulators die away
+	// faster than it does, so each note starts bright and then mellows, and
+	// velocity changes how bright it is rather than how loud.
+	gSynth.setEnvelope(0, 0.002, 1.5, 0.6, 0.4);
+	for(unsigned int op = 1; op < 4; op++) {
+		gSynth.setEnvelope(op, 0.002, 0.3 + 0.3 * op, 0.2, 0.3);
+		gSynth.setVelocitySensitivity(op, 0.8);
+	}
+	gSynth.setVelocitySensitivity(0, 0.3);
+	gMixBlock.resize(context->audioFrames);
+
+	// Set up the GUI
+	gGui.setup(context->projectName);
+	gGuiController.setup(&gGui, "FM Synth Controller");
+
+	// Arguments: name, default value, minimum, maximum, increment
+	gGuiController.addSlider("Algorithm (stack, pairs, branch, additive)", 0, 0, 3, 1);
+	gGuiController.addSlider("Operator 1 ratio", 1, 0.5, 8, 0.5);
+	gGuiController.addSlider("Operator 2 ratio", 2, 0.5, 8, 0.5);
+	gGuiController.addSlider("Operator 3 ratio", 3.5, 0.5, 8, 0.5);
+	gGuiController.addSlider("Modulation index", 2, 0, 8, 0);
+	gGuiController.addSlider("Feedback", 0, 0, 3, 0);
+	gGuiController.addSlider("Amplitude (dB)", -12, -40, 0, 0);
+
+	return true;
+}
+
+void render(BelaContext *context, void *userData)
+{
+	// Handle the notes which have arrived since the last block
+	NoteEvent event;
+	while(gNoteEvents.pop(event)) {
+		if(event.velocity > 0)
+			gSynth.noteOn(event.noteNumber, event.velocity / 127.0f);
+		else
+			gSynth.noteOff(event.noteNumber);
+	}
+
+	// Changes to the operators apply to the notes already playing too
+	gSynth.setAlgorithm(kAlgorithms[(int)gGuiController.getSliderValue(0)]);
+	gSynth.setOperator(0, 1, 1);
+	float index = gGuiController.getSliderValue(4);
+	for(unsigned int op = 1; op < 4; op++) {
+		// In the additive algorithm the modulators are heard, so use the
+		// same level as operator 0 instead of the modulation index
+		float level = (gGuiController.getSliderValue(0) == 3) ? 1 : index;
+		gSynth.setOperator(op, gGuiController.getSliderValue(op), level);
+	}
+	gSynth.setFeedback(gGuiController.getSliderValue(5));
+	float amplitude = dbToGain(gGuiController.getSliderValue(6));
+
+	// All the voices at once
+	gSynth.process(gMixBlock.data(), context->audioFrames);
+
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+		float out = amplitude * gMixBlock[n];
+		for(unsigned int channel = 0; channel < context->audioOutChannels; channel++) {
+			// Write the sample to every audio output channel
+			audioWrite(context, n, channel, out);
+		}
+	}
+}
+
+// This callback function is called every time a new MIDI message is available
+// This happens on a different thread than the audio processing, so the notes
+// are passed to render() through a queue rather than changing the synth here
+
+void midiEvent(MidiChannelMessage message, void *arg) {
+	NoteEvent event;
+	
+	// A MIDI "note on" message type might actually hold a real
+	// note onset (e.g. key press), or it might hold a note off (key release).
+	// The latter is signified by a velocity of 0.
+	if(message.getType() == kmmNoteOn) {
+		event.noteNumber = message.getDataByte(0);
+		event.velocity = message.getDataByte(1);
+	}
+	else if(message.getType() == kmmNoteOff) {
+		event.noteNumber = message.getDataByte(0);
+		event.velocity = 0;
+	}
+	else {
+		return;
+	}
+	
+	if(!gNoteEvents.push(event))
+		rt_printf("Note queue full: dropped note %d\n", event.noteNumber);
+}
+
+void cleanup(BelaContext *context, void *userData)
+{
+	
+}
\ No newline at end of file
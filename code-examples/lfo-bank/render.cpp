@@ -0,0 +1,137 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+lfo-bank: a four-note drone where every note has its own filter sweep,
+          tremolo and panning, from twelve LFOs worked out every 16 samples
+*/
+
+#include <Bela.h>
+#include <libraries/Gui/Gui.h>
+#include <libraries/GuiController/GuiController.h>
+#include <libraries/Scope/Scope.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/LfoBank.h>
+#include <libraries/DspCore/PolyBlep.h>
+#include <libraries/DspCore/Filter.h>
+
+// A chord of four notes, each with three LFOs
+const unsigned int kNumVoices = 4;
+const float kNotes[kNumVoices] = {45, 52, 57, 60};
+const unsigned int kControlPeriod = 16;
+
+// Which LFO does what, for voice v: LFO v * kLfosPerVoice + role
+enum {
+	kCutoffLfo = 0,
+	kTremoloLfo,
+	kPanLfo,
+	kLfosPerVoice
+};
+
+PolyBlepOscillator gOscillators[kNumVoices];
+Filter gFilters[kNumVoices];
+
+// All twelve LFOs are one bank: it works out where each will be 16 samples
+// from now, and in between each value is one multiply away
+LfoBank gLfos;
+
+// Browser-based GUI to adjust parameters
+Gui gGui;
+GuiController gGuiController;
+
+// Browser-based oscilloscope
+Scope gScope;
+
+bool setup(BelaContext *context, void *userData)
+{
+	gLfos.setup(context->audioSampleRate, kNumVoices * kLfosPerVoice, kControlPeriod);
+	gLfos.setSeed(1);
+
+	for(unsigned int v = 0; v < kNumVoices; v++) {
+		gOscillators[v].setup(context->audioSampleRate, kPolyBlepSaw);
+		gOscillators[v].setFrequency(midiToHz(kNotes[v]));
+		gFilters[v].setSampleRate(context->audioSampleRate);
+		gFilters[v].setQ(2.0);
+
+		// The filter sweeps and tremolos follow the tempo, each note at a
+		// different number of beats, and the panning drifts freely
+		unsigned int lfo = v * kLfosPerVoice;
+		gLfos.setBeats(lfo + kCutoffLfo, 1 << v);
+		gLfos.setShape(lfo + kTremoloLfo, kLfoTriangle);
+		gLfos.setBeats(lfo + kTremoloLfo, 0.25 * (v + 1));
+		gLfos.setFrequency(lfo + kPanLfo, 0.05 + 0.03 * v);
+		gLfos.setPhase(lfo + kPanLfo, 0.25 * v);
+	}
+
+	// Set up the GUI
+	gGui.setup(context->projectName);
+	gGuiController.setup(&gGui, "LFO Bank Controller");
+
+	// Arguments: name, default value, minimum, maximum, increment
+	gGuiController.addSlider("Tempo (bpm)", 120, 40, 240, 0);
+	gGuiController.addSlider("Sweep shape (sine, tri, saw, square, S&H, random)", 5, 0, 5, 1);
+	gGuiController.addSlider("Cutoff (Hz)", 800, 100, 4000, 0);
+	gGuiController.addSlider("Sweep depth (octaves)", 2, 0, 4, 0);
+	gGuiController.addSlider("Tremolo depth", 0.5, 0, 1, 0);
+	gGuiController.addSlider("Amplitude (dB)", -20, -40, -6, 0);
+
+	// Set up the oscilloscope
+	gScope.setup(2, context->audioSampleRate);
+
+	return true;
+}
+
+void render(BelaContext *context, void *userData)
+{
+	LfoShape sweepShape = (LfoShape)(int)gGuiController.getSliderValue(1);
+	float cutoff = gGuiController.getSliderValue(2);
+	float sweepDepth = gGuiController.getSliderValue(3);
+	float tremoloDepth = 0.5 * gGuiController.getSliderValue(4);
+	float amplitude = dbToGain(gGuiController.getSliderValue(5)) / kNumVoices;
+
+	gLfos.setTempo(gGuiController.getSliderValue(0));
+	for(unsigned int v = 0; v < kNumVoices; v++)
+		gLfos.setShape(v * kLfosPerVoice + kCutoffLfo, sweepShape);
+
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+		// The filter coefficients cost more to work out than the LFOs, so
+		// change the cutoff only once every control period
+		if(n % kControlPeriod == 0) {
+			for(unsigned int v = 0; v < kNumVoices; v++) {
+				float sweep = gLfos.getValue(v * kLfosPerVoice + kCutoffLfo);
+				gFilters[v].setFrequency(cutoff * fastExp2(sweepDepth * sweep));
+			}
+		}
+
+		float left = 0, right = 0;
+		for(unsigned int v = 0; v < kNumVoices; v++) {
+			unsigned int lfo = v * kLfosPerVoice;
+			float gain = amplitude * (1.0 - tremoloDepth * (1.0 + gLfos.getValue(lfo + kTremoloLfo)));
+			float pan = 0.5 * (1.0 + gLfos.getValue(lfo + kPanLfo));
+			float out = gain * gFilters[v].process(gOscillators[v].process());
+			left += (1.0 - pan) * out;
+			right += pan * out;
+		}
+
+		// Move all the LFOs on to the next sample
+		gLfos.process();
+
+		// Left and right on the first two channels, and the same on any more
+		for(unsigned int channel = 0; channel < context->audioOutChannels; channel++)
+			audioWrite(context, n, channel, (channel & 1) ? right : left);
+
+		// Write both channels to the oscilloscope
+		gScope.log(left, right);
+	}
+}
+
+void cleanup(BelaContext *context, void *userData)
+{
+
+}
\ No newline at end of file
@@ -12,6 +12,7 @@ metronome-envelope: metronome code using an exponential envelope rather than a s
 */
 
 #include <Bela.h>
+#include <libraries/DspCore/FastMath.h>
 #include <math.h>
 
 // Oscillator variables
@@ -56,7 +57,7 @@ void render(BelaContext *context, void *userData)
 		gPhase += 2.0 * M_PI * gFrequency / context->audioSampleRate;
 		if(gPhase >= 2.0 * M_PI)
 			gPhase -= 2.0 * M_PI;
-		float out = gAmplitude * sin(gPhase);
+		float out = gAmplitude * fastSin(gPhase);
 
 		// Write the sample to the audio output buffer
 		for(unsigned int channel = 0; channel <context->audioOutChannels; channel++) {
@@ -12,7 +12,7 @@ metronome: generate clicks at a regular interval to demonstrate counting time wi
 */
 
 #include <Bela.h>
-#include "MonoFilePlayer.h"
+#include <libraries/DspCore/MonoFilePlayer.h>
 
 const std::string gFilename = "click.wav";	// Name of the sound file (in project folder)
 float gAmplitude = 0.3;						// Volume of the output
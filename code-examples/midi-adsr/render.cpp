@@ -17,11 +17,12 @@ midi-adsr: MIDI synth with ADSR envelopes for amplitude and frequency
 #include <libraries/GuiController/GuiController.h>
 #include <libraries/Scope/Scope.h>
 #include <libraries/Midi/Midi.h>
+#include <libraries/DspCore/FastMath.h>
 #include <cmath>
 
-#include "ADSR.h"
-#include "Wavetable.h"
-#include "Filter.h"
+#include <libraries/DspCore/ADSR.h>
+#include <libraries/DspCore/Wavetable.h>
+#include <libraries/DspCore/Filter.h>
 
 // Browser-based GUI to adjust parameters
 Gui gui;
@@ -120,12 +121,12 @@ void noteOn(int noteNumber, int velocity)
 		gActiveNotes[gActiveNoteCount++] = noteNumber;
 		
 		// Map note number to frequency
-		float frequency = powf(2.0, (noteNumber - 69)/12.0) * 440.0;
+		float frequency = midiToHz(noteNumber);
 		gOscillator.setFrequency(frequency);
 		
 		// Map velocity to amplitude on a decibel scale
 		float decibels = map(velocity, 1, 127, -40, 0);
-		gAmplitude = powf(10.0, decibels / 20.0);
+		gAmplitude = dbToGain(decibels);
 	
 		// TODO: trigger the ADSR envelopes
 	}
@@ -161,7 +162,7 @@ void noteOff(int noteNumber)
 		// Update the frequency but don't retrigger
 		int mostRecentNote = gActiveNotes[gActiveNoteCount - 1];
 		
-		float frequency = powf(2.0, (mostRecentNote - 69)/12.0) * 440.0;
+		float frequency = midiToHz(mostRecentNote);
 		gOscillator.setFrequency(frequency);
 	}
 }
@@ -17,6 +17,7 @@ midi-multinote: sine wave MIDI synth which keeps track of multiple key presses
 
 #include <Bela.h>
 #include <libraries/Midi/Midi.h>
+#include <libraries/DspCore/FastMath.h>
 #include <stdlib.h>
 #include <cmath>
 
@@ -62,11 +63,11 @@ void noteOn(int noteNumber, int velocity)
 		gActiveNoteCount++;
 
 		// Map note number to frequency
-		gFrequency = powf(2.0, (noteNumber - 69)/12.0) * 440.0;
+		gFrequency = midiToHz(noteNumber);
 		
 		// Map velocity to amplitude on a decibel scale
 		float decibels = map(velocity, 1, 127, -40, 0);
-		gAmplitude = powf(10.0, decibels / 20.0);
+		gAmplitude = dbToGain(decibels);
 		
 		rt_printf("Note on: Frequency: %f, Amplitude: %f\n", gFrequency, gAmplitude);
 	}
@@ -110,7 +111,7 @@ void noteOff(int noteNumber)
 		// Update the frequency but don't retrigger
 		int mostRecentNote = gActiveNotes[gActiveNoteCount - 1];
 		
-		gFrequency = powf(2.0, (mostRecentNote - 69)/12.0) * 440.0;
+		gFrequency = midiToHz(mostRecentNote);
 		
 		rt_printf("Note changed: new frequency %f\n", gFrequency);
 	}
@@ -158,7 +159,7 @@ void render(BelaContext *context, void *userData)
 			gPhase += 2.0 * M_PI * gFrequency / context->audioSampleRate;
 			if(gPhase > M_PI)
 				gPhase -= 2.0 * M_PI;
-			value = sin(gPhase) * gAmplitude;
+			value = fastSin(gPhase) * gAmplitude;
 		} 
 		
 		for(unsigned int ch = 0; ch < context->audioOutChannels; ++ch)
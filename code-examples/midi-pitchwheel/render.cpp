@@ -17,12 +17,13 @@ midi-pitchwheel: MIDI synth with support for pitch wheel and other controls
 #include <libraries/GuiController/GuiController.h>
 #include <libraries/Scope/Scope.h>
 #include <libraries/Midi/Midi.h>
+#include <libraries/DspCore/FastMath.h>
 #include <cmath>
 
-#include "ADSR.h"
-#include "Wavetable.h"
-#include "Filter.h"
-#include "ExponentialSegment.h"
+#include <libraries/DspCore/ADSR.h>
+#include <libraries/DspCore/Wavetable.h>
+#include <libraries/DspCore/Filter.h>
+#include <libraries/DspCore/ExponentialSegment.h>
 
 // Device for handling MIDI messages
 Midi gMidi;
@@ -120,7 +121,7 @@ bool setup(BelaContext *context, void *userData)
 // Calculate the frequency based on note and pitch bend
 float calculateFrequency(int noteNumber)
 {
-	return powf(2.0, (noteNumber - 69)/12.0) * 440.0;
+	return midiToHz(noteNumber);
 }
 
 // MIDI note on received
@@ -136,7 +137,7 @@ void noteOn(int noteNumber, int velocity)
 		
 		// Map velocity to amplitude on a decibel scale
 		float decibels = map(velocity, 1, 127, -40, 0);
-		gAmplitude = powf(10.0, decibels / 20.0);
+		gAmplitude = dbToGain(decibels);
 	
 		// Start the ADSR if this was the first note pressed
 		if(gActiveNoteCount == 1) {
@@ -0,0 +1,201 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 16: MIDI part 2
+midi-polyphony: polyphonic synth which plays each MIDI note on its own voice
+*/
+
+#include <Bela.h>
+#include <libraries/Midi/Midi.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/Wavetable.h>
+#include <libraries/DspCore/ADSR.h>
+#include <libraries/DspCore/ObjectPool.h>
+#include <libraries/DspCore/LockFreeQueue.h>
+#include <libraries/DspCore/Kernels.h>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+// Device for handling MIDI messages
+Midi gMidi;
+
+// Name of the MIDI port to use. Run 'amidi -l' on the console to see a list.
+// Typical values: 
+//   "hw:0,0,0" for a virtual device (from the computer)
+//   "hw:1,0,0" for a USB device plugged into the Bela board
+const char* gMidiPort0 = "hw:1,0,0";
+
+// A note on or off, passed from the MIDI thread to the audio thread
+struct NoteEvent {
+	int noteNumber;
+	int velocity;			// 0 for a note off
+};
+LockFreeQueue<NoteEvent, 64> gNoteEvents;
+
+// One voice: an oscillator with its own envelope
+struct Voice {
+	Wavetable oscillator;
+	ADSR envelope;
+	int noteNumber;			// -1 once the note has been released
+	float amplitude;
+};
+
+// The voices, used only by the audio thread
+const int kMaxVoices = 16;
+ObjectPool<Voice, kMaxVoices> gVoices;
+
+// Blocks for calculating one voice at a time, and for the mix of all of them
+std::vector<float> gOscillatorBlock, gEnvelopeBlock, gMixBlock;
+
+// MIDI callback function
+void midiEvent(MidiChannelMessage message, void *arg);
+
+bool setup(BelaContext *context, void *userData)
+{
+	// Use the fastest version of the buffer kernels this processor can run
+	kernels::init();
+
+	// Initialise the MIDI device
+	if(gMidi.readFrom(gMidiPort0) < 0) {
+		rt_printf("Unable to read from MIDI port %s\n", gMidiPort0);
+		return false;
+	}
+	gMidi.writeTo(gMidiPort0);
+	gMidi.enableParser(true);
+	gMidi.setParserCallback(midiEvent, (void *)gMidiPort0);
+	
+	std::vector<float> wavetable;
+	const unsigned int wavetableSize = 512;
+		
+	// Populate a buffer with the first 48 harmonics of a sawtooth wave
+	wavetable.resize(wavetableSize);
+	for(unsigned int n = 0; n < wavetable.size(); n++) {
+		wavetable[n] = 0;
+		for(unsigned int harmonic = 1; harmonic <= 48; harmonic++) {
+			wavetable[n] += 0.5 * sinf(2.0 * M_PI * (float)harmonic * (float)n / 
+								 (float)wavetable.size()) / (float)harmonic;
+		}
+	}
+	
+	// Set up every voice in the pool now, so that starting a note later
+	// only needs to set its frequency and trigger its envelope
+	for(unsigned int i = 0; i < gVoices.capacity(); i++) {
+		Voice& voice = gVoices.storage(i);
+		voice.oscillator.setup(context->audioSampleRate, wavetable);
+		voice.envelope.setSampleRate(context->audioSampleRate);
+		voice.envelope.setAttackTime(0.01);
+		voice.envelope.setDecayTime(0.1);
+		voice.envelope.setSustainLevel(0.5);
+		voice.envelope.setReleaseTime(0.5);
+	}
+	gOscillatorBlock.resize(context->audioFrames);
+	gEnvelopeBlock.resize(context->audioFrames);
+	gMixBlock.resize(context->audioFrames);
+	
+	return true;
+}
+
+// MIDI note on received: start a new voice
+void noteOn(int noteNumber, int velocity) 
+{
+	Voice *voice = gVoices.acquire();
+	if(voice == nullptr) {
+		rt_printf("No voice free for note %d\n", noteNumber);
+		return;
+	}
+	
+	voice->noteNumber = noteNumber;
+	voice->oscillator.setFrequency(midiToHz(noteNumber));
+	
+	// Map velocity to amplitude on a decibel scale
+	float decibels = map(velocity, 1, 127, -40, 0);
+	voice->amplitude = dbToGain(decibels);
+	voice->envelope.trigger();
+}
+
+// MIDI note off received: release the voice playing this note. The voice
+// stays in the pool until its envelope has finished.
+void noteOff(int noteNumber)
+{
+	for(Voice& voice : gVoices) {
+		if(voice.noteNumber == noteNumber) {
+			voice.envelope.release();
+			voice.noteNumber = -1;
+		}
+	}
+}
+
+void render(BelaContext *context, void *userData)
+{
+	// Handle the notes which have arrived since the last block
+	NoteEvent event;
+	while(gNoteEvents.pop(event)) {
+		if(event.velocity > 0)
+			noteOn(event.noteNumber, event.velocity);
+		else
+			noteOff(event.noteNumber);
+	}
+	
+	// Now calculate the audio for this block one voice at a time: the
+	// oscillator times the envelope, added into the mix at the voice's level
+	float *mix = gMixBlock.data();
+	std::fill(gMixBlock.begin(), gMixBlock.end(), 0.0f);
+	for(Voice& voice : gVoices) {
+		voice.oscillator.process(gOscillatorBlock.data(), context->audioFrames);
+		voice.envelope.process(gEnvelopeBlock.data(), context->audioFrames);
+		kernels::mul(gOscillatorBlock.data(), gEnvelopeBlock.data(), gOscillatorBlock.data(), context->audioFrames);
+		kernels::mac(gOscillatorBlock.data(), voice.amplitude * 0.25f, mix, context->audioFrames);
+	}
+	
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+		for(unsigned int channel = 0; channel < context->audioOutChannels; channel++) {
+			// Write the sample to every audio output channel
+			audioWrite(context, n, channel, mix[n]);
+		}
+	}
+	
+	// Give back the voices whose envelopes have finished. Count downwards,
+	// because releasing a voice moves the last one into its place.
+	for(int i = gVoices.size() - 1; i >= 0; i--) {
+		if(!gVoices[i].envelope.isActive())
+			gVoices.release(i);
+	}
+}
+
+// This callback function is called every time a new MIDI message is available
+// This happens on a different thread than the audio processing, so the notes
+// are passed to render() through a queue rather than changing the voices here
+
+void midiEvent(MidiChannelMessage message, void *arg) {
+	NoteEvent event;
+	
+	// A MIDI "note on" message type might actually hold a real
+	// note onset (e.g. key press), or it might hold a note off (key release).
+	// The latter is signified by a velocity of 0.
+	if(message.getType() == kmmNoteOn) {
+		event.noteNumber = message.getDataByte(0);
+		event.velocity = message.getDataByte(1);
+	}
+	else if(message.getType() == kmmNoteOff) {
+		event.noteNumber = message.getDataByte(0);
+		event.velocity = 0;
+	}
+	else {
+		return;
+	}
+	
+	if(!gNoteEvents.push(event))
+		rt_printf("Note queue full: dropped note %d\n", event.noteNumber);
+}
+
+void cleanup(BelaContext *context, void *userData)
+{
+	
+}
\ No newline at end of file
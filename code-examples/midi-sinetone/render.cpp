@@ -17,6 +17,7 @@ midi-sinetone: basic sine wave synth controlled by MIDI
 
 #include <Bela.h>
 #include <libraries/Midi/Midi.h>
+#include <libraries/DspCore/FastMath.h>
 #include <stdlib.h>
 #include <cmath>
 
@@ -112,7 +113,7 @@ void render(BelaContext *context, void *userData)
 			gPhase += 2.0 * M_PI * gFrequency / context->audioSampleRate;
 			if(gPhase > M_PI)
 				gPhase -= 2.0 * M_PI;
-			value = sin(gPhase) * gAmplitude;
+			value = fastSin(gPhase) * gAmplitude;
 		} 
 		
 		for(unsigned int ch = 0; ch < context->audioOutChannels; ++ch)
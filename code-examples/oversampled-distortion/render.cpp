@@ -0,0 +1,110 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+oversampled-distortion: hard clipping distortion run at up to 8 times the sample rate to reduce aliasing
+*/
+
+#include <Bela.h>
+#include <libraries/Gui/Gui.h>
+#include <libraries/GuiController/GuiController.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/Oversampler.h>
+#include <libraries/DspCore/Kernels.h>
+#include <cmath>
+#include <vector>
+
+// The oversampling factors to choose from with the slider
+const unsigned int kNumFactors = 4;
+const unsigned int kFactors[kNumFactors] = {1, 2, 4, 8};
+
+// One oversampler for each factor, so switching doesn't need any setup
+Oversampler gOversamplers[kNumFactors];
+
+// Block of input to distort, also used for the output
+std::vector<float> gBlock;
+
+// Test tone, which makes the aliasing easy to hear: as the frequency goes up,
+// aliased harmonics come back down
+float gTonePhase = 0;
+
+// Browser-based GUI to adjust parameters
+Gui gGui;
+GuiController gGuiController;
+
+bool setup(BelaContext *context, void *userData)
+{
+	// Use the fastest version of the buffer kernels this processor can run
+	kernels::init();
+
+	gBlock.resize(context->audioFrames);
+
+	// Set up every factor and report what each one costs
+	for(unsigned int i = 0; i < kNumFactors; i++) {
+		gOversamplers[i].setup(kFactors[i], context->audioFrames);
+		float latency = gOversamplers[i].getLatency();
+		rt_printf("%ux oversampling: latency %.2f samples (%.2fms), %u multiplies per sample in the filters\n",
+				  kFactors[i], latency, 1000.0 * latency / context->audioSampleRate,
+				  gOversamplers[i].getMultipliesPerSample());
+	}
+
+	// Set up the GUI
+	gGui.setup(context->projectName);
+	gGuiController.setup(&gGui, "Distortion Controller");
+
+	// Arguments: name, default value, minimum, maximum, increment
+	gGuiController.addSlider("Drive (dB)", 20, 0, 40, 0);
+	gGuiController.addSlider("Oversampling (1x, 2x, 4x, 8x)", 3, 0, 3, 1);
+	gGuiController.addSlider("Tone frequency", 2000, 100, 8000, 0);
+	gGuiController.addSlider("Tone level (dB)", -20, -60, 0, 0);
+	gGuiController.addSlider("Output level (dB)", -20, -40, 0, 0);
+
+	return true;
+}
+
+void render(BelaContext *context, void *userData)
+{
+	float drive = dbToGain(gGuiController.getSliderValue(0));
+	unsigned int factorIndex = gGuiController.getSliderValue(1);
+	float toneFrequency = gGuiController.getSliderValue(2);
+	float toneLevel = dbToGain(gGuiController.getSliderValue(3));
+	float outputLevel = dbToGain(gGuiController.getSliderValue(4));
+	if(factorIndex >= kNumFactors)
+		factorIndex = kNumFactors - 1;
+
+	// Mix the first audio input with the test tone
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+		float in = context->audioInChannels > 0 ? audioRead(context, n, 0) : 0;
+		gBlock[n] = in + toneLevel * fastSin(gTonePhase);
+		gTonePhase += 2.0 * M_PI * toneFrequency / context->audioSampleRate;
+		if(gTonePhase >= M_PI)
+			gTonePhase -= 2.0 * M_PI;
+	}
+
+	// The distortion runs on the whole block at the higher rate. Hard clipping
+	// makes harmonics far above the Nyquist frequency, so even at 8x some
+	// aliasing remains, but much less than at 1x.
+	gOversamplers[factorIndex].process(gBlock.data(), gBlock.data(), context->audioFrames,
+		[drive](float *buffer, unsigned int frames) {
+			kernels::mul(buffer, drive, buffer, frames);
+			kernels::clip(buffer, buffer, frames, -1.0, 1.0);
+		});
+
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+		for(unsigned int channel = 0; channel < context->audioOutChannels; channel++) {
+			// Write the sample to every audio output channel
+			audioWrite(context, n, channel, outputLevel * gBlock[n]);
+		}
+	}
+}
+
+void cleanup(BelaContext *context, void *userData)
+{
+
+}
\ No newline at end of file
@@ -12,6 +12,7 @@ percussion: simple percussion instrument with a button and an exponential envelo
 */
 
 #include <Bela.h>
+#include <libraries/DspCore/FastMath.h>
 #include <math.h>
 
 // Digital input and analog output pin
@@ -46,7 +47,7 @@ void render(BelaContext *context, void *userData)
 		gPhase += 2.0 * M_PI * gFrequency / context->audioSampleRate;
 		if(gPhase >= 2.0 * M_PI)
 			gPhase -= 2.0 * M_PI;
-		float out = gAmplitude * sin(gPhase);
+		float out = gAmplitude * fastSin(gPhase);
 
 		// This part is done for you: store the sample in the
 		// audio output buffer
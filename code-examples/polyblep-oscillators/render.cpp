@@ -0,0 +1,122 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 4: Parameter control
+polyblep-oscillators: band-limited sawtooth, square and triangle oscillators with hard sync, without wavetables
+*/
+
+#include <Bela.h>
+#include <libraries/Gui/Gui.h>
+#include <libraries/GuiController/GuiController.h>
+#include <libraries/Scope/Scope.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/PolyBlep.h>
+#include <vector>
+
+// One oscillator with hard sync, and four more playing a chord
+PolyBlepOscillator gOscillator;
+PolyBlepOscillator4 gChord;
+
+// Intervals of the chord above the frequency slider, in semitones
+const float kChordIntervals[4] = {0, 4, 7, 11};
+
+// Block of the four chord oscillators, interleaved
+std::vector<float> gChordBlock;
+
+// Browser-based GUI to adjust parameters
+Gui gGui;
+GuiController gGuiController;
+
+// Browser-based oscilloscope
+Scope gScope;
+
+bool setup(BelaContext *context, void *userData)
+{
+	// Nothing to generate: compare this with the 32-harmonic wavetable in vco
+	gOscillator.setup(context->audioSampleRate);
+	gChord.setup(context->audioSampleRate);
+	gChordBlock.resize(4 * context->audioFrames);
+
+	// Set up the GUI
+	gGui.setup(context->projectName);
+	gGuiController.setup(&gGui, "Oscillator Controller");
+
+	// Arguments: name, default value, minimum, maximum, increment
+	gGuiController.addSlider("Waveform (saw, square, triangle)", 0, 0, 2, 1);
+	gGuiController.addSlider("Frequency", 220, 55, 1760, 0);
+	gGuiController.addSlider("Pulse width", 0.5, 0.05, 0.95, 0);
+	gGuiController.addSlider("Sync ratio (0 = off)", 0, 0, 8, 0);
+	gGuiController.addSlider("Chord (off, on)", 0, 0, 1, 1);
+	gGuiController.addSlider("Amplitude (dB)", -20, -40, -6, 0);
+
+	// Set up the oscilloscope
+	gScope.setup(1, context->audioSampleRate);
+
+	return true;
+}
+
+void render(BelaContext *context, void *userData)
+{
+	PolyBlepWaveform waveform = (PolyBlepWaveform)(int)gGuiController.getSliderValue(0);
+	float frequency = gGuiController.getSliderValue(1);
+	float pulseWidth = gGuiController.getSliderValue(2);
+	float syncRatio = gGuiController.getSliderValue(3);
+	bool chord = gGuiController.getSliderValue(4) > 0.5;
+	float amplitude = dbToGain(gGuiController.getSliderValue(5));
+
+	if(chord) {
+		// All four chord notes at once, one in each lane of a vector register
+		gChord.setWaveform(waveform);
+		for(unsigned int i = 0; i < 4; i++) {
+			gChord.setFrequency(i, frequency * fastExp2(kChordIntervals[i] / 12.0f));
+			gChord.setPulseWidth(i, pulseWidth);
+		}
+		gChord.process(gChordBlock.data(), context->audioFrames);
+	}
+	else {
+		// With sync, the frequency slider sets the pitch you hear (the sync
+		// frequency) and the oscillator itself runs faster, which changes
+		// the timbre
+		gOscillator.setWaveform(waveform);
+		gOscillator.setPulseWidth(pulseWidth);
+		if(syncRatio >= 1.0) {
+			gOscillator.setFrequency(frequency * syncRatio);
+			gOscillator.setSyncFrequency(frequency);
+		}
+		else {
+			gOscillator.setFrequency(frequency);
+			gOscillator.setSyncFrequency(0);
+		}
+	}
+
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+		float out;
+		if(chord) {
+			const float *frame = &gChordBlock[4 * n];
+			out = 0.25f * (frame[0] + frame[1] + frame[2] + frame[3]);
+		}
+		else {
+			out = gOscillator.process();
+		}
+		out *= amplitude;
+
+		for(unsigned int channel = 0; channel < context->audioOutChannels; channel++) {
+			// Write the sample to every audio output channel
+			audioWrite(context, n, channel, out);
+		}
+
+		// Write the output to the oscilloscope
+		gScope.log(out);
+	}
+}
+
+void cleanup(BelaContext *context, void *userData)
+{
+
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 17: Block-based processing
+processing-graph: two synth voices and a filter connected as a graph of block-based nodes
+*/
+
+#include <Bela.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/Wavetable.h>
+#include <libraries/DspCore/ADSR.h>
+#include <libraries/DspCore/Filter.h>
+#include <libraries/DspCore/ProcessingGraph.h>
+#include <cmath>
+#include <vector>
+
+// The objects which make the sound. The graph calls their block process()
+// methods; render() still sets their parameters directly.
+const int kNumVoices = 2;
+Wavetable gOscillators[kNumVoices];
+ADSR gEnvelopes[kNumVoices];
+Filter gFilter;
+
+// The graph connecting them:
+//   oscillator 0 x envelope 0 --> mixer --> filter --> output
+//   oscillator 1 x envelope 1 ----^
+ProcessingGraph gGraph;
+
+// A short repeating pattern of notes, one for each voice in turn
+const int kPattern[] = {48, 55, 60, 63, 67, 63, 60, 55};
+const int kPatternLength = sizeof(kPattern) / sizeof(kPattern[0]);
+int gPatternPosition = 0;
+float gNoteInterval = 0.25;			// Seconds between notes
+float gNoteLength = 0.15;			// Seconds before each note is released
+int gNoteCounter = 0;				// Frames since the last note
+
+// Filter sweep, updated once per block
+float gFilterPhase = 0;
+
+bool setup(BelaContext *context, void *userData)
+{
+	// Use the fastest version of the buffer kernels this processor can run
+	kernels::init();
+
+	std::vector<float> wavetable;
+	const unsigned int wavetableSize = 512;
+		
+	// Populate a buffer with the first 48 harmonics of a sawtooth wave
+	wavetable.resize(wavetableSize);
+	for(unsigned int n = 0; n < wavetable.size(); n++) {
+		wavetable[n] = 0;
+		for(unsigned int harmonic = 1; harmonic <= 48; harmonic++) {
+			wavetable[n] += 0.5 * sinf(2.0 * M_PI * (float)harmonic * (float)n / 
+								 (float)wavetable.size()) / (float)harmonic;
+		}
+	}
+	
+	// Set up the objects, then add a node for each one to the graph
+	ProcessorNode *mixer = gGraph.add<MixerNode>(kNumVoices, 0.5);
+	for(int i = 0; i < kNumVoices; i++) {
+		gOscillators[i].setup(context->audioSampleRate, wavetable);
+		gEnvelopes[i].setSampleRate(context->audioSampleRate);
+		gEnvelopes[i].setAttackTime(0.005);
+		gEnvelopes[i].setDecayTime(0.1);
+		gEnvelopes[i].setSustainLevel(0.4);
+		gEnvelopes[i].setReleaseTime(0.3);
+		
+		ProcessorNode *oscillator = gGraph.add<SourceNode<Wavetable>>(gOscillators[i]);
+		ProcessorNode *envelope = gGraph.add<SourceNode<ADSR>>(gEnvelopes[i]);
+		ProcessorNode *vca = gGraph.add<MultiplyNode>();
+		gGraph.connect(oscillator, vca, 0);
+		gGraph.connect(envelope, vca, 1);
+		gGraph.connect(vca, mixer, i);
+	}
+	
+	gFilter.setSampleRate(context->audioSampleRate);
+	gFilter.setQ(2);
+	ProcessorNode *filter = gGraph.add<EffectNode<Filter>>(gFilter);
+	gGraph.connect(mixer, filter);
+	gGraph.setOutput(filter);
+	
+	// Work out the order of the nodes and the buffers they need
+	if(!gGraph.setup(context->audioFrames)) {
+		rt_printf("Error: the processing graph has no output or contains a loop\n");
+		return false;
+	}
+	rt_printf("Processing graph: %u nodes sharing %u buffers\n", gGraph.numSteps(), gGraph.numBuffers());
+	
+	return true;
+}
+
+void render(BelaContext *context, void *userData)
+{
+	// Start and stop notes at the start of the block. The timing is only
+	// accurate to one block, which is fine for this pattern.
+	int noteFrames = gNoteInterval * context->audioSampleRate;
+	int releaseFrames = gNoteLength * context->audioSampleRate;
+	if(gNoteCounter == 0) {
+		int voice = gPatternPosition % kNumVoices;
+		gOscillators[voice].setFrequency(midiToHz(kPattern[gPatternPosition]));
+		gEnvelopes[voice].trigger();
+		gPatternPosition = (gPatternPosition + 1) % kPatternLength;
+	}
+	if(gNoteCounter < releaseFrames && gNoteCounter + (int)context->audioFrames >= releaseFrames)
+		gEnvelopes[(gPatternPosition + kNumVoices - 1) % kNumVoices].release();
+	gNoteCounter += context->audioFrames;
+	if(gNoteCounter >= noteFrames)
+		gNoteCounter = 0;
+	
+	// Sweep the filter slowly up and down
+	gFilterPhase += 2.0 * M_PI * 0.1 * context->audioFrames / context->audioSampleRate;
+	if(gFilterPhase >= M_PI)
+		gFilterPhase -= 2.0 * M_PI;
+	gFilter.setFrequency(1200.0 + 1000.0 * fastSin(gFilterPhase));
+	
+	// Run the whole graph for this block
+	const float *out = gGraph.process(context->audioFrames);
+	
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+		for(unsigned int channel = 0; channel < context->audioOutChannels; channel++) {
+			// Write the sample to every audio output channel
+			audioWrite(context, n, channel, out[n]);
+		}
+	}
+}
+
+void cleanup(BelaContext *context, void *userData)
+{
+
+}
\ No newline at end of file
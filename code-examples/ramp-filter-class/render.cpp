@@ -14,8 +14,8 @@ ramp-filter-class: resonant filter controlled by a linear envelope, using a clas
 #include <Bela.h>
 #include <libraries/Scope/Scope.h>
 #include <cmath>
-#include "Wavetable.h"
-#include "Filter.h"
+#include <libraries/DspCore/Wavetable.h>
+#include <libraries/DspCore/Filter.h>
 #include "Ramp.h"
 
 // Variables for linear envelope
@@ -13,8 +13,8 @@ ramp-filter: linear envelope to control the frequency of a resonant filter
 
 #include <Bela.h>
 #include <cmath>
-#include "Wavetable.h"
-#include "Filter.h"
+#include <libraries/DspCore/Wavetable.h>
+#include <libraries/DspCore/Filter.h>
 
 // Variables for linear envelope
 const float kRampDuration = 2.0;
@@ -0,0 +1,181 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 18: Phase vocoder, part 1
+render-profiler: measure how close render() and its parts come to the deadline
+*/
+
+#include <Bela.h>
+#include <libraries/Fft/Fft.h>
+#include <libraries/Scope/Scope.h>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <libraries/DspCore/Wavetable.h>
+#include <libraries/DspCore/Filter.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/RenderProfiler.h>
+
+// Zones of render() that we want to time. The whole of render() is
+// always measured as well, under the name "render".
+enum {
+	kZoneOscillators = 1,
+	kZoneFilter,
+	kZoneFftScheduling
+};
+
+// Profiler object, reporting once per second to the console and a file
+RenderProfiler gProfiler;
+const float kReportInterval = 1.0;
+std::string gProfileFilename = "profile.csv";
+
+// A bank of detuned sawtooth oscillators going through a lowpass filter
+const int kNumOscillators = 8;
+Wavetable gOscillators[kNumOscillators];
+Filter gFilter;
+float gFilterPhase = 0;
+
+// FFT analysis running in a lower-priority thread, as in fft-overlap-add-threads
+Fft gFft;
+const int gFftSize = 1024;
+const int gHopSize = 256;
+const int gBufferSize = 16384;
+std::vector<float> gInputBuffer(gBufferSize);
+int gInputBufferPointer = 0;
+int gHopCounter = 0;
+int gCachedInputBufferPointer = 0;
+AuxiliaryTask gFftTask;
+
+// One block of the signal, passed from each zone to the next
+std::vector<float> gBlock;
+
+// Bela oscilloscope
+Scope gScope;
+
+void process_fft_background(void *);
+
+bool setup(BelaContext *context, void *userData)
+{
+	std::vector<float> wavetable;
+	const unsigned int wavetableSize = 512;
+
+	// Populate a buffer with the first 32 harmonics of a sawtooth wave
+	wavetable.resize(wavetableSize);
+	for(unsigned int n = 0; n < wavetable.size(); n++) {
+		wavetable[n] = 0;
+		for(unsigned int harmonic = 1; harmonic <= 32; harmonic++) {
+			wavetable[n] += 0.5 * sinf(2.0 * M_PI * (float)harmonic * (float)n /
+								 (float)wavetable.size()) / (float)harmonic;
+		}
+	}
+
+	// Spread the oscillators slightly around 110Hz
+	for(int i = 0; i < kNumOscillators; i++) {
+		gOscillators[i].setup(context->audioSampleRate, wavetable);
+		gOscillators[i].setFrequency(110.0 * (1.0 + 0.002 * (i - kNumOscillators / 2)));
+	}
+
+	gFilter.setSampleRate(context->audioSampleRate);
+	gFilter.setQ(2.0);
+
+	gBlock.resize(context->audioFrames);
+
+	// Set up the FFT and its thread
+	gFft.setup(gFftSize);
+	gFftTask = Bela_createAuxiliaryTask(process_fft_background, 50, "bela-process-fft");
+
+	// Set up the profiler with the names of our zones, in the same order as the enum
+	if(!gProfiler.setup(context, {"oscillators", "filter", "fft-scheduling"},
+						kReportInterval, gProfileFilename)) {
+		rt_printf("Unable to set up the profiler\n");
+		return false;
+	}
+
+	// Initialise the scope
+	gScope.setup(1, context->audioSampleRate);
+
+	return true;
+}
+
+// Analyse the most recent window of output. The result isn't used: this is
+// here to show the cost of scheduling the FFT from render().
+void process_fft_background(void *)
+{
+	// Unwrap the window straight into the FFT's own buffer, so that nothing
+	// needs allocating here, in two parts if it wraps around the end of the
+	// circular buffer. There is no window function, so this is a plain copy.
+	int inStart = (gCachedInputBufferPointer - gFftSize + gBufferSize) % gBufferSize;
+	int inFirstPart = std::min(gFftSize, gBufferSize - inStart);
+	std::copy(gInputBuffer.begin() + inStart, gInputBuffer.begin() + inStart + inFirstPart, &gFft.td(0));
+	std::copy(gInputBuffer.begin(), gInputBuffer.begin() + (gFftSize - inFirstPart), &gFft.td(inFirstPart));
+	gFft.fft();
+}
+
+void render(BelaContext *context, void *userData)
+{
+	gProfiler.beginRender();
+
+	// Each zone works on the whole block, so that it is timed once per block
+	// and its share of the block period means something. Timing every
+	// sample would cost more than some of the zones themselves.
+
+	// Sum the oscillators
+	gProfiler.begin(kZoneOscillators);
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+		float out = 0;
+		for(int i = 0; i < kNumOscillators; i++)
+			out += gOscillators[i].process();
+		gBlock[n] = out / kNumOscillators;
+	}
+	gProfiler.end(kZoneOscillators);
+
+	// Sweep the filter slowly up and down. Recalculating the coefficients
+	// every sample is what makes this zone expensive.
+	gProfiler.begin(kZoneFilter);
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+		gFilterPhase += 2.0 * M_PI * 0.25 / context->audioSampleRate;
+		if(gFilterPhase > M_PI)
+			gFilterPhase -= 2.0 * M_PI;
+		gFilter.setFrequency(1000.0 + 800.0 * fastSin(gFilterPhase));
+		gBlock[n] = gFilter.process(gBlock[n]);
+	}
+	gProfiler.end(kZoneFilter);
+
+	// Store the output for the FFT and start a new FFT each hop
+	gProfiler.begin(kZoneFftScheduling);
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+		gInputBuffer[gInputBufferPointer++] = gBlock[n];
+		if(gInputBufferPointer >= gBufferSize)
+			gInputBufferPointer = 0;
+		if(++gHopCounter >= gHopSize) {
+			gHopCounter = 0;
+			gCachedInputBufferPointer = gInputBufferPointer;
+			Bela_scheduleAuxiliaryTask(gFftTask);
+		}
+	}
+	gProfiler.end(kZoneFftScheduling);
+
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+		for(unsigned int channel = 0; channel < context->audioOutChannels; channel++) {
+			audioWrite(context, n, channel, gBlock[n]);
+		}
+
+		gScope.log(gBlock[n]);
+	}
+
+	gProfiler.endRender();
+}
+
+void cleanup(BelaContext *context, void *userData)
+{
+	// Print a final summary of the whole run, once any background report
+	// has finished
+	gProfiler.stop();
+	gProfiler.report();
+}
\ No newline at end of file
@@ -13,7 +13,8 @@ resonant-lowpass: adjustable 2nd-order lowpass filter example (to complete in le
 
 #include <Bela.h>
 #include <cmath>
-#include "MonoFilePlayer.h"
+#include <libraries/DspCore/MonoFilePlayer.h>
+#include <libraries/DspCore/FastMath.h>
 
 // Name of the sound file (in project folder)
 std::string gFilename = "guitar-loop.wav";
@@ -31,7 +32,7 @@ float gB0 = 1, gB1 = 0, gB2 = 0;
 // Nigel Redmon
 void calculate_coefficients(float sampleRate, float frequency, float q)
 {
-    float k = tanf(M_PI * frequency / sampleRate);
+    float k = fastTan(M_PI * frequency / sampleRate);
     float norm = 1.0 / (1 + k / q + k * k);
     
     gB0 = k * k * norm;
@@ -12,7 +12,7 @@ sample-player-filter: template code for implementing digital filters
 */
 
 #include <Bela.h>
-#include "MonoFilePlayer.h"
+#include <libraries/DspCore/MonoFilePlayer.h>
 
 // Name of the sound file (in project folder)
 std::string gFilename = "slow-drum-loop.wav";
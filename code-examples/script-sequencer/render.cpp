@@ -0,0 +1,168 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 13: State Machines
+script-sequencer: metronome and step sequencer written as coroutine scripts instead of counters
+*/
+
+#include <Bela.h>
+#include <libraries/Scope/Scope.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/Wavetable.h>
+#include <libraries/DspCore/Filter.h>
+#include <libraries/DspCore/ADSR.h>
+#include <libraries/DspCore/Ramp.h>
+#include <libraries/DspCore/ControlScript.h>
+#include <cmath>
+#include <vector>
+
+// Runs the scripts below, resuming each one on the exact frame its wait ends
+ScriptRunner gRunner;
+float gTempo = 120;		// Beats per minute
+
+// Metronome click: a sine wave with an exponential envelope
+float gClickPhase = 0;
+float gClickFrequency = 1000;
+float gClickAmplitude = 0;
+float gClickDecay = 0.997;
+
+// Sequencer voice: sawtooth oscillator through a lowpass filter
+Wavetable gOscillator;
+ADSR gEnvelope;
+Filter gFilter;
+Ramp gCutoff;
+const float kAmplitude = 0.2;
+
+// Step sequencer contents
+std::vector<float> gSequence = {36, 48, 39, 51, 53, 41, 55, 43};
+
+// Browser-based oscilloscope
+Scope gScope;
+
+// Metronome: a high click on the first beat of each bar, then three low ones.
+// Replaces the counter and interval of the metronome examples.
+Script metronome(ScriptRunner& runner)
+{
+	while(true) {
+		for(int beat = 0; beat < 4; beat++) {
+			gClickFrequency = (beat == 0) ? 1500 : 1000;
+			gClickAmplitude = 0.5;
+			co_await runner.waitBeats(1);
+		}
+	}
+}
+
+// One note lasting a number of beats: start it with the filter open, close
+// the filter while it plays, then release it a little before the next note
+Script note(ScriptRunner& runner, float midiNote, float beats)
+{
+	gOscillator.setFrequency(midiToHz(midiNote));
+	gEnvelope.trigger();
+	gCutoff.setValue(3000);
+	co_await runner.waitBeats(0.25 * beats);
+
+	gCutoff.rampTo(300, runner.beatsToSeconds(0.5 * beats));
+	co_await runner.waitBeats(0.5 * beats);
+
+	gEnvelope.release();
+	co_await runner.waitBeats(0.25 * beats);
+}
+
+// Step sequencer: three bars of eighth notes, then a bar of triplets an
+// octave up, going backwards through the sequence
+Script sequencer(ScriptRunner& runner)
+{
+	while(true) {
+		for(int bar = 0; bar < 3; bar++) {
+			for(float midiNote : gSequence)
+				co_await note(runner, midiNote, 0.5);
+		}
+		for(int step = 0; step < 12; step++) {
+			int location = gSequence.size() - 1 - step % gSequence.size();
+			co_await note(runner, gSequence[location] + 12, 1.0 / 3.0);
+		}
+	}
+}
+
+bool setup(BelaContext *context, void *userData)
+{
+	std::vector<float> wavetable;
+	const unsigned int wavetableSize = 512;
+
+	// Populate a buffer with the first 32 harmonics of a sawtooth wave
+	wavetable.resize(wavetableSize);
+	for(unsigned int n = 0; n < wavetable.size(); n++) {
+		wavetable[n] = 0;
+		for(unsigned int harmonic = 1; harmonic <= 32; harmonic++) {
+			wavetable[n] += sinf(2.0 * M_PI * (float)harmonic * (float)n / 
+								 (float)wavetable.size()) / (float)harmonic;
+		}
+	}
+	gOscillator.setup(context->audioSampleRate, wavetable);
+
+	// Set up the filter and envelopes
+	gFilter.setSampleRate(context->audioSampleRate);
+	gFilter.setQ(4);
+	gCutoff.setSampleRate(context->audioSampleRate);
+	gEnvelope.setSampleRate(context->audioSampleRate);
+	gEnvelope.setAttackTime(0.005);
+	gEnvelope.setDecayTime(0.1);
+	gEnvelope.setSustainLevel(0.6);
+	gEnvelope.setReleaseTime(0.05);
+
+	// Reserve room for the scripts, then start them. Nothing is allocated
+	// after this, even when a script calls another.
+	gRunner.setup(context->audioSampleRate, 4, 256);
+	gRunner.setTempo(gTempo);
+	if(!gRunner.start(metronome(gRunner)) || !gRunner.start(sequencer(gRunner))) {
+		rt_printf("Error: unable to start the scripts\n");
+		return false;
+	}
+
+	// Set up the oscilloscope
+	gScope.setup(2, context->audioSampleRate);
+
+	return true;
+}
+
+void render(BelaContext *context, void *userData)
+{
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+		// Resume any scripts whose wait ends on this frame
+		gRunner.process();
+
+		// Metronome click
+		gClickAmplitude *= gClickDecay;
+		gClickPhase += 2.0 * M_PI * gClickFrequency / context->audioSampleRate;
+		if(gClickPhase >= 2.0 * M_PI)
+			gClickPhase -= 2.0 * M_PI;
+		float click = gClickAmplitude * fastSin(gClickPhase);
+
+		// Sequencer voice
+		float cutoff = gCutoff.process();
+		gFilter.setFrequency(cutoff);
+		float voice = kAmplitude * gEnvelope.process() * gFilter.process(gOscillator.process());
+
+		float out = 0.5 * click + voice;
+		for(unsigned int channel = 0; channel < context->audioOutChannels; channel++) {
+			audioWrite(context, n, channel, out);
+		}
+
+		// Write the output and the cutoff frequency to the oscilloscope
+		gScope.log(out, cutoff / 3000.0);
+	}
+}
+
+void cleanup(BelaContext *context, void *userData)
+{
+	// Report how much of the script pool was needed
+	rt_printf("Largest script frame: %u bytes; scripts unable to start: %u\n",
+			  gRunner.largestFrame(), gRunner.failedStarts());
+	gRunner.stop();
+}
\ No newline at end of file
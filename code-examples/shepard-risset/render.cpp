@@ -24,6 +24,7 @@ The Bela software is distributed under the GNU Lesser General Public License
 #include <Bela.h>
 #include <libraries/Scope/Scope.h>
 #include <libraries/Gui/Gui.h>
+#include <libraries/DspCore/FastMath.h>
 #include <cmath>
 #include <vector>
 #include "Sine.h"
@@ -50,6 +51,9 @@ const float kAmplitude = 0.1;
 // change the values above.
 const float kMaxFrequencyRatio = log(powf(kFrequencyRatio, kNumOscillators)) / log(2.0);
 
+// For turning powers of 10 into powers of 2
+const float kLog2Of10 = log2f(10.0);
+
 // How often to update the oscillator frequencies
 // Don't do this every sample as it's inefficient and will run into
 // numerical precision issues
@@ -128,8 +132,9 @@ void render(BelaContext *context, void *userData)
 	// How long (in seconds) to complete one cycle, i.e. an increase by kFrequencyRatio
 	// The effect is better when this is longer
 	// Map Y-axis (2nd element in the buffer) to cycle time
-	// Logarithmic mapping between 0.1 and 20.0
-	float cycleTime = powf(10.0, map(data[1], 0.0, 1.0, log(2.0), -1.0));
+	// Logarithmic mapping between 0.1 and 20.0: 10 to the power of the
+	// mapped value, worked out as a power of 2
+	float cycleTime = fastExp2(kLog2Of10 * map(data[1], 0.0, 1.0, log(2.0), -1.0));
 
 	// Amount to update the frequency by on a normalised 0-1 scale
 	// Controls how fast the glissando moves
@@ -150,7 +155,7 @@ void render(BelaContext *context, void *userData)
 			for(unsigned int i = 0; i < kNumOscillators; i++)
 			{
 				// Calculate the actual frequency from the normalised log-frequency
-				float frequency = kLowestBaseFrequency * powf(2.0, gLogFrequencies[i] * kMaxFrequencyRatio);
+				float frequency = kLowestBaseFrequency * fastExp2(gLogFrequencies[i] * kMaxFrequencyRatio);
 				gOscillators[i].setFrequency(frequency);
 
 				// Calculate the amplitude of this oscillator by finding its position in the
@@ -15,6 +15,7 @@ sine-slider: oscillator example using a browser-based GUI for control
 #include <Bela.h>
 #include <libraries/Gui/Gui.h>      				 // Need this to use the GUI
 #include <libraries/GuiController/GuiController.h>   // Need this to use the GUI
+#include <libraries/DspCore/FastMath.h>
 #include <math.h>
 
 float gPhase = 0;			// Save the phase between calls to render()
@@ -51,7 +52,7 @@ void render(BelaContext *context, void *userData)
 			gPhase -= 2.0 * M_PI;
 
 		// Calculate a sample of the sine wave
-		float out = amplitude * sin(gPhase);
+		float out = amplitude * fastSin(gPhase);
 
 		// Store the sample in the audio output buffer
 		for(unsigned int channel = 0; channel < context->audioOutChannels; channel++) {
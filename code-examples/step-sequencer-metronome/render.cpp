@@ -13,10 +13,11 @@ step-sequencer-metronome: cycles through a sequence of frequencies at a regular
 
 #include <Bela.h>
 #include <libraries/Scope/Scope.h>
+#include <libraries/DspCore/FastMath.h>
 #include <cmath>
 #include <vector>
 
-#include "Wavetable.h"	// This is needed for the Wavetable class
+#include <libraries/DspCore/Wavetable.h>	// This is needed for the Wavetable class
 
 // Constants that define the program behaviour
 const unsigned int kWavetableSize = 512;
@@ -85,7 +86,7 @@ void render(BelaContext *context, void *userData)
     	
     	// Get current frequency based on where we are in the sequencer
     	float midiNote = gSequencerBuffer[gSequencerLocation];
-    	float frequency = 440.0 * powf(2.0, (midiNote - 69.0) / 12.0);
+    	float frequency = midiToHz(midiNote);
     	
     	// Calculate frequences of each of two oscillators
 		float frequencies[2];
@@ -13,10 +13,11 @@ step-sequencer: cycles through a sequence of frequencies on button press
 
 #include <Bela.h>
 #include <libraries/Scope/Scope.h>
+#include <libraries/DspCore/FastMath.h>
 #include <cmath>
 #include <vector>
 
-#include "wavetable.h"	// This is needed for the Wavetable class
+#include <libraries/DspCore/Wavetable.h>	// This is needed for the Wavetable class
 
 // Constants that define the program behaviour
 const unsigned int kWavetableSize = 512;
@@ -83,7 +84,7 @@ void render(BelaContext *context, void *userData)
     	
     	// TODO 1: get current frequency based on where we are in the sequencer
     	float midiNote = 60;
-    	float frequency = 440.0 * powf(2.0, (midiNote - 69.0) / 12.0);
+    	float frequency = midiToHz(midiNote);
     	
     	// Calculate frequences of each of two oscillators
 		float frequencies[2];
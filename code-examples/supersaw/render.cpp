@@ -0,0 +1,134 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 4: Parameter control
+supersaw: up to 16 detuned sawtooth copies spread across the stereo field
+*/
+
+#include <Bela.h>
+#include <libraries/Gui/Gui.h>
+#include <libraries/GuiController/GuiController.h>
+#include <libraries/Scope/Scope.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/UnisonOscillator.h>
+#include <libraries/DspCore/ADSR.h>
+#include <vector>
+
+// All the copies are one oscillator: compare this with the two Wavetable
+// objects detuned by kDetune in step-sequencer
+UnisonOscillator gOscillator;
+
+// Envelope for the repeated notes, and the time until the next one
+ADSR gEnvelope;
+unsigned int gNoteCounter = 0;
+bool gNoteIsOn = false;
+
+// Blocks for the two channels of the oscillator and the envelope
+std::vector<float> gLeftBlock, gRightBlock, gEnvelopeBlock;
+
+// Browser-based GUI to adjust parameters
+Gui gGui;
+GuiController gGuiController;
+
+// Browser-based oscilloscope
+Scope gScope;
+
+bool setup(BelaContext *context, void *userData)
+{
+	// Make the sawtooth tables for every octave
+	gOscillator.setup(context->audioSampleRate);
+
+	gEnvelope.setSampleRate(context->audioSampleRate);
+	gEnvelope.setAttackTime(0.01);
+	gEnvelope.setDecayTime(0.2);
+	gEnvelope.setSustainLevel(0.7);
+	gEnvelope.setReleaseTime(0.3);
+
+	gLeftBlock.resize(context->audioFrames);
+	gRightBlock.resize(context->audioFrames);
+	gEnvelopeBlock.resize(context->audioFrames);
+
+	// Set up the GUI
+	gGui.setup(context->projectName);
+	gGuiController.setup(&gGui, "Supersaw Controller");
+
+	// Arguments: name, default value, minimum, maximum, increment
+	gGuiController.addSlider("Frequency", 110, 55, 880, 0);
+	gGuiController.addSlider("Voices", 7, 1, 16, 1);
+	gGuiController.addSlider("Detune (cents)", 40, 0, 100, 0);
+	gGuiController.addSlider("Stereo width", 1, 0, 1, 0);
+	gGuiController.addSlider("Phase randomness", 1, 0, 1, 0);
+	gGuiController.addSlider("Notes per second (0 = held)", 1, 0, 4, 0);
+	gGuiController.addSlider("Amplitude (dB)", -20, -40, -6, 0);
+
+	// Set up the oscilloscope
+	gScope.setup(2, context->audioSampleRate);
+
+	return true;
+}
+
+void render(BelaContext *context, void *userData)
+{
+	float notesPerSecond = gGuiController.getSliderValue(5);
+	float amplitude = dbToGain(gGuiController.getSliderValue(6));
+
+	gOscillator.setFrequency(gGuiController.getSliderValue(0));
+	gOscillator.setNumVoices(gGuiController.getSliderValue(1));
+	gOscillator.setDetune(gGuiController.getSliderValue(2));
+	gOscillator.setStereoWidth(gGuiController.getSliderValue(3));
+	gOscillator.setPhaseRandomness(gGuiController.getSliderValue(4));
+
+	// Start a note at the start of a block every so often, and release it
+	// halfway to the next one. Each note restarts the copies' phases: with
+	// no randomness they all start together, which you can hear as a sweep
+	// at the start of every note.
+	if(notesPerSecond <= 0) {
+		if(!gNoteIsOn) {
+			gOscillator.reset();
+			gEnvelope.trigger();
+			gNoteIsOn = true;
+		}
+		gNoteCounter = 0;
+	}
+	else if(gNoteCounter == 0) {
+		gOscillator.reset();
+		gEnvelope.trigger();
+		gNoteIsOn = true;
+		gNoteCounter = context->audioSampleRate / notesPerSecond;
+	}
+	else {
+		if(gNoteIsOn && gNoteCounter < 0.5 * context->audioSampleRate / notesPerSecond) {
+			gEnvelope.release();
+			gNoteIsOn = false;
+		}
+		gNoteCounter = gNoteCounter > context->audioFrames ? gNoteCounter - context->audioFrames : 0;
+	}
+
+	// Every copy at once, then the envelope
+	gOscillator.process(gLeftBlock.data(), gRightBlock.data(), context->audioFrames);
+	gEnvelope.process(gEnvelopeBlock.data(), context->audioFrames);
+
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+		float gain = amplitude * gEnvelopeBlock[n];
+		float left = gain * gLeftBlock[n];
+		float right = gain * gRightBlock[n];
+
+		// Left and right on the first two channels, and the same on any more
+		for(unsigned int channel = 0; channel < context->audioOutChannels; channel++)
+			audioWrite(context, n, channel, (channel & 1) ? right : left);
+
+		// Write both channels to the oscilloscope
+		gScope.log(left, right);
+	}
+}
+
+void cleanup(BelaContext *context, void *userData)
+{
+
+}
\ No newline at end of file
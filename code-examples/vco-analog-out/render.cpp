@@ -17,13 +17,16 @@ vco-analog-out: a project which shows the beat frequencies between two
 #include <libraries/Gui/Gui.h>
 #include <libraries/GuiController/GuiController.h>
 #include <libraries/Scope/Scope.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/LfoBank.h>
 #include <cmath>
 #include <vector>
 
-#include "wavetable.h"	// This is needed for the Wavetable class
+#include <libraries/DspCore/Wavetable.h>	// This is needed for the Wavetable class
 
 // Constants that define the program behaviour
 const unsigned int kWavetableSize = 512;
+const float kLedMinimum = 1.5 / 5.0;		// Lowest analog out level where the LED is lit
 
 // Browser-based GUI to adjust parameters
 Gui gGui;
@@ -35,8 +38,9 @@ Scope gScope;
 // Wavetable oscillator
 Wavetable gOscillators[2];
 
-// Wavetable for the LFO
-Wavetable gLFO;
+// The LFO only needs working out every 16 samples, so it comes from an
+// LfoBank rather than another full-rate Wavetable
+LfoBank gLFO;
 
 bool setup(BelaContext *context, void *userData)
 {
@@ -69,14 +73,11 @@ bool setup(BelaContext *context, void *userData)
 		gOscillators[i].setup(context->audioSampleRate, wavetable);
 	}
 	
-	// Repopulate the wavetable with a sine wave, scaled to an appropriate
-	// range for the LED (analog output is 0 to 1)
-	for(unsigned int n = 0; n < wavetable.size(); n++) {
-		float minimum = (1.5 / 5.0);
-		wavetable[n] = minimum + (1.0 - minimum) * 0.5 * 
-								 (1.0 + sinf(2.0 * M_PI * (float)n / (float)wavetable.size()));	
-	}
-	gLFO.setup(context->audioSampleRate, wavetable);
+	// One sine LFO, worked out every 16 samples. Its output is -1 to 1,
+	// which needs scaling to an appropriate range for the LED (analog
+	// output is 0 to 1)
+	gLFO.setup(context->audioSampleRate, 1, 16);
+	gLFO.setShape(0, kLfoSine);
 	
 	// Set up the GUI
 	gGui.setup(context->projectName);
@@ -104,11 +105,11 @@ void render(BelaContext *context, void *userData)
     	float input2 = analogRead(context, n/2, 2);
     	
     	// Rescale their ranges to match the GUI sliders
-    	float frequency = 55.0 * powf(2.0, input0 * 4.096);
+    	float frequency = 55.0 * fastExp2(input0 * 4.096);
     	float amplitudeDB = map(input1, 0, 3.3 / 4.096, -80, -6);
     	float detune = map(input2, 0, 3.3 / 4.096, 0, .05);
     	
-    	float amplitude = powf(10.0, amplitudeDB / 20);		// Convert dB to linear amplitude
+    	float amplitude = dbToGain(amplitudeDB);		// Convert dB to linear amplitude
 	
 		float frequencies[2];
 		frequencies[0] = frequency * (1.0 + detune);
@@ -129,7 +130,8 @@ void render(BelaContext *context, void *userData)
     	// Write the output to the oscilloscope
     	gScope.log(out);    
  
-		// TODO 2: calculate the LFO value and write it to the analog output
+		// TODO 2: move the LFO on by one sample, scale its value to run from
+		// kLedMinimum to 1 and write it to the analog output
     }
 }
 
@@ -15,10 +15,11 @@ vco: a project to be converted from GUI controls into analog input controls
 #include <libraries/Gui/Gui.h>
 #include <libraries/GuiController/GuiController.h>
 #include <libraries/Scope/Scope.h>
+#include <libraries/DspCore/FastMath.h>
 #include <cmath>
 #include <vector>
 
-#include "wavetable.h"	// This is needed for the Wavetable class
+#include <libraries/DspCore/Wavetable.h>	// This is needed for the Wavetable class
 
 // Constants that define the program behaviour
 const unsigned int kWavetableSize = 512;
@@ -88,7 +89,7 @@ void render(BelaContext *context, void *userData)
 	float amplitudeDB = gGuiController.getSliderValue(1);	// Amplitude is second slider	
 	float detune = gGuiController.getSliderValue(2);		// Detune ratio is third slider
 	
-	float amplitude = powf(10.0, amplitudeDB / 20);		// Convert dB to linear amplitude
+	float amplitude = dbToGain(amplitudeDB);		// Convert dB to linear amplitude
 	
 	float frequencies[2];
 	frequencies[0] = frequency * (1.0 + detune);
@@ -15,6 +15,7 @@ wavetable-class: an example that implements a wavetable oscillator as a C++ clas
 #include <libraries/Gui/Gui.h>
 #include <libraries/GuiController/GuiController.h>
 #include <libraries/Scope/Scope.h>
+#include <libraries/DspCore/FastMath.h>
 #include <cmath>
 #include <vector>
 
@@ -63,7 +64,7 @@ void render(BelaContext *context, void *userData)
 	float frequency = controller.getSliderValue(0);		// Frequency is first slider
 	float amplitudeDB = controller.getSliderValue(1);	// Amplitude is second slider	
 	
-	float amplitude = powf(10.0, amplitudeDB / 20);		// Convert dB to linear amplitude
+	float amplitude = dbToGain(amplitudeDB);		// Convert dB to linear amplitude
 	
 	gOscillator.setFrequency(frequency);
 	
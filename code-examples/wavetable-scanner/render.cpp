@@ -0,0 +1,141 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - Lecture 4: Parameter control
+wavetable-scanner: oscillator that morphs through a stack of band-limited wavetables
+*/
+
+#include <Bela.h>
+#include <libraries/Gui/Gui.h>
+#include <libraries/GuiController/GuiController.h>
+#include <libraries/Scope/Scope.h>
+#include <libraries/DspCore/FastMath.h>
+#include <libraries/DspCore/WavetableScanner.h>
+#include <vector>
+#include <cmath>
+
+// Put a wavetable exported from another synth in the project under this
+// name to play it instead of the built-in frames. It should be mono, with
+// the frames one after another.
+const char kFilename[] = "wavetable.wav";
+const unsigned int kFrameSize = 2048;	// Samples in each frame
+const unsigned int kNumFrames = 64;		// Frames to generate if there is no file
+
+WavetableScanner gScanner;
+float gScanPhase = 0;					// Phase of the automatic scan, 0 to 1
+std::vector<float> gBlock;				// One block of the oscillator's output
+
+// Browser-based GUI to adjust parameters
+Gui gGui;
+GuiController gGuiController;
+
+// Browser-based oscilloscope
+Scope gScope;
+
+// Make the built-in frames: a sine wave which gains harmonics until it is a
+// sawtooth, then a square wave which narrows to a thin pulse. The sawtooth
+// and pulse are generated naively, with sharp edges: the scanner removes the
+// harmonics that would alias at each pitch when it builds its tables.
+std::vector<float> makeFrames()
+{
+	std::vector<float> frames(kNumFrames * kFrameSize);
+	const unsigned int half = kNumFrames / 2;
+	for(unsigned int frame = 0; frame < kNumFrames; frame++) {
+		float *table = &frames[frame * kFrameSize];
+		for(unsigned int n = 0; n < kFrameSize; n++) {
+			float phase = (float)n / (float)kFrameSize;
+			if(frame < half) {
+				float mix = (float)frame / (float)(half - 1);
+				float sine = sinf(2.0 * M_PI * phase);
+				float saw = 1.0f - 2.0f * phase;
+				table[n] = (1.0f - mix) * sine + mix * saw;
+			}
+			else {
+				float width = 0.5f - 0.45f * (float)(frame - half) / (float)(kNumFrames - half - 1);
+				table[n] = phase < width ? 1.0f : -1.0f;
+			}
+		}
+	}
+	return frames;
+}
+
+bool setup(BelaContext *context, void *userData)
+{
+	// Load the frames from the file if there is one, otherwise make them.
+	// Either way, building the band-limited tables takes a moment here,
+	// and none of it happens in render().
+	if(gScanner.load(context->audioSampleRate, kFilename, kFrameSize)) {
+		rt_printf("Loaded %u frames from %s\n", gScanner.getNumFrames(), kFilename);
+	}
+	else if(!gScanner.setup(context->audioSampleRate, makeFrames(), kFrameSize)) {
+		rt_printf("Unable to build the wavetables\n");
+		return false;
+	}
+	rt_printf("%u frames of %u samples, %u levels\n", gScanner.getNumFrames(),
+			  gScanner.getFrameSize(), gScanner.getNumLevels());
+	gBlock.resize(context->audioFrames);
+
+	// Set up the GUI
+	gGui.setup(context->projectName);
+	gGuiController.setup(&gGui, "Wavetable Scanner");
+
+	// Arguments: name, default value, minimum, maximum, increment
+	gGuiController.addSlider("Frequency", 110, 27.5, 1760, 0);
+	gGuiController.addSlider("Position", 0, 0, 1, 0);
+	gGuiController.addSlider("Scan rate (Hz, 0 = off)", 0.1, 0, 4, 0);
+	gGuiController.addSlider("Amplitude (dB)", -20, -40, -6, 0);
+
+	// Set up the oscilloscope
+	gScope.setup(1, context->audioSampleRate);
+
+	return true;
+}
+
+void render(BelaContext *context, void *userData)
+{
+	float frequency = gGuiController.getSliderValue(0);
+	float position = gGuiController.getSliderValue(1);
+	float scanRate = gGuiController.getSliderValue(2);
+	float amplitude = dbToGain(gGuiController.getSliderValue(3));
+
+	// With the scan turned on, sweep back and forth through the frames,
+	// around the position from the slider. The position only needs to
+	// change once per block: the scanner crossfades smoothly to it.
+	if(scanRate > 0) {
+		gScanPhase += scanRate * context->audioFrames / context->audioSampleRate;
+		if(gScanPhase >= 1.0)
+			gScanPhase -= 1.0;
+		position += 0.5f - 0.5f * fastCos(2.0 * M_PI * gScanPhase);
+		if(position > 1.0f)
+			position = 2.0f - position;
+	}
+
+	gScanner.setFrequency(frequency);
+	gScanner.setPosition(position);
+
+	// Work out the whole block at once
+	gScanner.process(gBlock.data(), context->audioFrames);
+
+	for(unsigned int n = 0; n < context->audioFrames; n++) {
+		float value = amplitude * gBlock[n];
+
+		for(unsigned int channel = 0; channel < context->audioOutChannels; channel++) {
+			// Write the sample to every audio output channel
+			audioWrite(context, n, channel, value);
+		}
+
+		// Write the output to the oscilloscope
+		gScope.log(value);
+	}
+}
+
+void cleanup(BelaContext *context, void *userData)
+{
+
+}
\ No newline at end of file
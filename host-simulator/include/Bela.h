@@ -0,0 +1,184 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// Bela.h: stand-in for the Bela core API so that the course examples can be
+// compiled and run on an ordinary computer. The layout of BelaContext and the
+// behaviour of the I/O functions follow the Bela core (interleaved buffers,
+// digital directions in the low 16 bits and values in the high 16 bits).
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+
+// Flags for BelaContext::flags
+#define BELA_FLAG_INTERLEAVED (1 << 0)
+#define BELA_FLAG_ANALOG_OUTPUTS_PERSIST (1 << 1)
+
+// Values for digital pins
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x0
+#define OUTPUT 0x1
+
+#define MAX_PROJECTNAME_LENGTH 256
+
+// Structure holding the state of the audio, analog and digital I/O, as on Bela
+struct BelaContext {
+	const float *audioIn;				// Interleaved audio input
+	float *audioOut;					// Interleaved audio output
+	const float *analogIn;				// Interleaved analog input, 0 to 1
+	float *analogOut;					// Interleaved analog output, 0 to 1
+	uint32_t *digital;					// Digital directions (bits 0-15) and values (bits 16-31)
+
+	uint32_t audioFrames;				// Frames per block of audio
+	uint32_t audioInChannels;
+	uint32_t audioOutChannels;
+	float audioSampleRate;
+
+	uint32_t analogFrames;				// Frames per block of analog I/O
+	uint32_t analogInChannels;
+	uint32_t analogOutChannels;
+	float analogSampleRate;
+
+	uint32_t digitalFrames;				// Frames per block of digital I/O
+	uint32_t digitalChannels;
+	float digitalSampleRate;
+
+	uint64_t audioFramesElapsed;		// Number of audio frames since the start
+	uint32_t multiplexerChannels;
+	uint32_t multiplexerStartingChannel;
+	const float *multiplexerAnalogIn;
+	uint32_t audioExpanderEnabled;
+	uint32_t flags;
+
+	char projectName[MAX_PROJECTNAME_LENGTH];
+};
+
+// Handle for an auxiliary task
+typedef void* AuxiliaryTask;
+
+// Set to a non-zero value to stop the audio processing
+extern int volatile gShouldStop;
+
+// User functions, implemented by each project
+bool setup(BelaContext *context, void *userData);
+void render(BelaContext *context, void *userData);
+void cleanup(BelaContext *context, void *userData);
+
+// Auxiliary tasks run on their own thread, started by Bela_scheduleAuxiliaryTask()
+AuxiliaryTask Bela_createAuxiliaryTask(void (*callback)(void*), int priority, const char *name, void *arg = nullptr);
+int Bela_scheduleAuxiliaryTask(AuxiliaryTask task);
+void Bela_deleteAllAuxiliaryTasks();
+
+// Stop the audio processing from anywhere in the program
+void Bela_requestStop();
+
+// Printing functions which are safe to call from the audio thread on Bela
+int rt_printf(const char *format, ...);
+int rt_fprintf(FILE *stream, const char *format, ...);
+
+// Audio I/O
+
+static inline float audioRead(BelaContext *context, int frame, int channel)
+{
+	return context->audioIn[frame * context->audioInChannels + channel];
+}
+
+static inline void audioWrite(BelaContext *context, int frame, int channel, float value)
+{
+	context->audioOut[frame * context->audioOutChannels + channel] = value;
+}
+
+// Analog I/O
+
+static inline float analogRead(BelaContext *context, int frame, int channel)
+{
+	return context->analogIn[frame * context->analogInChannels + channel];
+}
+
+// Write a value which holds until the end of the block
+static inline void analogWrite(BelaContext *context, int frame, int channel, float value)
+{
+	for(unsigned int f = frame; f < context->analogFrames; f++)
+		context->analogOut[f * context->analogOutChannels + channel] = value;
+}
+
+// Write a value to a single frame only
+static inline void analogWriteOnce(BelaContext *context, int frame, int channel, float value)
+{
+	context->analogOut[frame * context->analogOutChannels + channel] = value;
+}
+
+// Digital I/O
+
+static inline int digitalRead(BelaContext *context, int frame, int channel)
+{
+	return (context->digital[frame] >> (channel + 16)) & 1;
+}
+
+// Write a value which holds until the end of the block
+static inline void digitalWrite(BelaContext *context, int frame, int channel, int value)
+{
+	for(unsigned int f = frame; f < context->digitalFrames; f++) {
+		if(value)
+			context->digital[f] |= 1u << (channel + 16);
+		else
+			context->digital[f] &= ~(1u << (channel + 16));
+	}
+}
+
+// Write a value to a single frame only
+static inline void digitalWriteOnce(BelaContext *context, int frame, int channel, int value)
+{
+	if(value)
+		context->digital[frame] |= 1u << (channel + 16);
+	else
+		context->digital[frame] &= ~(1u << (channel + 16));
+}
+
+// Set the direction of a pin from this frame until the end of the block. On Bela
+// a set bit means input.
+static inline void pinMode(BelaContext *context, int frame, int channel, int mode)
+{
+	for(unsigned int f = frame; f < context->digitalFrames; f++) {
+		if(mode == INPUT)
+			context->digital[f] |= 1u << channel;
+		else
+			context->digital[f] &= ~(1u << channel);
+	}
+}
+
+static inline void pinModeOnce(BelaContext *context, int frame, int channel, int mode)
+{
+	if(mode == INPUT)
+		context->digital[frame] |= 1u << channel;
+	else
+		context->digital[frame] &= ~(1u << channel);
+}
+
+// Utilities
+
+// Linearly rescale a number from one range of values to another
+static inline float map(float x, float in_min, float in_max, float out_min, float out_max)
+{
+	return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// Clip a number to lie between a minimum and maximum value
+static inline float constrain(float x, float min_val, float max_val)
+{
+	if(x < min_val) return min_val;
+	if(x > max_val) return max_val;
+	return x;
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// AudioFile.h: load and save WAV files, with the same functions as the
+// Bela AudioFile library. PCM (8, 16, 24 and 32 bit) and floating point
+// files can be read; files are written as 32-bit floating point.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace AudioFileUtilities {
+	// Information about a file, or -1 if it cannot be opened
+	int getNumChannels(const std::string& filename);
+	int getNumFrames(const std::string& filename);
+	int getSampleRate(const std::string& filename);
+
+	// Load up to maxCount frames (0 for all) of every channel, starting at frame start
+	std::vector<std::vector<float> > load(const std::string& filename, int maxCount = 0, unsigned int start = 0);
+
+	// Load the first channel of a file
+	std::vector<float> loadMono(const std::string& filename);
+
+	// Write interleaved or per-channel data to a file. Returns 0 on success.
+	int write(const std::string& filename, float *buf, unsigned int channels, unsigned int frames, unsigned int sampleRate);
+	int write(const std::string& filename, const std::vector<std::vector<float> >& dataIn, unsigned int sampleRate);
+}
\ No newline at end of file
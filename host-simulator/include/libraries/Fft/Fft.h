@@ -0,0 +1,65 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// Fft.h: stand-in for the Bela Fft library, which uses NE10 on the board.
+// Here a plain radix-2 FFT does the work. As with NE10, the inverse FFT only
+// looks at bins 0 to N/2, treating the upper half as their complex conjugate,
+// and scales the result by 1/N.
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <libraries/math_neon/math_neon.h>
+
+class Fft {
+public:
+	// Constructors
+	Fft() {}
+	Fft(unsigned int length) { setup(length); }
+
+	// Prepare for transforms of the given length, which must be a power of two
+	int setup(unsigned int length);
+	void cleanup();
+
+	// Forward transform of real input, from the argument or td()
+	void fft(const std::vector<float>& input);
+	void fft();
+
+	// Inverse transform to real output, from the arguments or fdr()/fdi()
+	void ifft(const std::vector<float>& reInput, const std::vector<float>& imInput);
+	void ifft();
+
+	// Access the time domain data and the real, imaginary and absolute
+	// values of the frequency domain data
+	float& td(unsigned int n) { return timeDomain_[n]; }
+	float& fdr(unsigned int n) { return frequencyDomainReal_[n]; }
+	float& fdi(unsigned int n) { return frequencyDomainImag_[n]; }
+	float fda(unsigned int n) { return sqrtf(fdr(n) * fdr(n) + fdi(n) * fdi(n)); }
+
+	unsigned int getLength() { return length_; }
+
+	static bool isPowerOfTwo(unsigned int n) { return n > 0 && (n & (n - 1)) == 0; }
+	static unsigned int roundUpToPowerOfTwo(unsigned int n);
+
+private:
+	// In-place complex transform of the working buffers
+	void transform(bool inverse);
+
+	unsigned int length_ = 0;
+	std::vector<float> timeDomain_;
+	std::vector<float> frequencyDomainReal_;
+	std::vector<float> frequencyDomainImag_;
+	std::vector<float> workReal_, workImag_;		// Buffers for the transform
+	std::vector<float> cosTable_, sinTable_;		// Twiddle factors
+	std::vector<unsigned int> bitReverse_;			// Order for the first stage
+};
\ No newline at end of file
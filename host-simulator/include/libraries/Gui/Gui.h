@@ -0,0 +1,76 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// Gui.h: stand-in for the Bela browser GUI. No browser ever connects, so
+// buffers sent to the GUI are discarded and buffers received from it keep
+// the values they were created with (zero).
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Buffer of data received from the GUI
+class DataBuffer {
+public:
+	DataBuffer(char type, unsigned int size);
+
+	char getType() { return type_; }
+	unsigned int getCapacity() { return capacity_; }
+	unsigned int getNumElements() { return capacity_; }
+
+	// Access the contents as different types
+	char *getAsChar() { return buffer_.data(); }
+	int *getAsInt() { return reinterpret_cast<int*>(buffer_.data()); }
+	float *getAsFloat() { return reinterpret_cast<float*>(buffer_.data()); }
+	std::vector<char>& getBuffer() { return buffer_; }
+
+private:
+	char type_;
+	unsigned int capacity_;
+	std::vector<char> buffer_;
+};
+
+class Gui {
+public:
+	// Constructor
+	Gui() {}
+
+	// Set up the GUI for the given project
+	int setup(std::string projectName, unsigned int port = 5555, std::string address = "gui");
+
+	// Whether a browser is connected: never, in the simulator
+	bool isConnected() { return false; }
+
+	// Create a buffer to receive data from the GUI. Returns its index.
+	int setBuffer(char bufferType, unsigned int size);
+
+	// Get a buffer of data received from the GUI
+	DataBuffer& getDataBuffer(unsigned int bufferId) { return buffers_[bufferId]; }
+
+	// Send data to the GUI (ignored in the simulator)
+	template<typename T>
+	int sendBuffer(unsigned int bufferId, T *buffer, unsigned int count) { return 0; }
+	template<typename T, size_t N>
+	int sendBuffer(unsigned int bufferId, T (&buffer)[N]) { return 0; }
+	template<typename T>
+	int sendBuffer(unsigned int bufferId, std::vector<T>& buffer) { return 0; }
+	template<typename T>
+	int sendBuffer(unsigned int bufferId, T value) { return 0; }
+
+	// Destructor
+	~Gui() {}
+
+private:
+	std::string projectName_;
+	std::vector<DataBuffer> buffers_;
+};
\ No newline at end of file
@@ -0,0 +1,51 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// GuiController.h: stand-in for the Bela slider GUI. Sliders hold their
+// default value unless it is overridden on the command line with
+// --slider INDEX=VALUE or --slider "NAME=VALUE".
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+class Gui;
+
+class GuiController {
+public:
+	// Constructor
+	GuiController() {}
+
+	// Attach the controller to a GUI
+	int setup(Gui *gui, std::string name);
+
+	// Add a slider. Returns its index.
+	int addSlider(std::string name, float value, float min, float max, float step);
+
+	// Methods for getting and setting slider values
+	float getSliderValue(int sliderIndex);
+	int setSliderValue(int sliderIndex, float value);
+	unsigned int getNumSliders() { return sliders_.size(); }
+
+	// Destructor
+	~GuiController() {}
+
+private:
+	struct Slider {
+		std::string name;
+		float value, min, max, step;
+	};
+
+	std::string name_;
+	std::vector<Slider> sliders_;
+};
\ No newline at end of file
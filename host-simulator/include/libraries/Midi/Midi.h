@@ -0,0 +1,105 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// Midi.h: stand-in for the Bela MIDI library. Instead of a hardware port,
+// messages come from the Standard MIDI File given to the simulator with
+// --midi, and arrive at the start of the block in which they are due.
+// Every port that is opened for reading receives the same messages.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+typedef unsigned char midi_byte_t;
+
+enum MidiMessageType {
+	kmmNoteOff = 0,
+	kmmNoteOn,
+	kmmPolyphonicKeyPressure,
+	kmmControlChange,
+	kmmProgramChange,
+	kmmChannelPressure,
+	kmmPitchBend,
+	kmmSystem,
+	kmmNone,
+	kmmAny
+};
+
+// A single MIDI channel message: note on/off, control change, pitch bend...
+class MidiChannelMessage {
+public:
+	MidiChannelMessage() {}
+	MidiChannelMessage(midi_byte_t statusByte, midi_byte_t data0, midi_byte_t data1);
+
+	MidiMessageType getType() { return type_; }
+	int getChannel() { return channel_; }
+	unsigned int getNumDataBytes();
+	midi_byte_t getDataByte(unsigned int index) { return dataBytes_[index]; }
+	midi_byte_t getStatusByte() { return statusByte_; }
+
+	// Print the message to the console
+	void prettyPrint();
+
+private:
+	MidiMessageType type_ = kmmNone;
+	int channel_ = 0;
+	midi_byte_t statusByte_ = 0;
+	midi_byte_t dataBytes_[2] = {0, 0};
+};
+
+// Queue of messages which render() can poll
+class MidiParser {
+public:
+	unsigned int numAvailableMessages() { return messages_.size(); }
+	MidiChannelMessage getNextChannelMessage();
+
+	// Used by the simulator to deliver a message
+	void push(const MidiChannelMessage& message) { messages_.push_back(message); }
+
+private:
+	std::deque<MidiChannelMessage> messages_;
+};
+
+class Midi {
+public:
+	// Constructor
+	Midi() {}
+
+	// Open a port. Returns 1 on success, as on Bela.
+	int readFrom(const char *port);
+	int writeTo(const char *port);
+
+	// Enable the parser so that messages can be retrieved from getParser()
+	int enableParser(bool enable);
+	MidiParser *getParser() { return parserEnabled_ ? &parser_ : nullptr; }
+
+	// Call a function for every message instead of queueing it
+	void setParserCallback(void (*callback)(MidiChannelMessage, void*), void *arg = nullptr);
+
+	// Sending MIDI is accepted and ignored
+	int writeOutput(midi_byte_t byte) { return 1; }
+	int writeOutput(midi_byte_t *bytes, unsigned int length) { return length; }
+
+	// Used by the simulator to deliver a message to this port
+	void deliver(const MidiChannelMessage& message);
+
+	// Destructor
+	~Midi();
+
+private:
+	bool reading_ = false;
+	bool parserEnabled_ = false;
+	MidiParser parser_;
+	void (*callback_)(MidiChannelMessage, void*) = nullptr;
+	void *callbackArg_ = nullptr;
+};
\ No newline at end of file
@@ -0,0 +1,43 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// Scope.h: stand-in for the Bela oscilloscope. There is no browser to draw
+// in, so if the simulator was started with --scope, everything logged is
+// saved to a WAV file with one channel per scope channel instead.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+class Scope {
+public:
+	// Constructor
+	Scope() {}
+
+	// Set the number of channels and the rate at which log() will be called
+	void setup(unsigned int numChannels, float sampleRate);
+
+	// Log one frame of values, one per channel
+	void log(double chn1, ...);
+	void log(const float *values);
+
+	// Destructor: writes the file if logging was enabled
+	~Scope();
+
+private:
+	unsigned int numChannels_ = 0;		// Number of channels set up
+	float sampleRate_ = 0;				// Rate at which frames are logged
+	bool enabled_ = false;				// Whether we are saving what is logged
+	std::string filename_;				// File to save to
+	std::vector<float> data_;			// Interleaved frames logged so far
+};
\ No newline at end of file
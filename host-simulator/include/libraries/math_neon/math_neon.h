@@ -0,0 +1,39 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// math_neon.h: the NEON approximations of the maths functions used on Bela,
+// mapped to the standard library versions on other computers.
+
+#pragma once
+
+#include <cmath>
+
+static inline float sinf_neon(float x) { return sinf(x); }
+static inline float cosf_neon(float x) { return cosf(x); }
+static inline float tanf_neon(float x) { return tanf(x); }
+static inline float asinf_neon(float x) { return asinf(x); }
+static inline float acosf_neon(float x) { return acosf(x); }
+static inline float atanf_neon(float x) { return atanf(x); }
+static inline float atan2f_neon(float y, float x) { return atan2f(y, x); }
+static inline float sinhf_neon(float x) { return sinhf(x); }
+static inline float coshf_neon(float x) { return coshf(x); }
+static inline float tanhf_neon(float x) { return tanhf(x); }
+static inline float expf_neon(float x) { return expf(x); }
+static inline float logf_neon(float x) { return logf(x); }
+static inline float log10f_neon(float x) { return log10f(x); }
+static inline float powf_neon(float x, float n) { return powf(x, n); }
+static inline float sqrtf_neon(float x) { return sqrtf(x); }
+static inline float invsqrtf_neon(float x) { return 1.0f / sqrtf(x); }
+static inline float floorf_neon(float x) { return floorf(x); }
+static inline float ceilf_neon(float x) { return ceilf(x); }
+static inline float fabsf_neon(float x) { return fabsf(x); }
+static inline float fmodf_neon(float x, float y) { return fmodf(x, y); }
\ No newline at end of file
@@ -0,0 +1,264 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// AudioFile.cpp: minimal WAV file reading and writing
+
+#include <libraries/AudioFile/AudioFile.h>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+// Format codes in the WAV header
+const uint16_t kFormatPcm = 1;
+const uint16_t kFormatFloat = 3;
+const uint16_t kFormatExtensible = 0xFFFE;
+
+struct WavInfo {
+	uint16_t format = 0;
+	uint16_t channels = 0;
+	uint32_t sampleRate = 0;
+	uint16_t bitsPerSample = 0;
+	long dataOffset = 0;		// Position of the first sample in the file
+	uint32_t dataSize = 0;		// Bytes of sample data
+
+	unsigned int bytesPerFrame() const { return channels * (bitsPerSample / 8); }
+	unsigned int frames() const { return bytesPerFrame() ? dataSize / bytesPerFrame() : 0; }
+};
+
+uint32_t readLittleEndian(const unsigned char *bytes, int count)
+{
+	uint32_t value = 0;
+	for(int i = count - 1; i >= 0; i--)
+		value = (value << 8) | bytes[i];
+	return value;
+}
+
+// Read the header of a WAV file, leaving the file positioned at the data
+bool readHeader(FILE *file, WavInfo& info)
+{
+	unsigned char header[12];
+	if(fread(header, 1, 12, file) != 12)
+		return false;
+	if(memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0)
+		return false;
+
+	// Walk through the chunks looking for "fmt " and "data"
+	bool foundFormat = false;
+	unsigned char chunkHeader[8];
+	while(fread(chunkHeader, 1, 8, file) == 8) {
+		uint32_t chunkSize = readLittleEndian(chunkHeader + 4, 4);
+
+		if(memcmp(chunkHeader, "fmt ", 4) == 0) {
+			unsigned char format[40] = {0};
+			uint32_t toRead = chunkSize < sizeof(format) ? chunkSize : sizeof(format);
+			if(fread(format, 1, toRead, file) != toRead)
+				return false;
+			info.format = readLittleEndian(format, 2);
+			info.channels = readLittleEndian(format + 2, 2);
+			info.sampleRate = readLittleEndian(format + 4, 4);
+			info.bitsPerSample = readLittleEndian(format + 14, 2);
+
+			// The real format of an extensible file is at the start of the GUID
+			if(info.format == kFormatExtensible && toRead >= 26)
+				info.format = readLittleEndian(format + 24, 2);
+
+			fseek(file, chunkSize - toRead + (chunkSize & 1), SEEK_CUR);
+			foundFormat = true;
+		}
+		else if(memcmp(chunkHeader, "data", 4) == 0) {
+			info.dataOffset = ftell(file);
+			info.dataSize = chunkSize;
+			return foundFormat;
+		}
+		else {
+			// Skip any other chunk, which are padded to an even length
+			fseek(file, chunkSize + (chunkSize & 1), SEEK_CUR);
+		}
+	}
+	return false;
+}
+
+// Convert one sample from the file to a float between -1 and 1
+float decodeSample(const unsigned char *bytes, const WavInfo& info)
+{
+	if(info.format == kFormatFloat) {
+		if(info.bitsPerSample == 32) {
+			uint32_t bits = readLittleEndian(bytes, 4);
+			float value;
+			memcpy(&value, &bits, 4);
+			return value;
+		}
+		if(info.bitsPerSample == 64) {
+			uint64_t bits = readLittleEndian(bytes, 4) | ((uint64_t)readLittleEndian(bytes + 4, 4) << 32);
+			double value;
+			memcpy(&value, &bits, 8);
+			return (float)value;
+		}
+		return 0;
+	}
+
+	switch(info.bitsPerSample) {
+		case 8:
+			return ((int)bytes[0] - 128) / 128.0f;
+		case 16:
+			return (int16_t)readLittleEndian(bytes, 2) / 32768.0f;
+		case 24:
+			return ((int32_t)(readLittleEndian(bytes, 3) << 8) >> 8) / 8388608.0f;
+		case 32:
+			return (int32_t)readLittleEndian(bytes, 4) / 2147483648.0f;
+		default:
+			return 0;
+	}
+}
+
+bool getInfo(const std::string& filename, WavInfo& info)
+{
+	FILE *file = fopen(filename.c_str(), "rb");
+	if(file == nullptr)
+		return false;
+	bool ok = readHeader(file, info);
+	fclose(file);
+	return ok;
+}
+
+void writeLittleEndian(FILE *file, uint32_t value, int count)
+{
+	for(int i = 0; i < count; i++) {
+		fputc(value & 0xFF, file);
+		value >>= 8;
+	}
+}
+
+}
+
+int AudioFileUtilities::getNumChannels(const std::string& filename)
+{
+	WavInfo info;
+	return getInfo(filename, info) ? info.channels : -1;
+}
+
+int AudioFileUtilities::getNumFrames(const std::string& filename)
+{
+	WavInfo info;
+	return getInfo(filename, info) ? info.frames() : -1;
+}
+
+int AudioFileUtilities::getSampleRate(const std::string& filename)
+{
+	WavInfo info;
+	return getInfo(filename, info) ? info.sampleRate : -1;
+}
+
+// Load every channel of a file into its own buffer
+std::vector<std::vector<float> > AudioFileUtilities::load(const std::string& filename, int maxCount, unsigned int start)
+{
+	std::vector<std::vector<float> > out;
+
+	FILE *file = fopen(filename.c_str(), "rb");
+	if(file == nullptr)
+		return out;
+
+	WavInfo info;
+	if(!readHeader(file, info) || info.channels == 0 ||
+	   (info.format != kFormatPcm && info.format != kFormatFloat)) {
+		fclose(file);
+		return out;
+	}
+
+	// Work out which frames to read
+	unsigned int frames = info.frames();
+	if(start >= frames)
+		frames = 0;
+	else
+		frames -= start;
+	if(maxCount > 0 && (unsigned int)maxCount < frames)
+		frames = maxCount;
+
+	std::vector<unsigned char> bytes((size_t)frames * info.bytesPerFrame());
+	fseek(file, info.dataOffset + (long)start * info.bytesPerFrame(), SEEK_SET);
+	size_t bytesRead = fread(bytes.data(), 1, bytes.size(), file);
+	fclose(file);
+	frames = bytesRead / info.bytesPerFrame();
+
+	// Deinterleave into one buffer per channel
+	unsigned int bytesPerSample = info.bitsPerSample / 8;
+	out.resize(info.channels);
+	for(unsigned int channel = 0; channel < info.channels; channel++) {
+		out[channel].resize(frames);
+		for(unsigned int n = 0; n < frames; n++) {
+			const unsigned char *sample = &bytes[(size_t)n * info.bytesPerFrame() + channel * bytesPerSample];
+			out[channel][n] = decodeSample(sample, info);
+		}
+	}
+	return out;
+}
+
+// Load the first channel of a file
+std::vector<float> AudioFileUtilities::loadMono(const std::string& filename)
+{
+	std::vector<std::vector<float> > channels = load(filename);
+	if(channels.empty())
+		return std::vector<float>();
+	return channels[0];
+}
+
+// Write interleaved data as a 32-bit floating point WAV file
+int AudioFileUtilities::write(const std::string& filename, float *buf, unsigned int channels,
+							  unsigned int frames, unsigned int sampleRate)
+{
+	FILE *file = fopen(filename.c_str(), "wb");
+	if(file == nullptr)
+		return -1;
+
+	uint32_t dataSize = frames * channels * 4;
+
+	fwrite("RIFF", 1, 4, file);
+	writeLittleEndian(file, 36 + dataSize, 4);
+	fwrite("WAVE", 1, 4, file);
+
+	fwrite("fmt ", 1, 4, file);
+	writeLittleEndian(file, 16, 4);
+	writeLittleEndian(file, kFormatFloat, 2);
+	writeLittleEndian(file, channels, 2);
+	writeLittleEndian(file, sampleRate, 4);
+	writeLittleEndian(file, sampleRate * channels * 4, 4);
+	writeLittleEndian(file, channels * 4, 2);
+	writeLittleEndian(file, 32, 2);
+
+	fwrite("data", 1, 4, file);
+	writeLittleEndian(file, dataSize, 4);
+	for(size_t n = 0; n < (size_t)frames * channels; n++) {
+		uint32_t bits;
+		memcpy(&bits, &buf[n], 4);
+		writeLittleEndian(file, bits, 4);
+	}
+
+	fclose(file);
+	return 0;
+}
+
+// Write one buffer per channel
+int AudioFileUtilities::write(const std::string& filename, const std::vector<std::vector<float> >& dataIn,
+							  unsigned int sampleRate)
+{
+	unsigned int channels = dataIn.size();
+	unsigned int frames = channels ? dataIn[0].size() : 0;
+
+	std::vector<float> interleaved((size_t)frames * channels);
+	for(unsigned int channel = 0; channel < channels; channel++) {
+		for(unsigned int n = 0; n < frames && n < dataIn[channel].size(); n++)
+			interleaved[(size_t)n * channels + channel] = dataIn[channel][n];
+	}
+	return write(filename, interleaved.data(), channels, frames, sampleRate);
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// AuxiliaryTasks.cpp: each auxiliary task is a real thread which sleeps until
+// it is scheduled. Requests made while the task is busy are queued, up to a
+// limit, after which Bela_scheduleAuxiliaryTask() returns an error.
+
+#include <Bela.h>
+#include <pthread.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "Simulator.h"
+
+namespace {
+
+const unsigned int kMaxQueuedRequests = 16;
+
+struct Task {
+	void (*callback)(void*);
+	void *arg;
+	std::string name;
+	int priority;
+
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable wake;		// Signalled when there is a request or on exit
+	std::condition_variable idle;		// Signalled when the task has nothing left to do
+	unsigned int pending = 0;			// Requests not yet started
+	bool running = false;				// Whether the callback is running now
+	bool stop = false;					// Set when the task should exit
+};
+
+std::vector<Task*> gTasks;
+std::mutex gTasksMutex;
+
+// Loop which runs in each task's thread
+void taskLoop(Task *task)
+{
+	// Name the thread so it can be found in debuggers and top
+	std::string threadName = task->name.substr(0, 15);
+	pthread_setname_np(pthread_self(), threadName.c_str());
+
+	std::unique_lock<std::mutex> lock(task->mutex);
+	while(true) {
+		task->wake.wait(lock, [task] { return task->pending > 0 || task->stop; });
+		if(task->stop)
+			break;
+
+		task->pending--;
+		task->running = true;
+		lock.unlock();
+		task->callback(task->arg);
+		lock.lock();
+		task->running = false;
+
+		if(task->pending == 0)
+			task->idle.notify_all();
+	}
+	task->running = false;
+	task->idle.notify_all();
+}
+
+}
+
+// Create a task. The priority is recorded but not used: the host scheduler
+// decides when each thread runs.
+AuxiliaryTask Bela_createAuxiliaryTask(void (*callback)(void*), int priority, const char *name, void *arg)
+{
+	Task *task = new Task;
+	task->callback = callback;
+	task->arg = arg;
+	task->name = name;
+	task->priority = priority;
+	task->thread = std::thread(taskLoop, task);
+
+	std::lock_guard<std::mutex> guard(gTasksMutex);
+	gTasks.push_back(task);
+	return task;
+}
+
+// Ask for a task to run. Returns 0 on success.
+int Bela_scheduleAuxiliaryTask(AuxiliaryTask auxiliaryTask)
+{
+	Task *task = static_cast<Task*>(auxiliaryTask);
+	if(task == nullptr)
+		return -1;
+
+	{
+		std::lock_guard<std::mutex> guard(task->mutex);
+		if(task->stop || task->pending >= kMaxQueuedRequests)
+			return -1;
+		task->pending++;
+	}
+	task->wake.notify_one();
+	return 0;
+}
+
+// Stop all the tasks and wait for their threads to finish
+void Bela_deleteAllAuxiliaryTasks()
+{
+	std::lock_guard<std::mutex> guard(gTasksMutex);
+	for(Task *task : gTasks) {
+		{
+			std::lock_guard<std::mutex> taskGuard(task->mutex);
+			task->stop = true;
+		}
+		task->wake.notify_one();
+	}
+	for(Task *task : gTasks) {
+		task->thread.join();
+		delete task;
+	}
+	gTasks.clear();
+}
+
+// Wait until every task has finished all of its requests. Used for
+// repeatable offline rendering. One task may schedule another, so keep
+// going until we find them all idle.
+void Simulator_waitForAuxiliaryTasks()
+{
+	std::lock_guard<std::mutex> guard(gTasksMutex);
+	bool waited = true;
+	while(waited) {
+		waited = false;
+		for(Task *task : gTasks) {
+			std::unique_lock<std::mutex> lock(task->mutex);
+			if((task->pending > 0 || task->running) && !task->stop) {
+				task->idle.wait(lock, [task] { return (task->pending == 0 && !task->running) || task->stop; });
+				waited = true;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// Fft.cpp: iterative radix-2 FFT
+
+#include <libraries/Fft/Fft.h>
+
+// Prepare for transforms of the given length
+int Fft::setup(unsigned int length)
+{
+	if(!isPowerOfTwo(length))
+		return -1;
+
+	length_ = length;
+	timeDomain_.assign(length, 0);
+	frequencyDomainReal_.assign(length, 0);
+	frequencyDomainImag_.assign(length, 0);
+	workReal_.assign(length, 0);
+	workImag_.assign(length, 0);
+
+	// Twiddle factors for the largest stage; smaller stages use every Nth one
+	cosTable_.resize(length / 2);
+	sinTable_.resize(length / 2);
+	for(unsigned int n = 0; n < length / 2; n++) {
+		cosTable_[n] = cos(2.0 * M_PI * n / length);
+		sinTable_[n] = -sin(2.0 * M_PI * n / length);
+	}
+
+	// Bit-reversed order of the input
+	unsigned int bits = 0;
+	while((1u << bits) < length)
+		bits++;
+	bitReverse_.resize(length);
+	for(unsigned int n = 0; n < length; n++) {
+		unsigned int reversed = 0;
+		for(unsigned int b = 0; b < bits; b++) {
+			if(n & (1u << b))
+				reversed |= 1u << (bits - 1 - b);
+		}
+		bitReverse_[n] = reversed;
+	}
+	return 0;
+}
+
+void Fft::cleanup()
+{
+	length_ = 0;
+}
+
+// Forward transform of the data in td()
+void Fft::fft()
+{
+	for(unsigned int n = 0; n < length_; n++) {
+		workReal_[bitReverse_[n]] = timeDomain_[n];
+		workImag_[bitReverse_[n]] = 0;
+	}
+	transform(false);
+	for(unsigned int n = 0; n < length_; n++) {
+		frequencyDomainReal_[n] = workReal_[n];
+		frequencyDomainImag_[n] = workImag_[n];
+	}
+}
+
+void Fft::fft(const std::vector<float>& input)
+{
+	for(unsigned int n = 0; n < length_; n++)
+		timeDomain_[n] = (n < input.size()) ? input[n] : 0;
+	fft();
+}
+
+// Inverse transform of the data in fdr() and fdi(). Only the lower half of
+// the spectrum is used, as it is on Bela.
+void Fft::ifft()
+{
+	unsigned int half = length_ / 2;
+	for(unsigned int n = 0; n < length_; n++) {
+		float real, imag;
+		if(n <= half) {
+			real = frequencyDomainReal_[n];
+			imag = frequencyDomainImag_[n];
+		}
+		else {
+			real = frequencyDomainReal_[length_ - n];
+			imag = -frequencyDomainImag_[length_ - n];
+		}
+		workReal_[bitReverse_[n]] = real;
+		workImag_[bitReverse_[n]] = imag;
+	}
+	transform(true);
+
+	float scale = 1.0f / length_;
+	for(unsigned int n = 0; n < length_; n++)
+		timeDomain_[n] = workReal_[n] * scale;
+}
+
+void Fft::ifft(const std::vector<float>& reInput, const std::vector<float>& imInput)
+{
+	for(unsigned int n = 0; n < length_; n++) {
+		frequencyDomainReal_[n] = (n < reInput.size()) ? reInput[n] : 0;
+		frequencyDomainImag_[n] = (n < imInput.size()) ? imInput[n] : 0;
+	}
+	ifft();
+}
+
+// Butterfly stages on the working buffers, which are already in bit-reversed order
+void Fft::transform(bool inverse)
+{
+	float direction = inverse ? -1.0f : 1.0f;
+
+	for(unsigned int size = 2; size <= length_; size *= 2) {
+		unsigned int halfSize = size / 2;
+		unsigned int tableStep = length_ / size;
+
+		for(unsigned int start = 0; start < length_; start += size) {
+			for(unsigned int k = 0; k < halfSize; k++) {
+				float wr = cosTable_[k * tableStep];
+				float wi = direction * sinTable_[k * tableStep];
+
+				unsigned int even = start + k;
+				unsigned int odd = even + halfSize;
+				float tr = workReal_[odd] * wr - workImag_[odd] * wi;
+				float ti = workReal_[odd] * wi + workImag_[odd] * wr;
+
+				workReal_[odd] = workReal_[even] - tr;
+				workImag_[odd] = workImag_[even] - ti;
+				workReal_[even] += tr;
+				workImag_[even] += ti;
+			}
+		}
+	}
+}
+
+unsigned int Fft::roundUpToPowerOfTwo(unsigned int n)
+{
+	unsigned int result = 1;
+	while(result < n)
+		result *= 2;
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// Gui.cpp: GUI and slider controller without a browser
+
+#include <Bela.h>
+#include <libraries/Gui/Gui.h>
+#include <libraries/GuiController/GuiController.h>
+#include <cstdlib>
+#include "Simulator.h"
+
+// DataBuffer
+
+DataBuffer::DataBuffer(char type, unsigned int size)
+{
+	type_ = type;
+	capacity_ = size;
+
+	// Allocate enough bytes for the largest type
+	buffer_.assign(size * 4, 0);
+}
+
+// Gui
+
+int Gui::setup(std::string projectName, unsigned int port, std::string address)
+{
+	projectName_ = projectName;
+	return 0;
+}
+
+int Gui::setBuffer(char bufferType, unsigned int size)
+{
+	buffers_.push_back(DataBuffer(bufferType, size));
+	return buffers_.size() - 1;
+}
+
+// GuiController
+
+int GuiController::setup(Gui *gui, std::string name)
+{
+	name_ = name;
+	return 0;
+}
+
+// Add a slider, taking its value from the command line if it was given there
+int GuiController::addSlider(std::string name, float value, float min, float max, float step)
+{
+	int index = sliders_.size();
+
+	for(auto& setting : gSimulatorSettings.sliders) {
+		char *end;
+		long settingIndex = strtol(setting.first.c_str(), &end, 10);
+		bool matchesIndex = (*end == 0 && settingIndex == index);
+		if(matchesIndex || setting.first == name) {
+			value = setting.second;
+			rt_printf("Slider '%s' set to %f\n", name.c_str(), value);
+		}
+	}
+
+	Slider slider = {name, value, min, max, step};
+	sliders_.push_back(slider);
+	return index;
+}
+
+float GuiController::getSliderValue(int sliderIndex)
+{
+	if(sliderIndex < 0 || sliderIndex >= (int)sliders_.size())
+		return 0;
+	return sliders_[sliderIndex].value;
+}
+
+int GuiController::setSliderValue(int sliderIndex, float value)
+{
+	if(sliderIndex < 0 || sliderIndex >= (int)sliders_.size())
+		return -1;
+	sliders_[sliderIndex].value = value;
+	return 0;
+}
\ No newline at end of file
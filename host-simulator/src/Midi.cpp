@@ -0,0 +1,308 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// Midi.cpp: MIDI messages read from a Standard MIDI File instead of a port
+
+#include <Bela.h>
+#include <libraries/Midi/Midi.h>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+#include "Simulator.h"
+
+namespace {
+
+// A message from the file, with its time in seconds
+struct TimedMessage {
+	double time;
+	MidiChannelMessage message;
+};
+
+std::vector<TimedMessage> gMessages;		// All the messages, sorted by time
+unsigned int gNextMessage = 0;				// Next message to deliver
+std::vector<Midi*> gPorts;					// Ports which are reading
+
+// A MIDI event before we know its time in seconds
+struct TickEvent {
+	uint64_t tick;
+	unsigned int order;			// Position in the file, to keep simultaneous events in order
+	bool isTempo;
+	uint32_t tempo;				// Microseconds per quarter note, for tempo events
+	midi_byte_t status, data0, data1;
+};
+
+uint32_t readBigEndian(const unsigned char *bytes, int count)
+{
+	uint32_t value = 0;
+	for(int i = 0; i < count; i++)
+		value = (value << 8) | bytes[i];
+	return value;
+}
+
+// Read a variable-length quantity, advancing the position
+uint32_t readVariableLength(const std::vector<unsigned char>& data, size_t& pos, size_t end)
+{
+	uint32_t value = 0;
+	while(pos < end) {
+		unsigned char byte = data[pos++];
+		value = (value << 7) | (byte & 0x7F);
+		if(!(byte & 0x80))
+			break;
+	}
+	return value;
+}
+
+// Number of data bytes which follow each type of channel status byte
+int dataBytesForStatus(midi_byte_t status)
+{
+	switch(status & 0xF0) {
+		case 0xC0:
+		case 0xD0:
+			return 1;
+		default:
+			return 2;
+	}
+}
+
+// Parse one track, adding its events to the list
+bool parseTrack(const std::vector<unsigned char>& data, size_t pos, size_t end,
+				std::vector<TickEvent>& events)
+{
+	uint64_t tick = 0;
+	midi_byte_t runningStatus = 0;
+
+	while(pos < end) {
+		tick += readVariableLength(data, pos, end);
+		if(pos >= end)
+			return false;
+
+		midi_byte_t status = data[pos];
+		if(status == 0xFF) {
+			// Meta event: we only care about tempo
+			if(pos + 2 > end)
+				return false;
+			midi_byte_t type = data[pos + 1];
+			pos += 2;
+			uint32_t length = readVariableLength(data, pos, end);
+			if(type == 0x51 && length == 3 && pos + 3 <= end) {
+				TickEvent event = {tick, (unsigned int)events.size(), true,
+								   readBigEndian(&data[pos], 3), 0, 0, 0};
+				events.push_back(event);
+			}
+			if(type == 0x2F)
+				return true;	// End of track
+			pos += length;
+		}
+		else if(status == 0xF0 || status == 0xF7) {
+			// System exclusive: skip it
+			pos++;
+			uint32_t length = readVariableLength(data, pos, end);
+			pos += length;
+		}
+		else {
+			// Channel message, possibly using the previous status byte
+			if(status & 0x80) {
+				runningStatus = status;
+				pos++;
+			}
+			else if(runningStatus == 0) {
+				return false;
+			}
+			int count = dataBytesForStatus(runningStatus);
+			if(pos + count > end)
+				return false;
+			TickEvent event = {tick, (unsigned int)events.size(), false, 0, runningStatus,
+							   data[pos], (midi_byte_t)(count > 1 ? data[pos + 1] : 0)};
+			events.push_back(event);
+			pos += count;
+		}
+	}
+	return true;
+}
+
+}
+
+// Load a Standard MIDI File (format 0 or 1) and convert the times to seconds
+bool Simulator_loadMidiFile(const std::string& filename)
+{
+	FILE *file = fopen(filename.c_str(), "rb");
+	if(file == nullptr)
+		return false;
+	std::vector<unsigned char> data;
+	unsigned char buffer[4096];
+	size_t count;
+	while((count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+		data.insert(data.end(), buffer, buffer + count);
+	fclose(file);
+
+	// Header chunk
+	if(data.size() < 14 || std::string(data.begin(), data.begin() + 4) != "MThd")
+		return false;
+	uint32_t headerLength = readBigEndian(&data[4], 4);
+	unsigned int numTracks = readBigEndian(&data[10], 2);
+	uint16_t division = readBigEndian(&data[12], 2);
+
+	// Collect the events from every track
+	std::vector<TickEvent> events;
+	size_t pos = 8 + headerLength;
+	for(unsigned int track = 0; track < numTracks && pos + 8 <= data.size(); track++) {
+		uint32_t trackLength = readBigEndian(&data[pos + 4], 4);
+		size_t start = pos + 8;
+		size_t end = std::min(start + trackLength, data.size());
+		if(std::string(data.begin() + pos, data.begin() + pos + 4) == "MTrk") {
+			if(!parseTrack(data, start, end, events))
+				return false;
+		}
+		pos = end;
+	}
+
+	std::stable_sort(events.begin(), events.end(), [](const TickEvent& a, const TickEvent& b) {
+		return a.tick < b.tick;
+	});
+
+	// Convert ticks to seconds, following the tempo changes
+	double secondsPerTick;
+	bool smpte = (division & 0x8000) != 0;
+	if(smpte) {
+		int framesPerSecond = -(int8_t)(division >> 8);
+		secondsPerTick = 1.0 / (framesPerSecond * (division & 0xFF));
+	}
+	else {
+		secondsPerTick = 0.5 / division;		// 120bpm until told otherwise
+	}
+
+	gMessages.clear();
+	gNextMessage = 0;
+	double time = 0;
+	uint64_t lastTick = 0;
+	for(const TickEvent& event : events) {
+		time += (event.tick - lastTick) * secondsPerTick;
+		lastTick = event.tick;
+		if(event.isTempo) {
+			if(!smpte)
+				secondsPerTick = event.tempo / 1000000.0 / division;
+		}
+		else {
+			TimedMessage message = {time, MidiChannelMessage(event.status, event.data0, event.data1)};
+			gMessages.push_back(message);
+		}
+	}
+
+	rt_printf("Loaded %u MIDI messages from '%s' (%.1f seconds)\n", (unsigned int)gMessages.size(),
+			  filename.c_str(), gMessages.empty() ? 0.0 : gMessages.back().time);
+	return true;
+}
+
+// Deliver every message due before the given time to all the open ports
+void Simulator_deliverMidi(double untilTime)
+{
+	while(gNextMessage < gMessages.size() && gMessages[gNextMessage].time < untilTime) {
+		for(Midi *port : gPorts)
+			port->deliver(gMessages[gNextMessage].message);
+		gNextMessage++;
+	}
+}
+
+void Simulator_registerMidi(Midi *midi)
+{
+	if(std::find(gPorts.begin(), gPorts.end(), midi) == gPorts.end())
+		gPorts.push_back(midi);
+}
+
+void Simulator_unregisterMidi(Midi *midi)
+{
+	gPorts.erase(std::remove(gPorts.begin(), gPorts.end(), midi), gPorts.end());
+}
+
+// MidiChannelMessage
+
+MidiChannelMessage::MidiChannelMessage(midi_byte_t statusByte, midi_byte_t data0, midi_byte_t data1)
+{
+	statusByte_ = statusByte;
+	channel_ = statusByte & 0x0F;
+	type_ = (MidiMessageType)((statusByte >> 4) - 8);
+	dataBytes_[0] = data0;
+	dataBytes_[1] = data1;
+}
+
+unsigned int MidiChannelMessage::getNumDataBytes()
+{
+	return dataBytesForStatus(statusByte_);
+}
+
+void MidiChannelMessage::prettyPrint()
+{
+	static const char *typeNames[] = {"note off", "note on", "poly aftertouch", "control change",
+									  "program change", "channel aftertouch", "pitch bend", "system"};
+	const char *name = (type_ >= kmmNoteOff && type_ <= kmmSystem) ? typeNames[type_] : "unknown";
+
+	rt_printf("type: %s, channel: %d, ", name, channel_);
+	for(unsigned int n = 0; n < getNumDataBytes(); n++)
+		rt_printf("byte %u: %d, ", n, dataBytes_[n]);
+	rt_printf("\n");
+}
+
+// MidiParser
+
+MidiChannelMessage MidiParser::getNextChannelMessage()
+{
+	if(messages_.empty())
+		return MidiChannelMessage();
+	MidiChannelMessage message = messages_.front();
+	messages_.pop_front();
+	return message;
+}
+
+// Midi
+
+int Midi::readFrom(const char *port)
+{
+	reading_ = true;
+	Simulator_registerMidi(this);
+	return 1;
+}
+
+int Midi::writeTo(const char *port)
+{
+	return 1;
+}
+
+int Midi::enableParser(bool enable)
+{
+	parserEnabled_ = enable;
+	return 0;
+}
+
+void Midi::setParserCallback(void (*callback)(MidiChannelMessage, void*), void *arg)
+{
+	callback_ = callback;
+	callbackArg_ = arg;
+	parserEnabled_ = true;
+}
+
+// Pass the message to the callback if there is one, as on Bela, or
+// otherwise queue it for render()
+void Midi::deliver(const MidiChannelMessage& message)
+{
+	if(!parserEnabled_)
+		return;
+	if(callback_ != nullptr)
+		callback_(message, callbackArg_);
+	else
+		parser_.push(message);
+}
+
+Midi::~Midi()
+{
+	if(reading_)
+		Simulator_unregisterMidi(this);
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// Scope.cpp: save what is logged to the scope in a WAV file
+
+#include <Bela.h>
+#include <libraries/Scope/Scope.h>
+#include <libraries/AudioFile/AudioFile.h>
+#include <cstdarg>
+#include "Simulator.h"
+
+void Scope::setup(unsigned int numChannels, float sampleRate)
+{
+	numChannels_ = numChannels;
+	sampleRate_ = sampleRate;
+	filename_ = gSimulatorSettings.scopeFilename;
+	enabled_ = (filename_ != "");
+
+	// Reserve space for the whole run so logging doesn't allocate in render()
+	if(enabled_) {
+		float duration = gSimulatorSettings.duration > 0 ? gSimulatorSettings.duration : 10.0;
+		data_.reserve((size_t)(duration * sampleRate + 1) * numChannels);
+	}
+}
+
+// Log one frame, passing each channel as a separate argument
+void Scope::log(double chn1, ...)
+{
+	if(!enabled_ || numChannels_ == 0)
+		return;
+
+	va_list args;
+	va_start(args, chn1);
+	data_.push_back(chn1);
+	for(unsigned int channel = 1; channel < numChannels_; channel++)
+		data_.push_back(va_arg(args, double));
+	va_end(args);
+}
+
+// Log one frame from an array holding a value for each channel
+void Scope::log(const float *values)
+{
+	if(!enabled_)
+		return;
+	data_.insert(data_.end(), values, values + numChannels_);
+}
+
+// Write the file at the end of the program
+Scope::~Scope()
+{
+	if(!enabled_ || numChannels_ == 0)
+		return;
+	AudioFileUtilities::write(filename_, data_.data(), numChannels_,
+							  data_.size() / numChannels_, sampleRate_);
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// Simulator.h: settings and functions shared between the parts of the
+// simulator. Projects don't include this file.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+
+class Midi;
+
+// A synthetic signal for an analog or digital input, parsed from e.g. "sine:0.5"
+struct SignalSpec {
+	enum Type {
+		kConstant = 0,	// value
+		kSine,			// frequency
+		kRamp,			// frequency
+		kNoise,			// (none)
+		kSquare,		// frequency
+		kPulse			// period, width
+	};
+
+	Type type = kConstant;
+	float a = 0;		// First parameter (value, frequency or period)
+	float b = 0;		// Second parameter (pulse width)
+};
+
+struct SimulatorSettings {
+	float sampleRate = 44100.0;					// Audio sample rate
+	unsigned int blockSize = 16;				// Audio frames per block
+	unsigned int audioInChannels = 2;
+	unsigned int audioOutChannels = 2;
+	unsigned int analogChannels = 8;			// 8 = half audio rate, 4 = audio rate, 2 = double
+	unsigned int digitalChannels = 16;
+	float duration = 0;							// Seconds to run for (0 = input length or 10s)
+	bool realTime = false;						// Pace the blocks to the clock
+	bool waitForAuxiliaryTasks = false;			// Finish all tasks at the end of each block
+
+	std::string projectName;
+	std::string inputFilename;					// Audio input
+	std::string outputFilename;					// Audio output
+	std::string analogOutputFilename;			// Analog output
+	std::string midiFilename;					// MIDI input
+	std::string scopeFilename;					// Where to save what is logged to the Scope
+
+	std::vector<std::pair<unsigned int, SignalSpec> > analogInputs;
+	std::vector<std::pair<unsigned int, SignalSpec> > digitalInputs;
+	std::vector<std::pair<std::string, float> > sliders;		// Name or index, value
+};
+
+extern SimulatorSettings gSimulatorSettings;
+
+// Auxiliary tasks
+void Simulator_waitForAuxiliaryTasks();
+
+// MIDI: load a file, then deliver messages up to a time in seconds
+bool Simulator_loadMidiFile(const std::string& filename);
+void Simulator_deliverMidi(double untilTime);
+void Simulator_registerMidi(Midi *midi);
+void Simulator_unregisterMidi(Midi *midi);
\ No newline at end of file
@@ -0,0 +1,437 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - host simulator
+*/
+
+// main.cpp: run a Bela project on an ordinary computer. Audio comes from a
+// WAV file, analog and digital inputs from synthetic signals and MIDI from a
+// MIDI file. setup(), render() and cleanup() are called just as on Bela, but
+// as fast as the computer allows unless --realtime is given.
+
+#include <Bela.h>
+#include <libraries/AudioFile/AudioFile.h>
+#include <getopt.h>
+#include <signal.h>
+#include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "Simulator.h"
+
+#ifndef PROJECT_NAME
+#define PROJECT_NAME "project"
+#endif
+
+int volatile gShouldStop = 0;
+SimulatorSettings gSimulatorSettings;
+
+int rt_printf(const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int ret = vprintf(format, args);
+	va_end(args);
+	return ret;
+}
+
+int rt_fprintf(FILE *stream, const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int ret = vfprintf(stream, format, args);
+	va_end(args);
+	return ret;
+}
+
+void Bela_requestStop()
+{
+	gShouldStop = 1;
+}
+
+namespace {
+
+void interruptHandler(int)
+{
+	gShouldStop = 1;
+}
+
+void usage(const char *program)
+{
+	fprintf(stderr,
+		"Usage: %s [options]\n"
+		"  --input FILE           WAV file for the audio inputs\n"
+		"  --output FILE          save the audio outputs to a WAV file\n"
+		"  --analog-output FILE   save the analog outputs to a WAV file\n"
+		"  --scope FILE           save everything logged to the Scope to a WAV file\n"
+		"  --midi FILE            Standard MIDI File to send to the MIDI inputs\n"
+		"  --analog CH=SIGNAL     signal for analog input CH: const:V, sine:HZ, ramp:HZ or noise\n"
+		"  --digital CH=SIGNAL    signal for digital input CH: const:V, square:HZ or pulse:PERIOD:WIDTH\n"
+		"  --slider ID=VALUE      set a GuiController slider by index or name\n"
+		"  --duration SECONDS     how long to run (default: length of input, or 10s)\n"
+		"  --block-size FRAMES    audio frames per block (default 16)\n"
+		"  --sample-rate HZ       audio sample rate (default 44100)\n"
+		"  --audio-channels N     audio inputs and outputs (default 2)\n"
+		"  --analog-channels N    8, 4 or 2 analog channels, at 1/2, 1 or 2 times the audio rate (default 8)\n"
+		"  --realtime             run at the speed of the audio clock\n"
+		"  --no-wait-aux          don't wait for auxiliary tasks at the end of each block\n"
+		"  --project-name NAME    name passed to the project in context->projectName\n",
+		program);
+}
+
+// Parse a signal like "sine:0.5" or "pulse:1:0.1"
+bool parseSignal(const char *text, SignalSpec& spec)
+{
+	char type[16] = {0};
+	float a = 0, b = 0;
+	int fields = sscanf(text, "%15[a-z]:%f:%f", type, &a, &b);
+	if(fields < 1)
+		return false;
+
+	if(!strcmp(type, "const"))
+		spec.type = SignalSpec::kConstant;
+	else if(!strcmp(type, "sine"))
+		spec.type = SignalSpec::kSine;
+	else if(!strcmp(type, "ramp"))
+		spec.type = SignalSpec::kRamp;
+	else if(!strcmp(type, "noise"))
+		spec.type = SignalSpec::kNoise;
+	else if(!strcmp(type, "square"))
+		spec.type = SignalSpec::kSquare;
+	else if(!strcmp(type, "pulse"))
+		spec.type = SignalSpec::kPulse;
+	else
+		return false;
+
+	spec.a = a;
+	spec.b = b;
+	return true;
+}
+
+// Parse "CH=SIGNAL" into a channel and a signal
+bool parseChannelSignal(const char *text, std::vector<std::pair<unsigned int, SignalSpec> >& list)
+{
+	const char *equals = strchr(text, '=');
+	if(equals == nullptr)
+		return false;
+	SignalSpec spec;
+	if(!parseSignal(equals + 1, spec))
+		return false;
+	list.push_back(std::make_pair((unsigned int)atoi(text), spec));
+	return true;
+}
+
+// Value of a synthetic signal at a given time in seconds
+float signalValue(const SignalSpec& spec, double time, uint32_t& noiseState)
+{
+	switch(spec.type) {
+		case SignalSpec::kConstant:
+			return spec.a;
+		case SignalSpec::kSine:
+			return 0.5 + 0.5 * sin(2.0 * M_PI * spec.a * time);
+		case SignalSpec::kRamp:
+			return fmod(spec.a * time, 1.0);
+		case SignalSpec::kNoise:
+			// xorshift32: repeatable from run to run
+			noiseState ^= noiseState << 13;
+			noiseState ^= noiseState >> 17;
+			noiseState ^= noiseState << 5;
+			return noiseState / 4294967296.0;
+		case SignalSpec::kSquare:
+			return fmod(spec.a * time, 1.0) < 0.5 ? 1 : 0;
+		case SignalSpec::kPulse:
+			return (spec.a > 0 && fmod(time, spec.a) < spec.b) ? 1 : 0;
+	}
+	return 0;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	SimulatorSettings& settings = gSimulatorSettings;
+	settings.projectName = PROJECT_NAME;
+
+	const struct option longOptions[] = {
+		{"input", required_argument, nullptr, 'i'},
+		{"output", required_argument, nullptr, 'o'},
+		{"analog-output", required_argument, nullptr, 'O'},
+		{"scope", required_argument, nullptr, 'S'},
+		{"midi", required_argument, nullptr, 'm'},
+		{"analog", required_argument, nullptr, 'a'},
+		{"digital", required_argument, nullptr, 'd'},
+		{"slider", required_argument, nullptr, 's'},
+		{"duration", required_argument, nullptr, 't'},
+		{"block-size", required_argument, nullptr, 'p'},
+		{"sample-rate", required_argument, nullptr, 'r'},
+		{"audio-channels", required_argument, nullptr, 'c'},
+		{"analog-channels", required_argument, nullptr, 'C'},
+		{"realtime", no_argument, nullptr, 'R'},
+		{"no-wait-aux", no_argument, nullptr, 'w'},
+		{"project-name", required_argument, nullptr, 'n'},
+		{"help", no_argument, nullptr, 'h'},
+		{nullptr, 0, nullptr, 0}
+	};
+
+	// Unless told otherwise, wait for auxiliary tasks when running faster than
+	// real time, so that the results are the same every time
+	int waitForAuxiliaryTasks = -1;
+
+	int option;
+	while((option = getopt_long(argc, argv, "i:o:t:p:h", longOptions, nullptr)) != -1) {
+		switch(option) {
+			case 'i': settings.inputFilename = optarg; break;
+			case 'o': settings.outputFilename = optarg; break;
+			case 'O': settings.analogOutputFilename = optarg; break;
+			case 'S': settings.scopeFilename = optarg; break;
+			case 'm': settings.midiFilename = optarg; break;
+			case 't': settings.duration = atof(optarg); break;
+			case 'p': settings.blockSize = atoi(optarg); break;
+			case 'r': settings.sampleRate = atof(optarg); break;
+			case 'c': settings.audioInChannels = settings.audioOutChannels = atoi(optarg); break;
+			case 'C': settings.analogChannels = atoi(optarg); break;
+			case 'R': settings.realTime = true; break;
+			case 'w': waitForAuxiliaryTasks = 0; break;
+			case 'n': settings.projectName = optarg; break;
+			case 'a':
+				if(!parseChannelSignal(optarg, settings.analogInputs)) {
+					fprintf(stderr, "Invalid analog signal '%s'\n", optarg);
+					return 1;
+				}
+				break;
+			case 'd':
+				if(!parseChannelSignal(optarg, settings.digitalInputs)) {
+					fprintf(stderr, "Invalid digital signal '%s'\n", optarg);
+					return 1;
+				}
+				break;
+			case 's': {
+				const char *equals = strchr(optarg, '=');
+				if(equals == nullptr) {
+					fprintf(stderr, "Invalid slider setting '%s'\n", optarg);
+					return 1;
+				}
+				settings.sliders.push_back(std::make_pair(std::string(optarg, equals - optarg), (float)atof(equals + 1)));
+				break;
+			}
+			default:
+				usage(argv[0]);
+				return option == 'h' ? 0 : 1;
+		}
+	}
+
+	if(waitForAuxiliaryTasks < 0)
+		settings.waitForAuxiliaryTasks = !settings.realTime;
+	else
+		settings.waitForAuxiliaryTasks = waitForAuxiliaryTasks;
+
+	if(settings.blockSize == 0 || settings.sampleRate <= 0 ||
+	   (settings.analogChannels != 2 && settings.analogChannels != 4 && settings.analogChannels != 8)) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	// Load the audio input, if any
+	std::vector<std::vector<float> > inputAudio;
+	if(settings.inputFilename != "") {
+		inputAudio = AudioFileUtilities::load(settings.inputFilename);
+		if(inputAudio.empty()) {
+			fprintf(stderr, "Unable to load audio input '%s'\n", settings.inputFilename.c_str());
+			return 1;
+		}
+		int fileRate = AudioFileUtilities::getSampleRate(settings.inputFilename);
+		if(fileRate != (int)settings.sampleRate)
+			fprintf(stderr, "Warning: '%s' has a sample rate of %d, not %.0f\n",
+					settings.inputFilename.c_str(), fileRate, settings.sampleRate);
+		if(settings.duration <= 0)
+			settings.duration = inputAudio[0].size() / settings.sampleRate;
+	}
+	if(settings.duration <= 0)
+		settings.duration = 10.0;
+
+	if(settings.midiFilename != "" && !Simulator_loadMidiFile(settings.midiFilename)) {
+		fprintf(stderr, "Unable to load MIDI file '%s'\n", settings.midiFilename.c_str());
+		return 1;
+	}
+
+	// Work out the sizes of all the buffers, using the same ratios as Bela
+	const unsigned int audioFrames = settings.blockSize;
+	const unsigned int analogFrames = audioFrames * 4 / settings.analogChannels;
+	const unsigned int digitalFrames = audioFrames;
+	const unsigned int analogChannels = settings.analogChannels;
+
+	std::vector<float> audioIn(audioFrames * settings.audioInChannels);
+	std::vector<float> audioOut(audioFrames * settings.audioOutChannels);
+	std::vector<float> analogIn(analogFrames * analogChannels);
+	std::vector<float> analogOut(analogFrames * analogChannels);
+	std::vector<uint32_t> digital(digitalFrames, 0xFFFF);		// All pins start as inputs
+
+	BelaContext context;
+	memset(&context, 0, sizeof(context));
+	context.audioIn = audioIn.data();
+	context.audioOut = audioOut.data();
+	context.analogIn = analogIn.data();
+	context.analogOut = analogOut.data();
+	context.digital = digital.data();
+	context.audioFrames = audioFrames;
+	context.audioInChannels = settings.audioInChannels;
+	context.audioOutChannels = settings.audioOutChannels;
+	context.audioSampleRate = settings.sampleRate;
+	context.analogFrames = analogFrames;
+	context.analogInChannels = analogChannels;
+	context.analogOutChannels = analogChannels;
+	context.analogSampleRate = settings.sampleRate * analogFrames / audioFrames;
+	context.digitalFrames = digitalFrames;
+	context.digitalChannels = settings.digitalChannels;
+	context.digitalSampleRate = settings.sampleRate;
+	context.flags = BELA_FLAG_INTERLEAVED | BELA_FLAG_ANALOG_OUTPUTS_PERSIST;
+	strncpy(context.projectName, settings.projectName.c_str(), MAX_PROJECTNAME_LENGTH - 1);
+
+	// Allocate the outputs for the whole run before starting
+	const uint64_t totalBlocks = (uint64_t)(settings.duration * settings.sampleRate / audioFrames);
+	std::vector<float> outputAudio, outputAnalog;
+	if(settings.outputFilename != "")
+		outputAudio.reserve(totalBlocks * audioOut.size());
+	if(settings.analogOutputFilename != "")
+		outputAnalog.reserve(totalBlocks * analogOut.size());
+
+	signal(SIGINT, interruptHandler);
+
+	if(!setup(&context, nullptr)) {
+		fprintf(stderr, "Couldn't initialise audio rendering\n");
+		Bela_deleteAllAuxiliaryTasks();
+		return 1;
+	}
+
+	uint32_t noiseState = 1;
+	double renderSeconds = 0, maxRenderSeconds = 0;
+	uint64_t block = 0;
+	auto startTime = std::chrono::steady_clock::now();
+
+	for(block = 0; block < totalBlocks && !gShouldStop; block++) {
+		uint64_t frame = block * audioFrames;
+		double blockStartTime = frame / settings.sampleRate;
+		double blockEndTime = (frame + audioFrames) / settings.sampleRate;
+
+		// Audio input: channels beyond those in the file repeat from the start
+		for(unsigned int n = 0; n < audioFrames; n++) {
+			for(unsigned int channel = 0; channel < settings.audioInChannels; channel++) {
+				float value = 0;
+				if(!inputAudio.empty()) {
+					const std::vector<float>& source = inputAudio[channel % inputAudio.size()];
+					if(frame + n < source.size())
+						value = source[frame + n];
+				}
+				audioIn[n * settings.audioInChannels + channel] = value;
+			}
+		}
+
+		// Analog input, from the synthetic signals
+		for(auto& input : settings.analogInputs) {
+			if(input.first >= analogChannels)
+				continue;
+			for(unsigned int n = 0; n < analogFrames; n++) {
+				double time = blockStartTime + n / context.analogSampleRate;
+				analogIn[n * analogChannels + input.first] = signalValue(input.second, time, noiseState);
+			}
+		}
+
+		// Digital: directions and outputs carry on from the end of the last block,
+		// then the input pins get their new values
+		uint32_t lastDigital = digital[digitalFrames - 1];
+		for(unsigned int n = 0; n < digitalFrames; n++)
+			digital[n] = lastDigital;
+		for(auto& input : settings.digitalInputs) {
+			unsigned int channel = input.first;
+			if(channel >= settings.digitalChannels)
+				continue;
+			for(unsigned int n = 0; n < digitalFrames; n++) {
+				if(!(digital[n] & (1u << channel)))
+					continue;		// Pin is an output
+				double time = blockStartTime + n / context.digitalSampleRate;
+				if(signalValue(input.second, time, noiseState) >= 0.5)
+					digital[n] |= 1u << (channel + 16);
+				else
+					digital[n] &= ~(1u << (channel + 16));
+			}
+		}
+
+		// Analog outputs hold their last value
+		for(unsigned int n = 1; n < analogFrames; n++) {
+			for(unsigned int channel = 0; channel < analogChannels; channel++)
+				analogOut[n * analogChannels + channel] = analogOut[(analogFrames - 1) * analogChannels + channel];
+		}
+		for(unsigned int channel = 0; channel < analogChannels; channel++)
+			analogOut[channel] = analogOut[(analogFrames - 1) * analogChannels + channel];
+
+		std::fill(audioOut.begin(), audioOut.end(), 0);
+
+		// MIDI messages which arrive during this block
+		Simulator_deliverMidi(blockEndTime);
+
+		context.audioFramesElapsed = frame;
+
+		// Render the block, timing how long it takes
+		auto renderStart = std::chrono::steady_clock::now();
+		render(&context, nullptr);
+		auto renderEnd = std::chrono::steady_clock::now();
+
+		double renderTime = std::chrono::duration<double>(renderEnd - renderStart).count();
+		renderSeconds += renderTime;
+		if(renderTime > maxRenderSeconds)
+			maxRenderSeconds = renderTime;
+
+		if(settings.waitForAuxiliaryTasks)
+			Simulator_waitForAuxiliaryTasks();
+
+		// Save the outputs
+		if(settings.outputFilename != "")
+			outputAudio.insert(outputAudio.end(), audioOut.begin(), audioOut.end());
+		if(settings.analogOutputFilename != "")
+			outputAnalog.insert(outputAnalog.end(), analogOut.begin(), analogOut.end());
+
+		// In real time, wait until the next block is due
+		if(settings.realTime)
+			std::this_thread::sleep_until(startTime + std::chrono::duration<double>(blockEndTime));
+	}
+
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	cleanup(&context, nullptr);
+	Bela_deleteAllAuxiliaryTasks();
+
+	// Report how fast render() was compared to the audio clock
+	double audioSeconds = block * audioFrames / settings.sampleRate;
+	double blockPeriod = audioFrames / settings.sampleRate;
+	if(block > 0) {
+		fprintf(stderr, "Rendered %.2fs of audio in %.2fs (%.1fx real time)\n",
+				audioSeconds, elapsed, elapsed > 0 ? audioSeconds / elapsed : 0);
+		fprintf(stderr, "render(): mean %.2fus (%.1f%% of block), max %.2fus (%.1f%% of block)\n",
+				1e6 * renderSeconds / block, 100.0 * renderSeconds / block / blockPeriod,
+				1e6 * maxRenderSeconds, 100.0 * maxRenderSeconds / blockPeriod);
+	}
+
+	// Write the output files
+	if(settings.outputFilename != "" &&
+	   AudioFileUtilities::write(settings.outputFilename, outputAudio.data(), settings.audioOutChannels,
+								 outputAudio.size() / settings.audioOutChannels, settings.sampleRate) != 0) {
+		fprintf(stderr, "Unable to write '%s'\n", settings.outputFilename.c_str());
+		return 1;
+	}
+	if(settings.analogOutputFilename != "" &&
+	   AudioFileUtilities::write(settings.analogOutputFilename, outputAnalog.data(), analogChannels,
+								 outputAnalog.size() / analogChannels, context.analogSampleRate) != 0) {
+		fprintf(stderr, "Unable to write '%s'\n", settings.analogOutputFilename.c_str());
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// ADSR.h: attack-decay-sustain-release envelope, defined entirely in this
+// header so that process() can be inlined
+
+#pragma once
+
+#include "Ramp.h"
+
+namespace dsp {
+
+class ADSR {
+private:
+	// ADSR state machine variables, used internally
+	enum State {
+		StateOff = 0,
+		StateAttack,
+		StateDecay,
+		StateSustain,
+		StateRelease
+	};
+
+public:
+	// Constructor
+	ADSR() {}
+
+	// Constructor with argument
+	ADSR(float sampleRate) { setSampleRate(sampleRate); }
+
+	// Set the sample rate, used for all calculations
+	void setSampleRate(float rate) { ramp_.setSampleRate(rate); }
+
+	// Start the envelope, going to the Attack state
+	void trigger() {
+		state_ = StateAttack;
+		ramp_.rampTo(1.0, attackTime_);
+	}
+
+	// Stop the envelope, going to the Release state
+	void release() {
+		state_ = StateRelease;
+		ramp_.rampTo(0.0, releaseTime_);
+	}
+
+	// Calculate the next sample of output, changing the envelope
+	// state as needed
+	inline float process();
+
+	// Fill a buffer with the next frames outputs
+	void process(float * __restrict output, unsigned int frames) {
+		for(unsigned int n = 0; n < frames; n++)
+			output[n] = process();
+	}
+
+	// Indicate whether the envelope is active or not (i.e. in
+	// anything other than the Off state
+	bool isActive() { return (state_ != StateOff); }
+
+	// Methods for getting and setting parameters
+	float getAttackTime() { return attackTime_; }
+	float getDecayTime() { return decayTime_; }
+	float getSustainLevel() { return sustainLevel_; }
+	float getReleaseTime() { return releaseTime_; }
+
+	// Each parameter is constrained to a sensible range
+	void setAttackTime(float attackTime) { attackTime_ = (attackTime >= 0) ? attackTime : 0; }
+	void setDecayTime(float decayTime) { decayTime_ = (decayTime >= 0) ? decayTime : 0; }
+	void setSustainLevel(float sustainLevel) {
+		if(sustainLevel < 0)
+			sustainLevel_ = 0;
+		else if(sustainLevel > 1)
+			sustainLevel_ = 1;
+		else
+			sustainLevel_ = sustainLevel;
+	}
+	void setReleaseTime(float releaseTime) { releaseTime_ = (releaseTime >= 0) ? releaseTime : 0; }
+
+	// Destructor
+	~ADSR() {}
+
+private:
+	// State variables and parameters, not accessible to the outside world
+	float attackTime_ = 0.001;
+	float decayTime_ = 0.001;
+	float sustainLevel_ = 1;
+	float releaseTime_ = 0.001;
+
+	State state_ = StateOff;	// Current state of the ADSR (one of the enum values above)
+	Ramp ramp_;					// Line segment generator
+};
+
+// Calculate the next sample of output. The transitions caused by note
+// events are done in trigger() and release(); here we only move on when
+// the current ramp finishes.
+inline float ADSR::process()
+{
+	if(state_ == StateAttack) {
+		if(ramp_.finished()) {
+			state_ = StateDecay;
+			ramp_.rampTo(sustainLevel_, decayTime_);
+		}
+	}
+	else if(state_ == StateDecay) {
+		if(ramp_.finished())
+			state_ = StateSustain;
+	}
+	else if(state_ == StateRelease) {
+		if(ramp_.finished())
+			state_ = StateOff;
+	}
+
+	// Return the current output level
+	return ramp_.process();
+}
+
+} // namespace dsp
+
+using dsp::ADSR;
\ No newline at end of file
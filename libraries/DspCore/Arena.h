@@ -0,0 +1,131 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// Arena.h: a single block of memory reserved, locked and touched in setup(),
+// from which DSP buffers are handed out. Every page of the block is in RAM
+// before the audio starts, so the first blocks run as fast as the rest.
+// Memory is never given back one buffer at a time: the whole block is
+// released by cleanup() or the destructor.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace dsp {
+
+class Arena {
+public:
+	// Alignment of every buffer, enough for NEON and SSE loads
+	static const size_t kAlignment = 16;
+
+	// Constructors: the one with an argument automatically calls setup()
+	Arena() {}
+	Arena(size_t bytes) { setup(bytes); }
+
+	// Reserve a block of the given size, lock it into RAM and touch every
+	// page. Returns false if the block couldn't be reserved. If it couldn't
+	// be locked (see isLocked()) it is still usable, but could be paged out.
+	bool setup(size_t bytes) {
+		cleanup();
+
+		// Round up to whole pages
+		size_t pageSize = sysconf(_SC_PAGESIZE);
+		bytes = (bytes + pageSize - 1) / pageSize * pageSize;
+
+		void *block = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if(block == MAP_FAILED)
+			return false;
+		block_ = (char *)block;
+		size_ = bytes;
+		locked_ = (mlock(block_, size_) == 0);
+
+		// Write to every page so that none of them faults later
+		for(size_t n = 0; n < size_; n += pageSize)
+			((volatile char *)block_)[n] = 0;
+		return true;
+	}
+
+	// Return a buffer of count zero-initialised objects, or nullptr if the
+	// arena is full or finishSetup() has been called. Objects are never
+	// destroyed, so only types without destructors are allowed.
+	template<class T>
+	T* allocate(size_t count) {
+		static_assert(std::is_trivially_destructible<T>::value,
+					  "Arena objects are never destroyed");
+		static_assert(alignof(T) <= kAlignment, "Arena alignment is too small");
+
+		if(finished_) {
+			lateAllocations_++;
+			return nullptr;
+		}
+		size_t start = (used_ + kAlignment - 1) & ~(kAlignment - 1);
+		if(block_ == nullptr || count > (size_ - start) / sizeof(T)) {
+			failedAllocations_++;
+			return nullptr;
+		}
+		used_ = start + count * sizeof(T);
+
+		T *buffer = (T *)(block_ + start);
+		for(size_t n = 0; n < count; n++)
+			new(buffer + n) T();
+		return buffer;
+	}
+
+	// Call at the end of setup(): any later allocate() fails and is counted
+	void finishSetup() { finished_ = true; }
+
+	// Information about the arena and how it has been used
+	size_t size() { return size_; }
+	size_t used() { return used_; }
+	bool isLocked() { return locked_; }
+	unsigned int failedAllocations() { return failedAllocations_; }
+	unsigned int lateAllocations() { return lateAllocations_; }
+
+	// Release the whole block. Every buffer handed out becomes invalid.
+	void cleanup() {
+		if(block_ != nullptr) {
+			if(locked_)
+				munlock(block_, size_);
+			munmap(block_, size_);
+		}
+		block_ = nullptr;
+		size_ = used_ = 0;
+		locked_ = finished_ = false;
+		failedAllocations_ = lateAllocations_ = 0;
+	}
+
+	// Destructor
+	~Arena() { cleanup(); }
+
+	// The block belongs to a single arena
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+private:
+	char *block_ = nullptr;					// Start of the block
+	size_t size_ = 0;						// Size of the block in bytes
+	size_t used_ = 0;						// Bytes handed out so far
+	bool locked_ = false;					// Whether mlock() succeeded
+	bool finished_ = false;					// Whether setup has finished
+	unsigned int failedAllocations_ = 0;	// Requests that didn't fit
+	unsigned int lateAllocations_ = 0;		// Requests after finishSetup()
+};
+
+} // namespace dsp
+
+using dsp::Arena;
\ No newline at end of file
@@ -0,0 +1,343 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// ControlScript.h: control routines, such as "play a note, wait a quarter
+// of a beat, then ramp the filter down", written as C++20 coroutines instead
+// of counters and state machines. A ScriptRunner resumes each script at the
+// exact frame its wait ends, from process() in the render() loop. While the
+// scripts are waiting, process() costs one comparison per frame however many
+// there are.
+//
+// A script is a function returning Script, whose first argument is the
+// runner. co_await a wait to pause it, or another script to run that to the
+// end before carrying on:
+//
+//   Script bar(ScriptRunner& runner, float note) {
+//       for(int beat = 0; beat < 4; beat++) {
+//           gEnvelope.trigger();
+//           co_await runner.waitBeats(1);
+//       }
+//   }
+//
+//   Script song(ScriptRunner& runner) {
+//       while(true) {
+//           co_await bar(runner, 60);
+//           co_await bar(runner, 67);
+//       }
+//   }
+//
+//   gRunner.start(song(gRunner));
+//
+// The coroutine frames come from a pool reserved by the runner's setup(), so
+// starting a script never allocates. If the frame doesn't fit, the script
+// doesn't start. Scripts run on the audio thread and must not block.
+
+#pragma once
+
+#if !defined(__cpp_impl_coroutine)
+#error "ControlScript.h needs C++20 coroutines: compile with -std=c++20"
+#endif
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <exception>
+#include <utility>
+#include <vector>
+
+namespace dsp {
+
+class ScriptRunner;
+
+class Script {
+public:
+	struct promise_type;
+	typedef std::coroutine_handle<promise_type> Handle;
+
+	struct promise_type {
+		ScriptRunner *runner;
+		promise_type *root = nullptr;	// Script started by the runner, which this one is part of
+		Handle caller;					// Script waiting for this one to finish
+		Handle current;					// For a root: the script to resume next
+		double wakeTime = 0;			// For a root: frame at which to resume
+
+		// The runner is always the first argument of a script
+		template<class... Args>
+		promise_type(ScriptRunner& runner, Args&&...) : runner(&runner) {}
+
+		// Frames come from the runner's pool rather than the heap
+		template<class... Args>
+		static void* operator new(std::size_t size, ScriptRunner& runner, Args&&...) noexcept;
+		static void operator delete(void *frame, std::size_t size) noexcept;
+		static Script get_return_object_on_allocation_failure() noexcept { return Script(); }
+
+		Script get_return_object() { return Script(Handle::from_promise(*this)); }
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+
+		// When a script called by another finishes, carry on with the caller
+		struct FinalAwaiter {
+			bool await_ready() noexcept { return false; }
+			std::coroutine_handle<> await_suspend(Handle handle) noexcept {
+				promise_type& promise = handle.promise();
+				if(!promise.caller)
+					return std::noop_coroutine();
+				promise.root->current = promise.caller;
+				return promise.caller;
+			}
+			void await_resume() noexcept {}
+		};
+		FinalAwaiter final_suspend() noexcept { return {}; }
+	};
+
+	// Constructor: a script that couldn't be created
+	Script() {}
+
+	Script(Script&& other) : handle_(std::exchange(other.handle_, nullptr)) {}
+	Script& operator=(Script&& other) {
+		if(this != &other) {
+			destroy();
+			handle_ = std::exchange(other.handle_, nullptr);
+		}
+		return *this;
+	}
+	Script(const Script&) = delete;
+	Script& operator=(const Script&) = delete;
+
+	// Whether the script was created: false if the runner's pool was full
+	bool valid() { return (bool)handle_; }
+
+	// co_await a script to run it from start to finish inside another. If it
+	// couldn't be created, this does nothing.
+	bool await_ready() { return !handle_; }
+	std::coroutine_handle<> await_suspend(Handle caller) {
+		promise_type& promise = handle_.promise();
+		promise.caller = caller;
+		promise.root = caller.promise().root;
+		promise.root->current = handle_;
+		return handle_;
+	}
+	void await_resume() {}
+
+	// Destructor: frees the frame, unless the runner has taken the script
+	~Script() { destroy(); }
+
+private:
+	friend class ScriptRunner;
+	explicit Script(Handle handle) : handle_(handle) {}
+	void destroy() {
+		if(handle_)
+			handle_.destroy();
+		handle_ = nullptr;
+	}
+
+	Handle handle_;
+};
+
+class ScriptRunner {
+public:
+	// Constructor
+	ScriptRunner() {}
+
+	// Reserve room for up to maxScripts scripts at once, including the ones
+	// they call, each with a coroutine frame of up to frameSize bytes. Call
+	// from setup(), before starting any scripts.
+	void setup(float sampleRate, unsigned int maxScripts = 16, unsigned int frameSize = 512) {
+		stop();
+		sampleRate_ = sampleRate;
+		setTempo(tempo_);
+
+		// Each frame starts with a pointer back to the runner, for operator delete
+		slotSize_ = (frameSize + kHeaderSize + kAlignment - 1) / kAlignment * kAlignment;
+		pool_.assign(maxScripts * slotSize_ / kAlignment, Block());
+		freeSlots_.clear();
+		freeSlots_.reserve(maxScripts);
+		for(unsigned int i = maxScripts; i > 0; i--)
+			freeSlots_.push_back((unsigned char *)pool_.data() + (i - 1) * slotSize_);
+		scripts_.assign(maxScripts, Script::Handle());
+		failedStarts_ = 0;
+		largestFrame_ = 0;
+	}
+
+	// Set the tempo in beats per minute, used by waitBeats()
+	void setTempo(float bpm) {
+		tempo_ = bpm;
+		framesPerBeat_ = 60.0 * sampleRate_ / bpm;
+	}
+	float getTempo() { return tempo_; }
+
+	// Length of a number of beats in seconds, for example for Ramp::rampTo()
+	float beatsToSeconds(float beats) { return beats * 60.0f / tempo_; }
+
+	// Start a script, running it straight away until its first wait. Safe to
+	// call from render() and from other scripts. Returns false if the script
+	// couldn't be created or the runner is full.
+	bool start(Script script) {
+		if(!script.valid())
+			return false;
+		if(numScripts_ >= scripts_.size()) {
+			failedStarts_++;
+			return false;
+		}
+		Script::Handle handle = std::exchange(script.handle_, nullptr);
+		Script::promise_type& promise = handle.promise();
+		promise.root = &promise;
+		promise.current = handle;
+		promise.wakeTime = frame_;
+		handle.resume();
+		if(handle.done()) {
+			handle.destroy();
+			return true;
+		}
+		scripts_[numScripts_++] = handle;
+		updateNextWake(promise.wakeTime);
+		return true;
+	}
+
+	// Stop all the scripts. Call from cleanup() if the scripts use objects
+	// which are about to be destroyed.
+	void stop() {
+		for(unsigned int i = 0; i < numScripts_; i++)
+			scripts_[i].destroy();
+		numScripts_ = 0;
+		nextWakeFrame_ = UINT64_MAX;
+	}
+
+	// Call once per frame at the top of the render() loop, to resume the
+	// scripts whose wait ends on this frame
+	void process() {
+		if(frame_ >= nextWakeFrame_)
+			resumeDue();
+		frame_++;
+	}
+
+	// Pause a script for a number of frames, seconds or beats. Waits are
+	// measured from when the previous one ended rather than from when the
+	// script resumed, so fractions of a frame add up instead of drifting.
+	struct Wait {
+		double frames;
+		bool await_ready() { return false; }
+		bool await_suspend(Script::Handle handle) {
+			Script::promise_type& root = *handle.promise().root;
+			root.wakeTime += frames;
+			// Carry on without pausing if the wait has already ended
+			return ScriptRunner::toFrame(root.wakeTime) > handle.promise().runner->frame_;
+		}
+		void await_resume() {}
+	};
+	Wait waitFrames(double frames) { return Wait{frames}; }
+	Wait waitSeconds(double seconds) { return Wait{seconds * sampleRate_}; }
+	Wait waitBeats(double beats) { return Wait{beats * framesPerBeat_}; }
+
+	// The frame process() handles next
+	uint64_t currentFrame() { return frame_; }
+
+	unsigned int numScripts() { return numScripts_; }
+
+	// Scripts which couldn't start, because the pool was full or a frame was
+	// larger than frameSize, and the largest frame asked for, to help choose
+	// the setup() arguments
+	unsigned int failedStarts() { return failedStarts_; }
+	unsigned int largestFrame() { return largestFrame_; }
+
+	// Destructor
+	~ScriptRunner() { stop(); }
+
+	ScriptRunner(const ScriptRunner&) = delete;
+	ScriptRunner& operator=(const ScriptRunner&) = delete;
+
+private:
+	friend struct Script::promise_type;
+
+	static constexpr std::size_t kAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+	static constexpr std::size_t kHeaderSize = (sizeof(ScriptRunner*) + kAlignment - 1) / kAlignment * kAlignment;
+	struct alignas(kAlignment) Block { unsigned char bytes[kAlignment]; };
+
+	// A script resumes on the first frame at or after its wake time
+	static uint64_t toFrame(double time) { return (uint64_t)std::ceil(time); }
+
+	void updateNextWake(double wakeTime) {
+		uint64_t frame = toFrame(wakeTime);
+		if(frame < nextWakeFrame_)
+			nextWakeFrame_ = frame;
+	}
+
+	void resumeDue() {
+		nextWakeFrame_ = UINT64_MAX;
+		// Scripts started from here are added at the end, and finished ones
+		// replaced by the last one, so the count is checked on every pass
+		unsigned int i = 0;
+		while(i < numScripts_) {
+			Script::Handle handle = scripts_[i];
+			Script::promise_type& promise = handle.promise();
+			if(toFrame(promise.wakeTime) <= frame_) {
+				promise.current.resume();
+				if(handle.done()) {
+					handle.destroy();
+					scripts_[i] = scripts_[--numScripts_];
+					continue;
+				}
+			}
+			updateNextWake(promise.wakeTime);
+			i++;
+		}
+	}
+
+	void* allocate(std::size_t size) {
+		if(size > largestFrame_)
+			largestFrame_ = size;
+		if(size + kHeaderSize > slotSize_ || freeSlots_.empty()) {
+			failedStarts_++;
+			return nullptr;
+		}
+		unsigned char *slot = freeSlots_.back();
+		freeSlots_.pop_back();
+		*(ScriptRunner **)slot = this;
+		return slot + kHeaderSize;
+	}
+
+	void release(void *frame) {
+		freeSlots_.push_back((unsigned char *)frame - kHeaderSize);
+	}
+
+	float sampleRate_ = 44100;
+	float tempo_ = 120;
+	double framesPerBeat_ = 22050;
+	uint64_t frame_ = 0;
+	uint64_t nextWakeFrame_ = UINT64_MAX;		// Earliest frame any script resumes
+	std::vector<Block> pool_;					// Coroutine frames
+	std::vector<unsigned char*> freeSlots_;
+	std::size_t slotSize_ = 0;
+	std::vector<Script::Handle> scripts_;		// Running scripts, the first numScripts_
+	unsigned int numScripts_ = 0;
+	unsigned int failedStarts_ = 0;
+	unsigned int largestFrame_ = 0;
+};
+
+template<class... Args>
+inline void* Script::promise_type::operator new(std::size_t size, ScriptRunner& runner, Args&&...) noexcept
+{
+	return runner.allocate(size);
+}
+
+inline void Script::promise_type::operator delete(void *frame, std::size_t) noexcept
+{
+	ScriptRunner *runner = *(ScriptRunner **)((unsigned char *)frame - ScriptRunner::kHeaderSize);
+	runner->release(frame);
+}
+
+} // namespace dsp
+
+using dsp::Script;
+using dsp::ScriptRunner;
\ No newline at end of file
@@ -0,0 +1,68 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// CpuFeatures.h: which vector instructions the processor running the
+// program has, found once at startup. The compiler flags only say what the
+// program was built for; the same binary may run on an ARMv7 with or without
+// NEON, or on an x86 with or without AVX. Code with several versions of a
+// function (such as Kernels.h) uses this to choose between them.
+
+#pragma once
+
+#if defined(__linux__) && defined(__arm__)
+#include <sys/auxv.h>
+#endif
+
+namespace dsp {
+
+struct CpuFeatures {
+	bool neon = false;		// ARM NEON (always there on AArch64)
+	bool sse2 = false;		// x86 SSE2 (always there on x86-64)
+	bool avx = false;		// x86 AVX, 8 floats at a time
+	bool avx2 = false;		// x86 AVX2 (integer AVX)
+	bool fma = false;		// x86 fused multiply-add
+};
+
+// Ask the processor (on x86) or the operating system (on ARM)
+inline CpuFeatures detectCpuFeatures()
+{
+	CpuFeatures features;
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_cpu_init();
+	features.sse2 = __builtin_cpu_supports("sse2");
+	features.avx = __builtin_cpu_supports("avx");
+	features.avx2 = __builtin_cpu_supports("avx2");
+	features.fma = __builtin_cpu_supports("fma");
+#elif defined(__aarch64__)
+	features.neon = true;
+#elif defined(__arm__) && defined(__linux__)
+	// Linux lists the features in the auxiliary vector; bit 12 is NEON
+	const unsigned long kHwcapNeon = 1 << 12;
+	features.neon = (getauxval(AT_HWCAP) & kHwcapNeon) != 0;
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	// Nowhere to ask, so trust the compiler flags
+	features.neon = true;
+#endif
+	return features;
+}
+
+// The features of this processor, detected on the first call
+inline const CpuFeatures& cpuFeatures()
+{
+	static const CpuFeatures features = detectCpuFeatures();
+	return features;
+}
+
+} // namespace dsp
+
+using dsp::CpuFeatures;
+using dsp::cpuFeatures;
\ No newline at end of file
@@ -0,0 +1,104 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// Debouncer.h: simple class to debounce a button, defined entirely in this
+// header so that process() can be inlined
+
+#pragma once
+
+namespace dsp {
+
+class Debouncer {
+private:
+	// State machine states
+	enum {
+		kStateLow = 0,
+		kStateJustHigh,
+		kStateHigh,
+		kStateJustLow
+	};
+
+public:
+	// Constructor
+	Debouncer() { setup(1, 1); }
+
+	// Constructor specifying a sample rate
+	Debouncer(float sampleRate, float interval) { setup(sampleRate, interval); }
+
+	// Set the sample rate, used for all calculations
+	void setup(float sampleRate, float interval) {
+		debounceInterval_ = sampleRate * interval;
+		currentState_ = previousState_ = kStateLow;
+		counter_ = 0;
+	}
+
+	// Return the debounced state given the raw input
+	inline bool process(bool rawInput);
+
+	// Return whether the button is currently high or low
+	bool currentValue() { return (currentState_ == kStateHigh || currentState_ == kStateJustHigh); }
+
+	// Return whether the button just now went high
+	bool risingEdge() { return (currentState_ == kStateJustHigh && previousState_ == kStateLow); }
+
+	// Return whether the button just now went low
+	bool fallingEdge() { return (currentState_ == kStateJustLow && previousState_ == kStateHigh); }
+
+	// Destructor
+	~Debouncer() {}
+
+private:
+	// State variables, not accessible to the outside world
+	int   currentState_;
+	int   previousState_;
+	int   counter_;
+	int   debounceInterval_;
+};
+
+// Return the debounced state given the raw input
+inline bool Debouncer::process(bool rawInput)
+{
+	// Save the current state so that if it changes, the risingEdge() and
+	// fallingEdge() methods can detect it
+	previousState_ = currentState_;
+
+	if(currentState_ == kStateLow) {
+		// Button is low: look for a high input
+		if(rawInput) {
+			currentState_ = kStateJustHigh;
+			counter_ = 0;
+		}
+	}
+	else if(currentState_ == kStateJustHigh) {
+		// Button was just high: wait for the debounce interval
+		if(++counter_ >= debounceInterval_)
+			currentState_ = kStateHigh;
+	}
+	else if(currentState_ == kStateHigh) {
+		// Button is high: look for a low input
+		if(!rawInput) {
+			currentState_ = kStateJustLow;
+			counter_ = 0;
+		}
+	}
+	else if(currentState_ == kStateJustLow) {
+		// Button was just low: wait for the debounce interval
+		if(++counter_ >= debounceInterval_)
+			currentState_ = kStateLow;
+	}
+
+	return currentValue();
+}
+
+} // namespace dsp
+
+using dsp::Debouncer;
\ No newline at end of file
@@ -0,0 +1,103 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// ExponentialSegment.h: an exponential segment generator, defined entirely
+// in this header so that process() can be inlined
+
+#pragma once
+
+#include <cmath>
+
+namespace dsp {
+
+class ExponentialSegment {
+
+public:
+	// Constructor
+	ExponentialSegment() { setValue(0); }
+
+	// Constructor specifying a sample rate
+	ExponentialSegment(float sampleRate) : sampleRate_(sampleRate) { setValue(0); }
+
+	// Set the sample rate, used for all calculations
+	void setSampleRate(float rate) { sampleRate_ = rate; }
+
+	// Jump to a value
+	void setValue(float value) {
+		currentValue_ = value;
+		asymptoteValue_ = targetValue_ = value;
+		expValue_ = 0;
+		multiplier_ = 0;
+	}
+
+	// Ramp to a value over a period of time, with a given percent overshoot
+	void rampTo(float value, float time, float overshootRatio = 1.001) {
+		// Ramp towards the target value
+		targetValue_ = value;
+
+		// We need to calculate how far beyond the target to ramp, based on the current
+		// value and the overshoot
+		float distanceToTarget = targetValue_ - currentValue_;
+		asymptoteValue_ = currentValue_ + distanceToTarget * overshootRatio;
+
+		expValue_ = currentValue_ - asymptoteValue_;
+
+		// Calculate time constant to reach the target in the specified time
+		double tau = -1.0 * time / log(1.0 - 1.0/overshootRatio);
+
+		// Calculate the multiplier for each frame
+		multiplier_ = pow(exp(-1.0 / tau), 1.0 / sampleRate_);
+	}
+
+	// Generate and return the next ramp output
+	float process() {
+		currentValue_ = asymptoteValue_ + expValue_;
+
+		if(!finished())
+			expValue_ *= multiplier_;
+
+		return currentValue_;
+	}
+
+	// Fill a buffer with the next frames outputs
+	void process(float * __restrict output, unsigned int frames) {
+		for(unsigned int n = 0; n < frames; n++)
+			output[n] = process();
+	}
+
+	// Return whether the ramp is finished
+	bool finished() {
+		// Check if we have reached the target. Need to check if we're
+		// going upwards or downwards
+		if(currentValue_ >= targetValue_ && currentValue_ <= asymptoteValue_)
+			return true;
+		if(currentValue_ <= targetValue_ && currentValue_ >= asymptoteValue_)
+			return true;
+		return false;
+	}
+
+	// Destructor
+	~ExponentialSegment() {}
+
+private:
+	// State variables, not accessible to the outside world
+	double sampleRate_ = 1;
+	double currentValue_;
+	double targetValue_;
+	double asymptoteValue_;
+	double expValue_;
+	double multiplier_;
+};
+
+} // namespace dsp
+
+using dsp::ExponentialSegment;
\ No newline at end of file
@@ -0,0 +1,650 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// FastMath.h: fast approximations of the exponential and logarithm functions
+// used to convert pitches and levels, and of the trigonometric functions used
+// by oscillators and filter coefficients, with one-value and whole-buffer forms.
+// The buffer forms work on 4 values at a time using NEON (on Bela) or SSE2.
+//
+// Measured accuracy, compared to the same functions in double precision:
+//   fastExp2(x)      relative error < 2e-7 for -126 <= x < 128
+//   fastLog2(x)      absolute error < 4e-7 for 0.5 <= x < 2, and < 4e-7 plus
+//                    one unit in the last place of the result elsewhere
+//   fastPow(b, x)    relative error < 8e-7 + 7e-7 * |x * log2(b)|, b > 0
+//   dbToGain(db)     relative error < 3e-7 for -20 to +20 dB, < 1e-6 for
+//                    -120 to +120 dB (rounding of db grows with its size)
+//   midiToHz(note)   relative error < 5e-7 (under 0.001 cents), notes 0-127
+//   fastSin(x)       absolute error < 1e-7 for |x| < 8192
+//   fastCos(x)       absolute error < 1e-7 for |x| < 8192
+//   fastTan(x)       relative error < 3e-7 for |x| < 100; up to 8192 the
+//                    same bound holds for the error divided by max(1, |tan x|)
+// Inputs outside those ranges are clamped by fastExp2. fastLog2 returns
+// -infinity for 0 and NaN for negative numbers; the buffer forms expect
+// positive inputs. The trigonometric functions lose accuracy beyond |x| = 8192,
+// so keep oscillator phases wrapped.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DSPCORE_FASTMATH_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define DSPCORE_FASTMATH_SSE2
+#endif
+
+namespace dsp {
+
+namespace fastmath {
+	// Minimax polynomial for 2^f with 0 <= f < 1 (weighted for relative error)
+	const float kExp2C0 = 0.9999999250635297f;
+	const float kExp2C1 = 0.6931530732000758f;
+	const float kExp2C2 = 0.24015361704533342f;
+	const float kExp2C3 = 0.055826318050039916f;
+	const float kExp2C4 = 0.00898934009471393f;
+	const float kExp2C5 = 0.0018775766733667028f;
+
+	// Minimax polynomial for log2(1 + u) / u with sqrt(0.5) <= 1 + u < sqrt(2)
+	const float kLog2C0 = 1.4426997262967767f;
+	const float kLog2C1 = -0.7213758714442587f;
+	const float kLog2C2 = 0.4804650336772937f;
+	const float kLog2C3 = -0.3589618506813568f;
+	const float kLog2C4 = 0.29726258673449363f;
+	const float kLog2C5 = -0.2726979262147068f;
+	const float kLog2C6 = 0.17063450359901025f;
+
+	// Minimax polynomials for sin(r) / r - 1 and cos(r) - 1 in powers of r^2,
+	// with -pi/4 <= r <= pi/4
+	const float kSinS1 = -0.16666666644220035f;
+	const float kSinS2 = 0.008333329329097635f;
+	const float kSinS3 = -0.00019839261552850607f;
+	const float kSinS4 = 2.717349461242205e-06f;
+	const float kCosC1 = -0.49999999753531577f;
+	const float kCosC2 = 0.04166662269639917f;
+	const float kCosC3 = -0.0013886683227305346f;
+	const float kCosC4 = 2.437988029236914e-05f;
+
+	// pi/2 split into three parts. The first two have few enough bits that
+	// multiplying them by a quadrant number below 8192 is exact.
+	const float kTwoOverPi = 0.6366197723675814f;
+	const float kPiOver2A = 1.5703125f;
+	const float kPiOver2B = 4.837512969970703125e-4f;
+	const float kPiOver2C = 7.54978995489188216e-8f;
+
+	// Range of exponents which give a normal float result
+	const float kExp2Min = -126.0f;
+	const float kExp2Max = 127.99999f;
+
+	// Conversion factors
+	const float kLog2Of10Over20 = 0.16609640474436813f;	// log2(10) / 20, for decibels
+	const float kOneTwelfth = 1.0f / 12.0f;				// Octaves per semitone
+
+	inline float bitsToFloat(uint32_t bits) { float f; memcpy(&f, &bits, sizeof(f)); return f; }
+	inline uint32_t floatToBits(float f) { uint32_t bits; memcpy(&bits, &f, sizeof(bits)); return bits; }
+}
+
+// 2 to the power x
+inline float fastExp2(float x)
+{
+	using namespace fastmath;
+
+	// Keep the result a normal number
+	if(x < kExp2Min)
+		x = kExp2Min;
+	else if(x > kExp2Max)
+		x = kExp2Max;
+
+	// Split into whole and fractional parts: 2^x = 2^i * 2^f
+	int i = (int)x;
+	if(x < i)
+		i--;
+	float f = x - i;
+
+	// 2^f from the polynomial, 2^i by writing the exponent bits directly
+	float p = kExp2C5;
+	p = p * f + kExp2C4;
+	p = p * f + kExp2C3;
+	p = p * f + kExp2C2;
+	p = p * f + kExp2C1;
+	p = p * f + kExp2C0;
+	return p * bitsToFloat((uint32_t)(i + 127) << 23);
+}
+
+// Base-2 logarithm of x
+inline float fastLog2(float x)
+{
+	using namespace fastmath;
+
+	if(__builtin_expect(!(x > 0), 0))
+		return (x == 0) ? -INFINITY : NAN;
+
+	// Split into exponent and mantissa: x = 2^e * m with 1 <= m < 2
+	uint32_t bits = floatToBits(x);
+	int e = (int)(bits >> 23) - 127;
+	float m = bitsToFloat((bits & 0x007FFFFF) | 0x3F800000);
+
+	// Centre the mantissa on 1 so the polynomial is most accurate. Written
+	// without a branch so the compiler can use a conditional select.
+	bool high = (m > (float)M_SQRT2);
+	m = high ? m * 0.5f : m;
+	e += high;
+	float u = m - 1.0f;
+
+	float p = kLog2C6;
+	p = p * u + kLog2C5;
+	p = p * u + kLog2C4;
+	p = p * u + kLog2C3;
+	p = p * u + kLog2C2;
+	p = p * u + kLog2C1;
+	p = p * u + kLog2C0;
+	return e + u * p;
+}
+
+namespace fastmath {
+	// Reduce x to r = x - q * pi/2 with -pi/4 <= r <= pi/4, returning the
+	// quadrant q. Only the lowest two bits of q matter to the caller.
+	inline int reduceQuadrant(float x, float& r) {
+		float qf = x * kTwoOverPi + 0.5f;
+		int q = (int)qf;
+		if(qf < q)
+			q--;
+		float fq = (float)q;
+		r = ((x - fq * kPiOver2A) - fq * kPiOver2B) - fq * kPiOver2C;
+		return q;
+	}
+
+	// sin(r) and cos(r) for -pi/4 <= r <= pi/4, given s = r * r
+	inline float sinPolynomial(float r, float s) {
+		float p = kSinS4;
+		p = p * s + kSinS3;
+		p = p * s + kSinS2;
+		p = p * s + kSinS1;
+		return r + r * s * p;
+	}
+	inline float cosPolynomial(float s) {
+		float p = kCosC4;
+		p = p * s + kCosC3;
+		p = p * s + kCosC2;
+		p = p * s + kCosC1;
+		return 1.0f + s * p;
+	}
+}
+
+// Sine and cosine of x together, for the cost of little more than one
+inline void fastSinCos(float x, float& sinOut, float& cosOut)
+{
+	using namespace fastmath;
+
+	float r;
+	int q = reduceQuadrant(x, r);
+	float s = r * r;
+	float sine = sinPolynomial(r, s);
+	float cosine = cosPolynomial(s);
+
+	// Each quarter turn swaps sine and cosine and changes one of their signs
+	if(q & 1) {
+		float temp = sine;
+		sine = cosine;
+		cosine = -temp;
+	}
+	sinOut = (q & 2) ? -sine : sine;
+	cosOut = (q & 2) ? -cosine : cosine;
+}
+
+// Sine of x (radians)
+inline float fastSin(float x)
+{
+	using namespace fastmath;
+
+	float r;
+	int q = reduceQuadrant(x, r);
+	float s = r * r;
+	float out = (q & 1) ? cosPolynomial(s) : sinPolynomial(r, s);
+	return (q & 2) ? -out : out;
+}
+
+// Cosine of x (radians): the sine a quarter turn later
+inline float fastCos(float x)
+{
+	using namespace fastmath;
+
+	float r;
+	int q = reduceQuadrant(x, r) + 1;
+	float s = r * r;
+	float out = (q & 1) ? cosPolynomial(s) : sinPolynomial(r, s);
+	return (q & 2) ? -out : out;
+}
+
+// Tangent of x (radians). Odd quadrants give -cos(r) / sin(r).
+inline float fastTan(float x)
+{
+	using namespace fastmath;
+
+	float r;
+	int q = reduceQuadrant(x, r);
+	float s = r * r;
+	float sine = sinPolynomial(r, s);
+	float cosine = cosPolynomial(s);
+	return (q & 1) ? -cosine / sine : sine / cosine;
+}
+
+// base to the power x, for base > 0
+inline float fastPow(float base, float x)
+{
+	return fastExp2(x * fastLog2(base));
+}
+
+// Convert a level in decibels to a linear gain
+inline float dbToGain(float db)
+{
+	return fastExp2(db * fastmath::kLog2Of10Over20);
+}
+
+// Convert a (possibly fractional) MIDI note number to a frequency in Hz
+inline float midiToHz(float note)
+{
+	return 440.0f * fastExp2((note - 69.0f) * fastmath::kOneTwelfth);
+}
+
+// Four values at a time. Each function follows the same steps as the
+// single-value version above.
+namespace fastmath {
+#if defined(DSPCORE_FASTMATH_NEON)
+	typedef float32x4_t Float4;
+
+	inline Float4 load4(const float *p) { return vld1q_f32(p); }
+	inline void store4(float *p, Float4 v) { vst1q_f32(p, v); }
+	inline Float4 set4(float v) { return vdupq_n_f32(v); }
+	inline Float4 set4(float a, float b, float c, float d) {
+		Float4 v = vdupq_n_f32(a);
+		v = vsetq_lane_f32(b, v, 1);
+		v = vsetq_lane_f32(c, v, 2);
+		return vsetq_lane_f32(d, v, 3);
+	}
+	inline Float4 mul4(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+	inline Float4 add4(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+	inline Float4 madd4(Float4 a, Float4 b, float c) { return vmlaq_f32(vdupq_n_f32(c), a, b); }
+
+	inline Float4 exp2x4(Float4 x) {
+		x = vmaxq_f32(vminq_f32(x, vdupq_n_f32(kExp2Max)), vdupq_n_f32(kExp2Min));
+		int32x4_t i = vcvtq_s32_f32(x);
+		// Conversion rounds towards zero: subtract 1 where that rounded up
+		uint32x4_t roundedUp = vcgtq_f32(vcvtq_f32_s32(i), x);
+		i = vaddq_s32(i, vreinterpretq_s32_u32(roundedUp));
+		Float4 f = vsubq_f32(x, vcvtq_f32_s32(i));
+		Float4 p = vdupq_n_f32(kExp2C5);
+		p = madd4(p, f, kExp2C4);
+		p = madd4(p, f, kExp2C3);
+		p = madd4(p, f, kExp2C2);
+		p = madd4(p, f, kExp2C1);
+		p = madd4(p, f, kExp2C0);
+		int32x4_t scale = vshlq_n_s32(vaddq_s32(i, vdupq_n_s32(127)), 23);
+		return vmulq_f32(p, vreinterpretq_f32_s32(scale));
+	}
+
+	inline Float4 log2x4(Float4 x) {
+		uint32x4_t bits = vreinterpretq_u32_f32(x);
+		int32x4_t e = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(127));
+		Float4 m = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007FFFFF)),
+												   vdupq_n_u32(0x3F800000)));
+		uint32x4_t high = vcgtq_f32(m, vdupq_n_f32((float)M_SQRT2));
+		m = vbslq_f32(high, vmulq_f32(m, vdupq_n_f32(0.5f)), m);
+		e = vsubq_s32(e, vreinterpretq_s32_u32(high));
+		Float4 u = vsubq_f32(m, vdupq_n_f32(1.0f));
+		Float4 p = vdupq_n_f32(kLog2C6);
+		p = madd4(p, u, kLog2C5);
+		p = madd4(p, u, kLog2C4);
+		p = madd4(p, u, kLog2C3);
+		p = madd4(p, u, kLog2C2);
+		p = madd4(p, u, kLog2C1);
+		p = madd4(p, u, kLog2C0);
+		return vmlaq_f32(vcvtq_f32_s32(e), u, p);
+	}
+
+	typedef int32x4_t Int4;
+
+	inline Float4 sub4(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+	inline Float4 min4(Float4 a, Float4 b) { return vminq_f32(a, b); }
+	inline Float4 max4(Float4 a, Float4 b) { return vmaxq_f32(a, b); }
+	// x minus its whole part, for x >= 0 (conversion rounds towards zero)
+	inline Float4 fraction4(Float4 x) { return vsubq_f32(x, vcvtq_f32_s32(vcvtq_s32_f32(x))); }
+	inline Int4 plusOne4(Int4 q) { return vaddq_s32(q, vdupq_n_s32(1)); }
+
+	// Whole numbers, for example fixed-point phases. Additions wrap round.
+	inline Int4 loadInt4(const int32_t *p) { return vld1q_s32(p); }
+	inline void storeInt4(int32_t *p, Int4 v) { vst1q_s32(p, v); }
+	inline Int4 setInt4(int32_t v) { return vdupq_n_s32(v); }
+	inline Int4 addInt4(Int4 a, Int4 b) { return vaddq_s32(a, b); }
+	inline Int4 andInt4(Int4 a, Int4 b) { return vandq_s32(a, b); }
+	template<int kBits> inline Int4 shiftRightUnsigned4(Int4 q) {
+		return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(q), kBits));
+	}
+	inline Int4 toInt4(Float4 x) { return vcvtq_s32_f32(x); }		// Rounds towards zero
+	inline Float4 toFloat4(Int4 q) { return vcvtq_f32_s32(q); }
+	inline Int4 orInt4(Int4 a, Int4 b) { return vorrq_s32(a, b); }
+	inline Int4 xorInt4(Int4 a, Int4 b) { return veorq_s32(a, b); }
+	template<int kBits> inline Int4 shiftLeft4(Int4 q) { return vshlq_n_s32(q, kBits); }
+	inline Float4 bitsToFloat4(Int4 q) { return vreinterpretq_f32_s32(q); }
+
+	// ARMv7 has no vector divide: refine the reciprocal estimate twice
+	inline Float4 div4(Float4 a, Float4 b) {
+		Float4 inverse = vrecpeq_f32(b);
+		inverse = vmulq_f32(inverse, vrecpsq_f32(b, inverse));
+		inverse = vmulq_f32(inverse, vrecpsq_f32(b, inverse));
+		return vmulq_f32(a, inverse);
+	}
+
+	inline Int4 reduceQuadrant4(Float4 x, Float4& r) {
+		Float4 qf = vmlaq_f32(vdupq_n_f32(0.5f), x, vdupq_n_f32(kTwoOverPi));
+		int32x4_t q = vcvtq_s32_f32(qf);
+		uint32x4_t roundedUp = vcgtq_f32(vcvtq_f32_s32(q), qf);
+		q = vaddq_s32(q, vreinterpretq_s32_u32(roundedUp));
+		Float4 fq = vcvtq_f32_s32(q);
+		r = vmlsq_f32(x, fq, vdupq_n_f32(kPiOver2A));
+		r = vmlsq_f32(r, fq, vdupq_n_f32(kPiOver2B));
+		r = vmlsq_f32(r, fq, vdupq_n_f32(kPiOver2C));
+		return q;
+	}
+
+	// a where q is odd, b where it is even
+	inline Float4 selectOdd4(Int4 q, Float4 a, Float4 b) {
+		return vbslq_f32(vtstq_s32(q, vdupq_n_s32(1)), a, b);
+	}
+
+	// Flip the sign of v where bit 1 of q is set
+	inline Float4 negateHalf4(Int4 q, Float4 v) {
+		uint32x4_t sign = vshlq_n_u32(vandq_u32(vreinterpretq_u32_s32(q), vdupq_n_u32(2)), 30);
+		return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), sign));
+	}
+#elif defined(DSPCORE_FASTMATH_SSE2)
+	typedef __m128 Float4;
+
+	inline Float4 load4(const float *p) { return _mm_loadu_ps(p); }
+	inline void store4(float *p, Float4 v) { _mm_storeu_ps(p, v); }
+	inline Float4 set4(float v) { return _mm_set1_ps(v); }
+	inline Float4 set4(float a, float b, float c, float d) { return _mm_setr_ps(a, b, c, d); }
+	inline Float4 mul4(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+	inline Float4 add4(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+	inline Float4 madd4(Float4 a, Float4 b, float c) { return _mm_add_ps(_mm_mul_ps(a, b), _mm_set1_ps(c)); }
+
+	inline Float4 exp2x4(Float4 x) {
+		x = _mm_max_ps(_mm_min_ps(x, _mm_set1_ps(kExp2Max)), _mm_set1_ps(kExp2Min));
+		__m128i i = _mm_cvttps_epi32(x);
+		// Conversion rounds towards zero: subtract 1 where that rounded up
+		__m128 roundedUp = _mm_cmpgt_ps(_mm_cvtepi32_ps(i), x);
+		i = _mm_add_epi32(i, _mm_castps_si128(roundedUp));
+		Float4 f = _mm_sub_ps(x, _mm_cvtepi32_ps(i));
+		Float4 p = _mm_set1_ps(kExp2C5);
+		p = madd4(p, f, kExp2C4);
+		p = madd4(p, f, kExp2C3);
+		p = madd4(p, f, kExp2C2);
+		p = madd4(p, f, kExp2C1);
+		p = madd4(p, f, kExp2C0);
+		__m128i scale = _mm_slli_epi32(_mm_add_epi32(i, _mm_set1_epi32(127)), 23);
+		return _mm_mul_ps(p, _mm_castsi128_ps(scale));
+	}
+
+	inline Float4 log2x4(Float4 x) {
+		__m128i bits = _mm_castps_si128(x);
+		__m128i e = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+		Float4 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)),
+												 _mm_set1_epi32(0x3F800000)));
+		__m128 high = _mm_cmpgt_ps(m, _mm_set1_ps((float)M_SQRT2));
+		m = _mm_or_ps(_mm_and_ps(high, _mm_mul_ps(m, _mm_set1_ps(0.5f))), _mm_andnot_ps(high, m));
+		e = _mm_sub_epi32(e, _mm_castps_si128(high));
+		Float4 u = _mm_sub_ps(m, _mm_set1_ps(1.0f));
+		Float4 p = _mm_set1_ps(kLog2C6);
+		p = madd4(p, u, kLog2C5);
+		p = madd4(p, u, kLog2C4);
+		p = madd4(p, u, kLog2C3);
+		p = madd4(p, u, kLog2C2);
+		p = madd4(p, u, kLog2C1);
+		p = madd4(p, u, kLog2C0);
+		return _mm_add_ps(_mm_cvtepi32_ps(e), _mm_mul_ps(u, p));
+	}
+
+	typedef __m128i Int4;
+
+	inline Float4 sub4(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+	inline Float4 min4(Float4 a, Float4 b) { return _mm_min_ps(a, b); }
+	inline Float4 max4(Float4 a, Float4 b) { return _mm_max_ps(a, b); }
+	inline Float4 fraction4(Float4 x) { return _mm_sub_ps(x, _mm_cvtepi32_ps(_mm_cvttps_epi32(x))); }
+	inline Int4 plusOne4(Int4 q) { return _mm_add_epi32(q, _mm_set1_epi32(1)); }
+
+	inline Int4 loadInt4(const int32_t *p) { return _mm_loadu_si128((const __m128i *)p); }
+	inline void storeInt4(int32_t *p, Int4 v) { _mm_storeu_si128((__m128i *)p, v); }
+	inline Int4 setInt4(int32_t v) { return _mm_set1_epi32(v); }
+	inline Int4 addInt4(Int4 a, Int4 b) { return _mm_add_epi32(a, b); }
+	inline Int4 andInt4(Int4 a, Int4 b) { return _mm_and_si128(a, b); }
+	template<int kBits> inline Int4 shiftRightUnsigned4(Int4 q) { return _mm_srli_epi32(q, kBits); }
+	inline Int4 toInt4(Float4 x) { return _mm_cvttps_epi32(x); }
+	inline Float4 toFloat4(Int4 q) { return _mm_cvtepi32_ps(q); }
+	inline Int4 orInt4(Int4 a, Int4 b) { return _mm_or_si128(a, b); }
+	inline Int4 xorInt4(Int4 a, Int4 b) { return _mm_xor_si128(a, b); }
+	template<int kBits> inline Int4 shiftLeft4(Int4 q) { return _mm_slli_epi32(q, kBits); }
+	inline Float4 bitsToFloat4(Int4 q) { return _mm_castsi128_ps(q); }
+	inline Float4 div4(Float4 a, Float4 b) { return _mm_div_ps(a, b); }
+
+	inline Int4 reduceQuadrant4(Float4 x, Float4& r) {
+		Float4 qf = madd4(x, _mm_set1_ps(kTwoOverPi), 0.5f);
+		__m128i q = _mm_cvttps_epi32(qf);
+		__m128 roundedUp = _mm_cmpgt_ps(_mm_cvtepi32_ps(q), qf);
+		q = _mm_add_epi32(q, _mm_castps_si128(roundedUp));
+		Float4 fq = _mm_cvtepi32_ps(q);
+		r = _mm_sub_ps(x, _mm_mul_ps(fq, _mm_set1_ps(kPiOver2A)));
+		r = _mm_sub_ps(r, _mm_mul_ps(fq, _mm_set1_ps(kPiOver2B)));
+		r = _mm_sub_ps(r, _mm_mul_ps(fq, _mm_set1_ps(kPiOver2C)));
+		return q;
+	}
+
+	// a where q is odd, b where it is even
+	inline Float4 selectOdd4(Int4 q, Float4 a, Float4 b) {
+		__m128i one = _mm_set1_epi32(1);
+		__m128 odd = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one));
+		return _mm_or_ps(_mm_and_ps(odd, a), _mm_andnot_ps(odd, b));
+	}
+
+	// Flip the sign of v where bit 1 of q is set
+	inline Float4 negateHalf4(Int4 q, Float4 v) {
+		__m128i sign = _mm_slli_epi32(_mm_and_si128(q, _mm_set1_epi32(2)), 30);
+		return _mm_xor_ps(v, _mm_castsi128_ps(sign));
+	}
+#endif
+
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	inline Float4 sinPolynomial4(Float4 r, Float4 s) {
+		Float4 p = set4(kSinS4);
+		p = madd4(p, s, kSinS3);
+		p = madd4(p, s, kSinS2);
+		p = madd4(p, s, kSinS1);
+		return add4(r, mul4(mul4(r, s), p));
+	}
+
+	inline Float4 cosPolynomial4(Float4 s) {
+		Float4 p = set4(kCosC4);
+		p = madd4(p, s, kCosC3);
+		p = madd4(p, s, kCosC2);
+		p = madd4(p, s, kCosC1);
+		return madd4(s, p, 1.0f);
+	}
+
+	inline void sinCosx4(Float4 x, Float4& sinOut, Float4& cosOut) {
+		Float4 r;
+		Int4 q = reduceQuadrant4(x, r);
+		Float4 s = mul4(r, r);
+		Float4 sine = sinPolynomial4(r, s);
+		Float4 cosine = cosPolynomial4(s);
+		sinOut = negateHalf4(q, selectOdd4(q, cosine, sine));
+		cosOut = negateHalf4(plusOne4(q), selectOdd4(q, sine, cosine));
+	}
+
+	inline Float4 sinx4(Float4 x) {
+		Float4 r;
+		Int4 q = reduceQuadrant4(x, r);
+		Float4 s = mul4(r, r);
+		return negateHalf4(q, selectOdd4(q, cosPolynomial4(s), sinPolynomial4(r, s)));
+	}
+
+	inline Float4 cosx4(Float4 x) {
+		Float4 r;
+		Int4 q = plusOne4(reduceQuadrant4(x, r));
+		Float4 s = mul4(r, r);
+		return negateHalf4(q, selectOdd4(q, cosPolynomial4(s), sinPolynomial4(r, s)));
+	}
+
+	inline Float4 tanx4(Float4 x) {
+		Float4 r;
+		Int4 q = reduceQuadrant4(x, r);
+		Float4 s = mul4(r, r);
+		Float4 sine = sinPolynomial4(r, s);
+		Float4 cosine = cosPolynomial4(s);
+		Float4 numerator = selectOdd4(q, sub4(set4(0.0f), cosine), sine);
+		return div4(numerator, selectOdd4(q, sine, cosine));
+	}
+#endif
+}
+
+// Whole-buffer versions. Input and output may be the same buffer, but must
+// not otherwise overlap.
+
+// output[n] = 2 ^ input[n]
+inline void fastExp2(const float *input, float *output, unsigned int count)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	for(; n + 4 <= count; n += 4)
+		fastmath::store4(output + n, fastmath::exp2x4(fastmath::load4(input + n)));
+#endif
+	for(; n < count; n++)
+		output[n] = fastExp2(input[n]);
+}
+
+// output[n] = log2(input[n])
+inline void fastLog2(const float *input, float *output, unsigned int count)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	for(; n + 4 <= count; n += 4)
+		fastmath::store4(output + n, fastmath::log2x4(fastmath::load4(input + n)));
+#endif
+	for(; n < count; n++)
+		output[n] = fastLog2(input[n]);
+}
+
+// output[n] = base[n] ^ exponent[n]
+inline void fastPow(const float *base, const float *exponent, float *output, unsigned int count)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	for(; n + 4 <= count; n += 4)
+		store4(output + n, exp2x4(mul4(load4(exponent + n), log2x4(load4(base + n)))));
+#endif
+	for(; n < count; n++)
+		output[n] = fastPow(base[n], exponent[n]);
+}
+
+// Convert a buffer of levels in decibels to linear gains
+inline void dbToGain(const float *db, float *output, unsigned int count)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	for(; n + 4 <= count; n += 4)
+		store4(output + n, exp2x4(mul4(load4(db + n), set4(kLog2Of10Over20))));
+#endif
+	for(; n < count; n++)
+		output[n] = dbToGain(db[n]);
+}
+
+// Convert a buffer of MIDI note numbers to frequencies in Hz
+inline void midiToHz(const float *notes, float *output, unsigned int count)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	for(; n + 4 <= count; n += 4) {
+		Float4 octaves = mul4(add4(load4(notes + n), set4(-69.0f)), set4(kOneTwelfth));
+		store4(output + n, mul4(exp2x4(octaves), set4(440.0f)));
+	}
+#endif
+	for(; n < count; n++)
+		output[n] = midiToHz(notes[n]);
+}
+
+// output[n] = sin(input[n])
+inline void fastSin(const float *input, float *output, unsigned int count)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	for(; n + 4 <= count; n += 4)
+		fastmath::store4(output + n, fastmath::sinx4(fastmath::load4(input + n)));
+#endif
+	for(; n < count; n++)
+		output[n] = fastSin(input[n]);
+}
+
+// output[n] = cos(input[n])
+inline void fastCos(const float *input, float *output, unsigned int count)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	for(; n + 4 <= count; n += 4)
+		fastmath::store4(output + n, fastmath::cosx4(fastmath::load4(input + n)));
+#endif
+	for(; n < count; n++)
+		output[n] = fastCos(input[n]);
+}
+
+// output[n] = tan(input[n])
+inline void fastTan(const float *input, float *output, unsigned int count)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	for(; n + 4 <= count; n += 4)
+		fastmath::store4(output + n, fastmath::tanx4(fastmath::load4(input + n)));
+#endif
+	for(; n < count; n++)
+		output[n] = fastTan(input[n]);
+}
+
+// sinOutput[n] = sin(input[n]), cosOutput[n] = cos(input[n])
+inline void fastSinCos(const float *input, float *sinOutput, float *cosOutput, unsigned int count)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	for(; n + 4 <= count; n += 4) {
+		Float4 sine, cosine;
+		sinCosx4(load4(input + n), sine, cosine);
+		store4(sinOutput + n, sine);
+		store4(cosOutput + n, cosine);
+	}
+#endif
+	for(; n < count; n++)
+		fastSinCos(input[n], sinOutput[n], cosOutput[n]);
+}
+
+} // namespace dsp
+
+using dsp::fastExp2;
+using dsp::fastLog2;
+using dsp::fastPow;
+using dsp::dbToGain;
+using dsp::midiToHz;
+using dsp::fastSin;
+using dsp::fastCos;
+using dsp::fastTan;
+using dsp::fastSinCos;
\ No newline at end of file
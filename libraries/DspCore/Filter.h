@@ -0,0 +1,156 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// Filter.h: second-order resonant lowpass filter of variable frequency and Q,
+// defined entirely in this header so that process() can be inlined
+
+#pragma once
+
+#include <cmath>
+
+namespace dsp {
+
+class Filter {
+
+public:
+	// Constructor
+	Filter() : Filter(44100.0) {}
+
+	// Constructor specifying a sample rate
+	Filter(float sampleRate) {
+		setSampleRate(sampleRate);
+		reset();
+	}
+
+	// Set the sample rate, used for all calculations
+	void setSampleRate(float rate) {
+		sampleRate_ = rate;
+		if(ready_)
+			calculateCoefficients(frequency_, q_);
+	}
+
+	// Set the frequency and recalculate coefficients
+	void setFrequency(float frequency) {
+		frequency_ = frequency;
+		calculateCoefficients(frequency_, q_);
+	}
+
+	// Set the Q and recalculate the coefficients
+	void setQ(float q) {
+		q_ = q;
+		calculateCoefficients(frequency_, q_);
+	}
+
+	// The coefficients b0, b1, b2, a1, a2, for processing the same filter
+	// elsewhere, such as in assembly language
+	const float* getCoefficients() { return coefficients_; }
+
+	// Reset previous history of filter
+	void reset() {
+		lastX_[0] = lastX_[1] = 0;
+		lastY_[0] = lastY_[1] = 0;
+	}
+
+	// Calculate the next sample of output
+	inline float process(float input);
+
+	// Filter a buffer of frames samples. The input and output must not overlap.
+	inline void process(const float * __restrict input, float * __restrict output, unsigned int frames);
+
+	// Destructor
+	~Filter() {}
+
+private:
+	// Calculate coefficients
+	inline void calculateCoefficients(float frequency, float q);
+
+	// State variables, not accessible to the outside world
+	bool ready_ = false;	// Have the coefficients been calculated?
+	float sampleRate_ = 44100.0;
+	float frequency_ = 1000.0;
+	float q_ = 0.707;
+	alignas(16) float coefficients_[5];		// b0, b1, b2, a1, a2
+	alignas(8) float lastX_[2];
+	alignas(8) float lastY_[2];
+};
+
+// Calculate coefficients. This is the same bilinear transform as the
+// lectures, with w^2 and t^2 worked out once instead of with pow(). The
+// coefficients are the same as the lectures' to within rounding, not bit
+// for bit, as they are now worked out in double precision.
+inline void Filter::calculateCoefficients(float frequency, float q)
+{
+	// Helper variables
+	double w = frequency * 2.0 * M_PI;
+	double t = 1.0 / sampleRate_;
+	double w2t2 = (w * w) * (t * t);
+	double a0 = 4.0 + ((w/q)*2.0*t) + w2t2;
+
+	// Calculate coefficients
+	coefficients_[0] = coefficients_[2] = w2t2 / a0;
+	coefficients_[1] = 2.0 * w2t2 / a0;
+	coefficients_[3] = (2.0 * w2t2 - 8.0) / a0;
+	coefficients_[4] = (4.0 - (w/q*2.0*t) + w2t2) / a0;
+
+	ready_ = true;
+}
+
+// Calculate the next sample of output
+inline float Filter::process(float input)
+{
+	if(!ready_)
+		return input;
+
+	float out = input * coefficients_[0] + lastX_[0] * coefficients_[1] + lastX_[1] * coefficients_[2]
+				- lastY_[0] * coefficients_[3] - lastY_[1] * coefficients_[4];
+
+	lastX_[1] = lastX_[0];
+	lastX_[0] = input;
+	lastY_[1] = lastY_[0];
+	lastY_[0] = out;
+
+	return out;
+}
+
+// Filter a buffer, keeping the history in local variables during the loop
+inline void Filter::process(const float * __restrict input, float * __restrict output, unsigned int frames)
+{
+	if(!ready_) {
+		for(unsigned int n = 0; n < frames; n++)
+			output[n] = input[n];
+		return;
+	}
+
+	const float b0 = coefficients_[0], b1 = coefficients_[1], b2 = coefficients_[2];
+	const float a1 = coefficients_[3], a2 = coefficients_[4];
+	float x1 = lastX_[0], x2 = lastX_[1];
+	float y1 = lastY_[0], y2 = lastY_[1];
+
+	for(unsigned int n = 0; n < frames; n++) {
+		float x = input[n];
+		float y = x * b0 + x1 * b1 + x2 * b2 - y1 * a1 - y2 * a2;
+		x2 = x1;
+		x1 = x;
+		y2 = y1;
+		y1 = y;
+		output[n] = y;
+	}
+
+	lastX_[0] = x1;
+	lastX_[1] = x2;
+	lastY_[0] = y1;
+	lastY_[1] = y2;
+}
+
+} // namespace dsp
+
+using dsp::Filter;
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// FilterQ31.h: the biquad filter from Filter.h in fixed point, for Q31
+// samples. The coefficients are worked out by a Filter and converted to
+// Q28 (range -8 to 8, since a1 can be close to -2), and each output is added
+// up in 64 bits, which is SMULL and SMLAL on ARM. Nothing is lost until the
+// sum is rounded back to Q31, so the noise added is about 2^-32, far below
+// that of a float filter.
+
+#pragma once
+
+#include <cstdint>
+#include "FixedPoint.h"
+#include "Filter.h"
+
+namespace dsp {
+
+class FilterQ31 {
+public:
+	static const int kCoefficientBits = 28;		// Fraction bits of the coefficients
+
+	// Constructor
+	FilterQ31() : FilterQ31(44100.0) {}
+
+	// Constructor specifying a sample rate
+	FilterQ31(float sampleRate) : design_(sampleRate) {
+		reset();
+	}
+
+	// Set the sample rate, used for all calculations
+	void setSampleRate(float rate) {
+		design_.setSampleRate(rate);
+		if(ready_)
+			convertCoefficients();
+	}
+
+	// Set the frequency and recalculate coefficients
+	void setFrequency(float frequency) {
+		design_.setFrequency(frequency);
+		convertCoefficients();
+	}
+
+	// Set the Q and recalculate the coefficients
+	void setQ(float q) {
+		design_.setQ(q);
+		convertCoefficients();
+	}
+
+	// Reset previous history of filter
+	void reset() {
+		lastX_[0] = lastX_[1] = 0;
+		lastY_[0] = lastY_[1] = 0;
+	}
+
+	// Calculate the next sample of output
+	inline Q31 process(Q31 input);
+
+	// Filter a buffer of frames samples. The input and output must not overlap.
+	inline void process(const Q31 * __restrict input, Q31 * __restrict output, unsigned int frames);
+
+	// Destructor
+	~FilterQ31() {}
+
+private:
+	// Convert the float coefficients of the design to fixed point
+	void convertCoefficients() {
+		const float *coefficients = design_.getCoefficients();
+		for(unsigned int i = 0; i < 5; i++)
+			coefficients_[i] = (int32_t)lrint(coefficients[i] * (double)(1 << kCoefficientBits));
+		ready_ = true;
+	}
+
+	// Round a sum of products back to Q31
+	static Q31 round(int64_t sum) {
+		return Q31::fromRaw(fixedpoint::saturate32((sum + (1LL << (kCoefficientBits - 1))) >> kCoefficientBits));
+	}
+
+	Filter design_;					// Works out the coefficients
+	bool ready_ = false;			// Have the coefficients been calculated?
+	int32_t coefficients_[5];		// b0, b1, b2, a1, a2 in Q28
+	int32_t lastX_[2];
+	int32_t lastY_[2];
+};
+
+// Calculate the next sample of output
+inline Q31 FilterQ31::process(Q31 input)
+{
+	if(!ready_)
+		return input;
+
+	int32_t x = input.raw();
+	int64_t sum = (int64_t)x * coefficients_[0] + (int64_t)lastX_[0] * coefficients_[1]
+				+ (int64_t)lastX_[1] * coefficients_[2] - (int64_t)lastY_[0] * coefficients_[3]
+				- (int64_t)lastY_[1] * coefficients_[4];
+	Q31 out = round(sum);
+
+	lastX_[1] = lastX_[0];
+	lastX_[0] = x;
+	lastY_[1] = lastY_[0];
+	lastY_[0] = out.raw();
+
+	return out;
+}
+
+// Filter a buffer, keeping the history in local variables during the loop
+inline void FilterQ31::process(const Q31 * __restrict input, Q31 * __restrict output, unsigned int frames)
+{
+	if(!ready_) {
+		for(unsigned int n = 0; n < frames; n++)
+			output[n] = input[n];
+		return;
+	}
+
+	const int32_t b0 = coefficients_[0], b1 = coefficients_[1], b2 = coefficients_[2];
+	const int32_t a1 = coefficients_[3], a2 = coefficients_[4];
+	int32_t x1 = lastX_[0], x2 = lastX_[1];
+	int32_t y1 = lastY_[0], y2 = lastY_[1];
+
+	for(unsigned int n = 0; n < frames; n++) {
+		int32_t x = input[n].raw();
+		int64_t sum = (int64_t)x * b0 + (int64_t)x1 * b1 + (int64_t)x2 * b2
+					- (int64_t)y1 * a1 - (int64_t)y2 * a2;
+		int32_t y = round(sum).raw();
+		x2 = x1;
+		x1 = x;
+		y2 = y1;
+		y1 = y;
+		output[n] = Q31::fromRaw(y);
+	}
+
+	lastX_[0] = x1;
+	lastX_[1] = x2;
+	lastY_[0] = y1;
+	lastY_[1] = y2;
+}
+
+} // namespace dsp
+
+using dsp::FilterQ31;
\ No newline at end of file
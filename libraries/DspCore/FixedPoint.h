@@ -0,0 +1,280 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// FixedPoint.h: Q15 and Q31 fixed-point numbers, for processors without a
+// fast floating-point unit and for code that needs results which are exactly
+// the same on every platform. A Q15 holds a value from -1 to just under 1 in
+// 16 bits (steps of 1/32768), and a Q31 does the same in 32 bits.
+//
+// Additions, subtractions and multiplications saturate: a result beyond the
+// range is held at the largest or smallest value instead of wrapping round.
+// Multiplications and right shifts round to the nearest step. On ARMv7 the
+// operations use the DSP instructions built for this (QADD, QSUB, SSAT and
+// SMULWB), and elsewhere plain integer code which gives the same results,
+// bit for bit.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#if defined(__arm__) && defined(__ARM_FEATURE_DSP)
+#define DSPCORE_FIXEDPOINT_ARM
+#endif
+
+namespace dsp {
+
+namespace fixedpoint {
+
+// Limit a value to the range of 16 bits
+inline int32_t saturate16(int32_t x)
+{
+#if defined(DSPCORE_FIXEDPOINT_ARM)
+	int32_t result;
+	asm("ssat %0, #16, %1" : "=r"(result) : "r"(x));
+	return result;
+#else
+	return x > INT16_MAX ? INT16_MAX : (x < INT16_MIN ? INT16_MIN : x);
+#endif
+}
+
+// Limit a value to the range of 32 bits
+inline int32_t saturate32(int64_t x)
+{
+	return x > INT32_MAX ? INT32_MAX : (x < INT32_MIN ? INT32_MIN : (int32_t)x);
+}
+
+// a + b, saturating
+inline int32_t addSaturate(int32_t a, int32_t b)
+{
+#if defined(DSPCORE_FIXEDPOINT_ARM)
+	int32_t result;
+	asm("qadd %0, %1, %2" : "=r"(result) : "r"(a), "r"(b));
+	return result;
+#else
+	return saturate32((int64_t)a + b);
+#endif
+}
+
+// a - b, saturating
+inline int32_t subtractSaturate(int32_t a, int32_t b)
+{
+#if defined(DSPCORE_FIXEDPOINT_ARM)
+	int32_t result;
+	asm("qsub %0, %1, %2" : "=r"(result) : "r"(a), "r"(b));
+	return result;
+#else
+	return saturate32((int64_t)a - b);
+#endif
+}
+
+// (a * b) >> 16, rounding down, where b is 16 bits
+inline int32_t multiplyWordByHalf(int32_t a, int16_t b)
+{
+#if defined(DSPCORE_FIXEDPOINT_ARM)
+	int32_t result;
+	asm("smulwb %0, %1, %2" : "=r"(result) : "r"(a), "r"((int32_t)b));
+	return result;
+#else
+	return (int32_t)(((int64_t)a * b) >> 16);
+#endif
+}
+
+} // namespace fixedpoint
+
+// A number from -1 to 1 - 2^-15 in 16 bits
+class Q15 {
+public:
+	static const int kFractionBits = 15;
+
+	// Zero
+	constexpr Q15() : value_(0) {}
+
+	// From the raw 16-bit value, where 32767 means 32767/32768
+	static constexpr Q15 fromRaw(int16_t raw) { return Q15(raw, 0); }
+
+	// From a float, rounding to the nearest step and saturating
+	static Q15 fromFloat(float x) {
+		float scaled = x * 32768.0f;
+		if(scaled >= 32767.0f)
+			return fromRaw(INT16_MAX);
+		if(scaled <= -32768.0f)
+			return fromRaw(INT16_MIN);
+		return fromRaw((int16_t)lrintf(scaled));
+	}
+
+	// The largest and smallest values
+	static constexpr Q15 max() { return fromRaw(INT16_MAX); }
+	static constexpr Q15 min() { return fromRaw(INT16_MIN); }
+
+	// The raw 16-bit value
+	constexpr int16_t raw() const { return value_; }
+
+	// Convert to float, which is exact
+	float toFloat() const { return value_ * (1.0f / 32768.0f); }
+
+	// Saturating arithmetic
+	Q15 operator+(Q15 other) const { return fromRaw(fixedpoint::saturate16((int32_t)value_ + other.value_)); }
+	Q15 operator-(Q15 other) const { return fromRaw(fixedpoint::saturate16((int32_t)value_ - other.value_)); }
+	Q15 operator-() const { return fromRaw(fixedpoint::saturate16(-(int32_t)value_)); }
+
+	// Rounded product. Only -1 * -1 saturates. The 16 x 16 bit multiply is a
+	// single SMULBB on ARM.
+	Q15 operator*(Q15 other) const {
+		int32_t product = (int32_t)value_ * other.value_;
+		return fromRaw(fixedpoint::saturate16((product + (1 << 14)) >> 15));
+	}
+
+	// Divide by 2^shift, rounding to the nearest step
+	Q15 operator>>(int shift) const {
+		if(shift <= 0)
+			return *this;
+		return fromRaw(((int32_t)value_ + (1 << (shift - 1))) >> shift);
+	}
+
+	// Multiply by 2^shift (up to 15), saturating
+	Q15 operator<<(int shift) const {
+		return fromRaw(fixedpoint::saturate16((int32_t)value_ * (1 << shift)));
+	}
+
+	Q15& operator+=(Q15 other) { return *this = *this + other; }
+	Q15& operator-=(Q15 other) { return *this = *this - other; }
+	Q15& operator*=(Q15 other) { return *this = *this * other; }
+
+	constexpr bool operator==(Q15 other) const { return value_ == other.value_; }
+	constexpr bool operator!=(Q15 other) const { return value_ != other.value_; }
+	constexpr bool operator<(Q15 other) const { return value_ < other.value_; }
+	constexpr bool operator>(Q15 other) const { return value_ > other.value_; }
+
+private:
+	constexpr Q15(int16_t raw, int) : value_(raw) {}
+
+	int16_t value_;
+};
+
+// A number from -1 to 1 - 2^-31 in 32 bits
+class Q31 {
+public:
+	static const int kFractionBits = 31;
+
+	// Zero
+	constexpr Q31() : value_(0) {}
+
+	// From the raw 32-bit value, where 2^30 means 0.5
+	static constexpr Q31 fromRaw(int32_t raw) { return Q31(raw, 0); }
+
+	// From a float, rounding to the nearest step and saturating. A float has
+	// 24 bits of precision, so the lowest 7 or more bits are zero.
+	static Q31 fromFloat(float x) {
+		double scaled = x * 2147483648.0;
+		if(scaled >= 2147483647.0)
+			return fromRaw(INT32_MAX);
+		if(scaled <= -2147483648.0)
+			return fromRaw(INT32_MIN);
+		return fromRaw((int32_t)lrint(scaled));
+	}
+
+	// From a Q15, which is exact
+	static constexpr Q31 fromQ15(Q15 x) { return fromRaw((int32_t)x.raw() * 65536); }
+
+	// The largest and smallest values
+	static constexpr Q31 max() { return fromRaw(INT32_MAX); }
+	static constexpr Q31 min() { return fromRaw(INT32_MIN); }
+
+	// The raw 32-bit value
+	constexpr int32_t raw() const { return value_; }
+
+	// Convert to float, rounding to 24 bits of precision
+	float toFloat() const { return value_ * (1.0f / 2147483648.0f); }
+
+	// Convert to Q15, rounding to the nearest step and saturating
+	Q15 toQ15() const {
+		return Q15::fromRaw(fixedpoint::saturate16(((int64_t)value_ + (1 << 15)) >> 16));
+	}
+
+	// Saturating arithmetic
+	Q31 operator+(Q31 other) const { return fromRaw(fixedpoint::addSaturate(value_, other.value_)); }
+	Q31 operator-(Q31 other) const { return fromRaw(fixedpoint::subtractSaturate(value_, other.value_)); }
+	Q31 operator-() const { return fromRaw(fixedpoint::subtractSaturate(0, value_)); }
+
+	// Rounded product. Only -1 * -1 saturates. The 64-bit product is a single
+	// SMULL on ARM.
+	Q31 operator*(Q31 other) const {
+		int64_t product = (int64_t)value_ * other.value_;
+		return fromRaw(fixedpoint::saturate32((product + (1LL << 30)) >> 31));
+	}
+
+	// Product with a Q15, such as a gain. This is SMULWB, which rounds down,
+	// followed by a saturating doubling (QADD of the result to itself). The
+	// result can be 2^-31 below the exactly rounded product.
+	Q31 operator*(Q15 gain) const {
+		int32_t product = fixedpoint::multiplyWordByHalf(value_, gain.raw());
+		return fromRaw(fixedpoint::addSaturate(product, product));
+	}
+
+	// Divide by 2^shift, rounding to the nearest step
+	Q31 operator>>(int shift) const {
+		if(shift <= 0)
+			return *this;
+		return fromRaw((int32_t)(((int64_t)value_ + (1LL << (shift - 1))) >> shift));
+	}
+
+	// Multiply by 2^shift (up to 31), saturating
+	Q31 operator<<(int shift) const {
+		return fromRaw(fixedpoint::saturate32((int64_t)value_ * (1LL << shift)));
+	}
+
+	Q31& operator+=(Q31 other) { return *this = *this + other; }
+	Q31& operator-=(Q31 other) { return *this = *this - other; }
+	Q31& operator*=(Q31 other) { return *this = *this * other; }
+	Q31& operator*=(Q15 gain) { return *this = *this * gain; }
+
+	constexpr bool operator==(Q31 other) const { return value_ == other.value_; }
+	constexpr bool operator!=(Q31 other) const { return value_ != other.value_; }
+	constexpr bool operator<(Q31 other) const { return value_ < other.value_; }
+	constexpr bool operator>(Q31 other) const { return value_ > other.value_; }
+
+private:
+	constexpr Q31(int32_t raw, int) : value_(raw) {}
+
+	int32_t value_;
+};
+
+// Convert buffers between float and fixed point, for example at the start
+// and end of render()
+inline void toFixed(const float *input, Q15 *output, unsigned int count)
+{
+	for(unsigned int n = 0; n < count; n++)
+		output[n] = Q15::fromFloat(input[n]);
+}
+
+inline void toFixed(const float *input, Q31 *output, unsigned int count)
+{
+	for(unsigned int n = 0; n < count; n++)
+		output[n] = Q31::fromFloat(input[n]);
+}
+
+inline void toFloat(const Q15 *input, float *output, unsigned int count)
+{
+	for(unsigned int n = 0; n < count; n++)
+		output[n] = input[n].toFloat();
+}
+
+inline void toFloat(const Q31 *input, float *output, unsigned int count)
+{
+	for(unsigned int n = 0; n < count; n++)
+		output[n] = input[n].toFloat();
+}
+
+} // namespace dsp
+
+using dsp::Q15;
+using dsp::Q31;
\ No newline at end of file
@@ -0,0 +1,523 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// FmSynth.h: a polyphonic FM synth with 4 or 6 sine-wave operators per voice,
+// in the style of the Yamaha DX7.
+//
+// Each operator is a sine oscillator with its own frequency ratio, level and
+// ADSR. An algorithm says which operators modulate which, and which ones are
+// heard (carriers). Modulation is added to the phase of the operator being
+// modulated (phase modulation, which is what FM synths actually do), so the
+// sine table is read with a phase input. Phases are 32-bit integers which
+// wrap round by themselves: a modulator's output in radians is turned into a
+// phase offset and added in before the table is read.
+//
+// The voices are handled four at a time, one in each lane of a NEON or SSE2
+// register, so every operator of four voices costs about the same as one
+// operator of one voice. The envelopes are worked out every kControlPeriod
+// samples and ramped in between.
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include "FastMath.h"
+#include "ADSR.h"
+
+namespace dsp {
+
+namespace fm {
+	const unsigned int kMaxOperators = 6;
+
+	// Sine table of 2^kSineBits points, plus a copy of the first at the end
+	const unsigned int kSineBits = 10;
+	const unsigned int kSineSize = 1 << kSineBits;
+
+	// Read the sine table at a phase where 2^32 is a whole cycle. The top
+	// kSineBits are the index and the next 16 the fraction between points.
+	inline float sine(const float *table, uint32_t phase) {
+		uint32_t index = phase >> (32 - kSineBits);
+		float fraction = (float)((phase >> (16 - kSineBits)) & 0xFFFF) * (1.0f / 65536.0f);
+		return table[index] + fraction * (table[index + 1] - table[index]);
+	}
+
+	// Turn a modulation in radians into a phase offset. Whole cycles are
+	// removed first, then what is left (-1 to 1 cycles) is scaled by 2^30
+	// and multiplied by 4, wrapping round like the phase itself.
+	inline uint32_t phaseOffset(float radians) {
+		float cycles = radians * (float)(0.5 / M_PI);
+		cycles -= (float)(int)cycles;
+		return (uint32_t)(int32_t)(cycles * 1073741824.0f) * 4u;
+	}
+
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	// The same, four phases at a time. Neither NEON nor SSE2 can load from
+	// four different addresses at once, so the table points are read one
+	// by one.
+	inline fastmath::Float4 sine4(const float *table, fastmath::Int4 phase) {
+		using namespace fastmath;
+		int32_t index[4];
+		storeInt4(index, shiftRightUnsigned4<32 - kSineBits>(phase));
+		Float4 fraction = mul4(toFloat4(andInt4(shiftRightUnsigned4<16 - kSineBits>(phase), setInt4(0xFFFF))),
+							   set4(1.0f / 65536.0f));
+		Float4 below = set4(table[index[0]], table[index[1]], table[index[2]], table[index[3]]);
+		Float4 above = set4(table[index[0] + 1], table[index[1] + 1], table[index[2] + 1], table[index[3] + 1]);
+		return add4(below, mul4(fraction, sub4(above, below)));
+	}
+
+	inline fastmath::Int4 phaseOffset4(fastmath::Float4 radians) {
+		using namespace fastmath;
+		Float4 cycles = mul4(radians, set4((float)(0.5 / M_PI)));
+		cycles = sub4(cycles, toFloat4(toInt4(cycles)));
+		Int4 offset = toInt4(mul4(cycles, set4(1073741824.0f)));
+		offset = addInt4(offset, offset);
+		return addInt4(offset, offset);
+	}
+#endif
+}
+
+// Which operators modulate each operator, and which are heard. Operators are
+// numbered from 0 and can only be modulated by higher-numbered ones, so they
+// are worked out from the highest down; other bits are ignored.
+struct FmAlgorithm {
+	uint8_t modulators[fm::kMaxOperators];	// For operator i, bit j is set if operator j modulates it
+	uint8_t carriers;						// Bit i is set if operator i is heard
+	int8_t feedback;						// Operator which modulates itself, or -1 for none
+};
+
+namespace fm {
+	// Four operators
+	const FmAlgorithm kStack = {{0x02, 0x04, 0x08, 0, 0, 0}, 0x01, 3};			// 3 > 2 > 1 > 0
+	const FmAlgorithm kPairs = {{0x02, 0, 0x08, 0, 0, 0}, 0x05, 3};			// 1 > 0, 3 > 2
+	const FmAlgorithm kBranch = {{0x0e, 0, 0, 0, 0, 0}, 0x01, 3};			// 1, 2 and 3 > 0
+	const FmAlgorithm kAdditive = {{0, 0, 0, 0, 0, 0}, 0x0f, 3};			// All heard
+
+	// Six operators, numbered as on the DX7
+	const FmAlgorithm kDx7Algorithm1 = {{0x02, 0, 0x08, 0x10, 0x20, 0}, 0x05, 5};	// 1 > 0, 5 > 4 > 3 > 2
+	const FmAlgorithm kDx7Algorithm5 = {{0x02, 0, 0x08, 0, 0x20, 0}, 0x15, 5};		// 1 > 0, 3 > 2, 5 > 4
+	const FmAlgorithm kDx7Algorithm32 = {{0, 0, 0, 0, 0, 0}, 0x3f, 5};				// All heard
+}
+
+template<unsigned int kOperators>
+class FmSynth {
+public:
+	static_assert(kOperators >= 1 && kOperators <= fm::kMaxOperators, "FmSynth has 1 to 6 operators");
+
+	// The envelopes are worked out every kControlPeriod samples and ramped
+	// in between. A note starts at the next of these.
+	static const unsigned int kControlPeriod = 16;
+
+	FmSynth() { setDefaults(); }								// Default constructor
+	FmSynth(float sampleRate, unsigned int numVoices) {			// Constructor with arguments
+		setDefaults();
+		setup(sampleRate, numVoices);
+	}
+
+	// Make the voices, rounding the number up to a multiple of 4. This
+	// allocates memory, so call it from setup().
+	void setup(float sampleRate, unsigned int numVoices) {
+		sampleRate_ = sampleRate;
+		groups_.assign((numVoices + 3) / 4, Group());
+		sineTable_.resize(fm::kSineSize + 1);
+		for(unsigned int n = 0; n <= fm::kSineSize; n++)
+			sineTable_[n] = sinf(2.0 * M_PI * (double)n / fm::kSineSize);
+		for(Group& group : groups_)
+			for(unsigned int op = 0; op < kOperators; op++)
+				for(unsigned int lane = 0; lane < 4; lane++)
+					group.envelope[op][lane].setSampleRate(sampleRate / kControlPeriod);
+		for(unsigned int op = 0; op < kOperators; op++)
+			updateEnvelopes(op);
+		countdown_ = 0;
+		setAlgorithm(algorithm_);
+	}
+
+	// Choose how the operators are connected
+	void setAlgorithm(const FmAlgorithm& algorithm) {
+		algorithm_ = algorithm;
+		numCarriers_ = 0;
+		for(unsigned int op = 0; op < kOperators; op++) {
+			// Keep only modulators which exist and are numbered higher
+			algorithm_.modulators[op] &= ((1u << kOperators) - 1) & ~((2u << op) - 1);
+			if(algorithm_.carriers & (1 << op))
+				numCarriers_++;
+		}
+		algorithm_.carriers &= (1u << kOperators) - 1;
+		if(algorithm_.feedback >= (int)kOperators)
+			algorithm_.feedback = -1;
+	}
+
+	// Set an operator's frequency as a ratio to the note's frequency, plus
+	// a detune in Hz, and its level. A carrier's level is its amplitude; a
+	// modulator's level is the largest change in phase it causes, in
+	// radians (the modulation index).
+	void setOperator(unsigned int op, float ratio, float level, float detune = 0) {
+		if(op >= kOperators)
+			return;
+		ratio_[op] = ratio;
+		level_[op] = level;
+		detune_[op] = detune;
+	}
+
+	// Set an operator's envelope: times in seconds, sustain level from 0 to 1
+	void setEnvelope(unsigned int op, float attack, float decay, float sustain, float release) {
+		if(op >= kOperators)
+			return;
+		attack_[op] = attack;
+		decay_[op] = decay;
+		sustain_[op] = sustain;
+		release_[op] = release;
+		updateEnvelopes(op);
+	}
+
+	// How much velocity changes an operator's level, from 0 (not at all) to
+	// 1 (in proportion). For modulators, this makes louder notes brighter.
+	void setVelocitySensitivity(unsigned int op, float amount) {
+		if(op < kOperators)
+			velocitySensitivity_[op] = std::min(std::max(amount, 0.0f), 1.0f);
+	}
+
+	// Set the self-modulation of the algorithm's feedback operator, in radians
+	void setFeedback(float amount) { feedbackAmount_ = amount; }
+
+	// Start a note with a velocity from 0 to 1, on a free voice or else on
+	// the one which started longest ago
+	void noteOn(int note, float velocity);
+
+	// Release every voice playing this note
+	void noteOff(int note);
+
+	// Release every voice
+	void allNotesOff() {
+		for(Group& group : groups_)
+			for(unsigned int lane = 0; lane < 4; lane++)
+				releaseLane(group, lane);
+	}
+
+	unsigned int getNumVoices() { return 4 * groups_.size(); }
+	unsigned int getNumActiveVoices();
+
+	// Fill a buffer with the next frames samples of all the voices mixed
+	inline void process(float * __restrict output, unsigned int frames);
+
+	~FmSynth() {}				// Destructor
+
+private:
+	// Four voices, one in each lane
+	struct Group {
+		uint32_t phase[kOperators][4] = {};
+		uint32_t increment[kOperators][4] = {};
+		float level[kOperators][4] = {};		// Envelope level now
+		float levelEnd[kOperators][4] = {};		// Envelope level at the next control tick
+		float levelStep[kOperators][4] = {};
+		float amplitude[kOperators][4] = {};	// Operator level times velocity scaling
+		float feedback[2][4] = {};				// Last two outputs of the feedback operator
+		ADSR envelope[kOperators][4];
+		float frequency[4] = {};
+		float velocity[4] = {};
+		int note[4] = {-1, -1, -1, -1};			// -1 once released
+		unsigned int age[4] = {};				// When each note started
+		unsigned int activeLanes = 0;			// Bit for each lane playing
+	};
+
+	// Every operator at ratio 1 with a short envelope, and only operator 0
+	// heard: a sine wave
+	void setDefaults() {
+		for(unsigned int op = 0; op < kOperators; op++) {
+			ratio_[op] = 1;
+			level_[op] = op == 0 ? 1 : 0;
+			attack_[op] = 0.005;
+			decay_[op] = 0.1;
+			sustain_[op] = 1;
+			release_[op] = 0.1;
+		}
+	}
+
+	// Times shorter than one control tick would never move the envelope,
+	// so they take one tick
+	void updateEnvelopes(unsigned int op) {
+		float minTime = kControlPeriod / sampleRate_;
+		for(Group& group : groups_) {
+			for(unsigned int lane = 0; lane < 4; lane++) {
+				ADSR& envelope = group.envelope[op][lane];
+				envelope.setAttackTime(std::max(attack_[op], minTime));
+				envelope.setDecayTime(std::max(decay_[op], minTime));
+				envelope.setSustainLevel(sustain_[op]);
+				envelope.setReleaseTime(std::max(release_[op], minTime));
+			}
+		}
+	}
+
+	void releaseLane(Group& group, unsigned int lane) {
+		if(group.note[lane] < 0)
+			return;
+		for(unsigned int op = 0; op < kOperators; op++)
+			group.envelope[op][lane].release();
+		group.note[lane] = -1;
+	}
+
+	bool laneSounding(Group& group, unsigned int lane) {
+		for(unsigned int op = 0; op < kOperators; op++) {
+			if((algorithm_.carriers & (1 << op))
+			   && (group.envelope[op][lane].isActive() || group.levelEnd[op][lane] > 0))
+				return true;
+		}
+		return false;
+	}
+
+	void updateIncrements(Group& group, unsigned int lane) {
+		for(unsigned int op = 0; op < kOperators; op++) {
+			float f = ratio_[op] * group.frequency[lane] + detune_[op];
+			float increment = std::min(std::max(f / sampleRate_, 0.0f), 0.49f);
+			group.increment[op][lane] = (uint32_t)(increment * 4294967296.0);
+		}
+	}
+
+	void controlTick();
+	inline void renderGroup(Group& group, float * __restrict output, unsigned int frames);
+
+	std::vector<Group> groups_;
+	std::vector<float> sineTable_;
+	FmAlgorithm algorithm_ = fm::kStack;
+	unsigned int numCarriers_ = 1;
+	float feedbackAmount_ = 0;
+
+	float ratio_[kOperators] = {};
+	float level_[kOperators] = {};
+	float detune_[kOperators] = {};
+	float velocitySensitivity_[kOperators] = {};
+	float attack_[kOperators] = {};
+	float decay_[kOperators] = {};
+	float sustain_[kOperators] = {};
+	float release_[kOperators] = {};
+
+	float sampleRate_ = 44100;
+	unsigned int countdown_ = 0;		// Samples until the next control tick
+	unsigned int ageCounter_ = 0;
+};
+
+template<unsigned int kOperators>
+void FmSynth<kOperators>::noteOn(int note, float velocity)
+{
+	if(groups_.empty())
+		return;
+
+	// Look for a silent voice, remembering the oldest in case there isn't one
+	Group *chosen = &groups_[0];
+	unsigned int chosenLane = 0;
+	bool found = false;
+	for(Group& group : groups_) {
+		for(unsigned int lane = 0; lane < 4 && !found; lane++) {
+			if(!(group.activeLanes & (1 << lane))) {
+				chosen = &group;
+				chosenLane = lane;
+				found = true;
+			}
+			else if(ageCounter_ - group.age[lane] > ageCounter_ - chosen->age[chosenLane]) {
+				chosen = &group;
+				chosenLane = lane;
+			}
+		}
+		if(found)
+			break;
+	}
+
+	// A silent voice starts from phase 0; a stolen one carries on from
+	// where it is, so that it doesn't click
+	Group& group = *chosen;
+	unsigned int lane = chosenLane;
+	if(found) {
+		for(unsigned int op = 0; op < kOperators; op++)
+			group.phase[op][lane] = 0;
+		group.feedback[0][lane] = group.feedback[1][lane] = 0;
+	}
+	group.note[lane] = note;
+	group.frequency[lane] = midiToHz(note);
+	group.velocity[lane] = std::min(std::max(velocity, 0.0f), 1.0f);
+	group.age[lane] = ++ageCounter_;
+	group.activeLanes |= 1 << lane;
+	updateIncrements(group, lane);
+	for(unsigned int op = 0; op < kOperators; op++)
+		group.envelope[op][lane].trigger();
+}
+
+template<unsigned int kOperators>
+void FmSynth<kOperators>::noteOff(int note)
+{
+	for(Group& group : groups_) {
+		for(unsigned int lane = 0; lane < 4; lane++) {
+			if(group.note[lane] == note)
+				releaseLane(group, lane);
+		}
+	}
+}
+
+template<unsigned int kOperators>
+unsigned int FmSynth<kOperators>::getNumActiveVoices()
+{
+	unsigned int count = 0;
+	for(Group& group : groups_)
+		for(unsigned int lane = 0; lane < 4; lane++)
+			count += (group.activeLanes >> lane) & 1;
+	return count;
+}
+
+// Move every envelope on one step, and pick up changes to the operators
+template<unsigned int kOperators>
+void FmSynth<kOperators>::controlTick()
+{
+	float carrierGain = numCarriers_ > 0 ? 1.0f / numCarriers_ : 0;
+	for(Group& group : groups_) {
+		group.activeLanes = 0;
+		for(unsigned int lane = 0; lane < 4; lane++) {
+			if(!laneSounding(group, lane)) {
+				// Keep a silent lane silent while the others play
+				for(unsigned int op = 0; op < kOperators; op++)
+					group.level[op][lane] = group.levelEnd[op][lane] = group.levelStep[op][lane] = 0;
+				continue;
+			}
+			group.activeLanes |= 1 << lane;
+			updateIncrements(group, lane);
+			for(unsigned int op = 0; op < kOperators; op++) {
+				float sensitivity = velocitySensitivity_[op];
+				float amplitude = level_[op] * (1.0f - sensitivity + sensitivity * group.velocity[lane]);
+				if(algorithm_.carriers & (1 << op))
+					amplitude *= carrierGain;
+				group.amplitude[op][lane] = amplitude;
+				group.level[op][lane] = group.levelEnd[op][lane];
+				group.levelEnd[op][lane] = group.envelope[op][lane].process();
+				group.levelStep[op][lane] = (group.levelEnd[op][lane] - group.level[op][lane]) * (1.0f / kControlPeriod);
+			}
+		}
+	}
+}
+
+// Fill a buffer with the next frames samples, in pieces which end at each
+// control tick
+template<unsigned int kOperators>
+inline void FmSynth<kOperators>::process(float * __restrict output, unsigned int frames)
+{
+	std::fill(output, output + frames, 0.0f);
+	unsigned int n = 0;
+	while(n < frames) {
+		if(countdown_ == 0) {
+			controlTick();
+			countdown_ = kControlPeriod;
+		}
+		unsigned int count = std::min(countdown_, frames - n);
+		for(Group& group : groups_) {
+			if(group.activeLanes)
+				renderGroup(group, output + n, count);
+		}
+		countdown_ -= count;
+		n += count;
+	}
+}
+
+// Work out the operators of four voices from the highest down, and add the
+// carriers of all four into the output
+template<unsigned int kOperators>
+inline void FmSynth<kOperators>::renderGroup(Group& group, float * __restrict output, unsigned int frames)
+{
+	const float *table = sineTable_.data();
+	const int feedbackOp = algorithm_.feedback;
+	const float feedbackScale = 0.5f * feedbackAmount_;
+
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	Int4 phase[kOperators], increment[kOperators];
+	Float4 level[kOperators], levelStep[kOperators], amplitude[kOperators], out[kOperators];
+	for(unsigned int op = 0; op < kOperators; op++) {
+		phase[op] = loadInt4((const int32_t *)group.phase[op]);
+		increment[op] = loadInt4((const int32_t *)group.increment[op]);
+		level[op] = load4(group.level[op]);
+		levelStep[op] = load4(group.levelStep[op]);
+		amplitude[op] = load4(group.amplitude[op]);
+	}
+	Float4 feedback0 = load4(group.feedback[0]), feedback1 = load4(group.feedback[1]);
+
+	for(unsigned int n = 0; n < frames; n++) {
+		Float4 mix = set4(0.0f);
+		for(int op = kOperators - 1; op >= 0; op--) {
+			Int4 readPhase = phase[op];
+			if(algorithm_.modulators[op] || op == feedbackOp) {
+				Float4 modulation = set4(0.0f);
+				for(unsigned int j = op + 1; j < kOperators; j++) {
+					if(algorithm_.modulators[op] & (1 << j))
+						modulation = add4(modulation, out[j]);
+				}
+				if(op == feedbackOp)
+					modulation = add4(modulation, mul4(add4(feedback0, feedback1), set4(feedbackScale)));
+				readPhase = addInt4(readPhase, fm::phaseOffset4(modulation));
+			}
+			out[op] = mul4(fm::sine4(table, readPhase), mul4(amplitude[op], level[op]));
+			if(algorithm_.carriers & (1 << op))
+				mix = add4(mix, out[op]);
+			phase[op] = addInt4(phase[op], increment[op]);
+			level[op] = add4(level[op], levelStep[op]);
+		}
+		if(feedbackOp >= 0) {
+			feedback1 = feedback0;
+			feedback0 = out[feedbackOp];
+		}
+		float lanes[4];
+		store4(lanes, mix);
+		output[n] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+	}
+
+	for(unsigned int op = 0; op < kOperators; op++) {
+		storeInt4((int32_t *)group.phase[op], phase[op]);
+		store4(group.level[op], level[op]);
+	}
+	store4(group.feedback[0], feedback0);
+	store4(group.feedback[1], feedback1);
+#else
+	for(unsigned int n = 0; n < frames; n++) {
+		float lanes[4];
+		for(unsigned int lane = 0; lane < 4; lane++) {
+			float out[kOperators];
+			float mix = 0;
+			for(int op = kOperators - 1; op >= 0; op--) {
+				uint32_t readPhase = group.phase[op][lane];
+				if(algorithm_.modulators[op] || op == feedbackOp) {
+					float modulation = 0;
+					for(unsigned int j = op + 1; j < kOperators; j++) {
+						if(algorithm_.modulators[op] & (1 << j))
+							modulation += out[j];
+					}
+					if(op == feedbackOp)
+						modulation += (group.feedback[0][lane] + group.feedback[1][lane]) * feedbackScale;
+					readPhase += fm::phaseOffset(modulation);
+				}
+				out[op] = fm::sine(table, readPhase) * (group.amplitude[op][lane] * group.level[op][lane]);
+				if(algorithm_.carriers & (1 << op))
+					mix += out[op];
+				group.phase[op][lane] += group.increment[op][lane];
+				group.level[op][lane] += group.levelStep[op][lane];
+			}
+			if(feedbackOp >= 0) {
+				group.feedback[1][lane] = group.feedback[0][lane];
+				group.feedback[0][lane] = out[feedbackOp];
+			}
+			lanes[lane] = mix;
+		}
+		output[n] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+	}
+#endif
+}
+
+} // namespace dsp
+
+namespace fm = dsp::fm;
+using dsp::FmAlgorithm;
+using dsp::FmSynth;
\ No newline at end of file
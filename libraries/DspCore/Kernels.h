@@ -0,0 +1,551 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// Kernels.h: the buffer operations found in the inner loops of the FFT and
+// synth examples: multiplying by a window, adding into an overlap-add buffer,
+// mixing sources, applying a gain ramp, clipping and dot products. Each works
+// on 4 values at a time using NEON (on Bela) or SSE2, through the same layer
+// as the buffer forms in FastMath.h.
+//
+// kernels::reference has a plain version of each, which gives exactly the
+// same result, bit for bit: the vector versions do the same operations in
+// the same order, four values at once. dot() adds its products into four
+// separate sums, one for each position modulo 4, in both versions. This
+// holds as long as the compiler doesn't fuse multiplies and adds. GCC
+// doesn't with -std=c++NN (as opposed to -std=gnu++NN), and can't on ARMv7
+// or x86 without FMA; other compilers such as Clang may contract them
+// unless built with -ffp-contract=off. Inputs are
+// expected to be finite. On ARMv7, NEON also treats denormal numbers as zero,
+// which the scalar unit doesn't, but those are far below anything audible.
+//
+// Buffers may be the same as the output where noted, but must not otherwise
+// overlap. They need no particular alignment.
+//
+// Each kernel comes in several versions: reference, vector4 (NEON or SSE2,
+// whichever the program was built for) and, on x86, avx (8 values at a
+// time, built with the target attribute so the rest of the program doesn't
+// need -mavx). Each call goes through a function pointer to the version in
+// use. Until init() is called that is the reference version; init(), called
+// from setup(), checks cpuFeatures() and picks the fastest version the
+// processor can run. Every version gives the same results. useVariant()
+// picks a particular version, for testing and benchmarking. Call both in
+// setup(), not while other threads are using the kernels.
+//
+// Only these kernels are chosen at run time, as they are the only code with
+// a version (AVX) beyond what the program is built for. The buffer forms in
+// FastMath.h, and the filters and oscillators built on them, have a single
+// vector version, NEON or SSE2, which every processor the build targets can
+// run, so they are called directly.
+
+#pragma once
+
+#include "FastMath.h"
+#include "CpuFeatures.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DSPCORE_KERNELS_AVX
+#endif
+
+namespace dsp {
+
+namespace kernels {
+
+namespace reference {
+
+// output[n] = a[n] * b[n]; output may be a or b
+inline void mul(const float *a, const float *b, float *output, unsigned int count)
+{
+	for(unsigned int n = 0; n < count; n++)
+		output[n] = a[n] * b[n];
+}
+
+// output[n] = input[n] * gain; output may be input
+inline void mul(const float *input, float gain, float *output, unsigned int count)
+{
+	for(unsigned int n = 0; n < count; n++)
+		output[n] = input[n] * gain;
+}
+
+// output[n] += a[n] * b[n]
+inline void mac(const float *a, const float *b, float * __restrict output, unsigned int count)
+{
+	for(unsigned int n = 0; n < count; n++)
+		output[n] = output[n] + a[n] * b[n];
+}
+
+// output[n] += input[n] * gain
+inline void mac(const float *input, float gain, float * __restrict output, unsigned int count)
+{
+	for(unsigned int n = 0; n < count; n++)
+		output[n] = output[n] + input[n] * gain;
+}
+
+// output[n] = the sum of inputs[i][n] * gains[i], added in order of i; the
+// output must not be one of the inputs
+inline void mixN(const float * const *inputs, const float *gains, unsigned int numInputs,
+				 float *output, unsigned int count)
+{
+	for(unsigned int n = 0; n < count; n++) {
+		float sum = 0;
+		for(unsigned int i = 0; i < numInputs; i++)
+			sum = sum + inputs[i][n] * gains[i];
+		output[n] = sum;
+	}
+}
+
+// output[n] = input[n] * a gain going in a straight line from startGain
+// (at n = 0) towards endGain (at n = count); output may be input
+inline void gainRamp(const float *input, float *output, unsigned int count, float startGain, float endGain)
+{
+	float step = (endGain - startGain) / count;
+	for(unsigned int n = 0; n < count; n++)
+		output[n] = input[n] * (startGain + step * (float)n);
+}
+
+// output[n] = input[n] limited to between low and high; output may be input
+inline void clip(const float *input, float *output, unsigned int count, float low, float high)
+{
+	for(unsigned int n = 0; n < count; n++) {
+		float x = input[n] < high ? input[n] : high;
+		output[n] = x > low ? x : low;
+	}
+}
+
+// The sum of a[n] * b[n]
+inline float dot(const float *a, const float *b, unsigned int count)
+{
+	float sums[4] = {0, 0, 0, 0};
+	unsigned int n = 0;
+	for(; n + 4 <= count; n += 4) {
+		for(unsigned int lane = 0; lane < 4; lane++)
+			sums[lane] = sums[lane] + a[n + lane] * b[n + lane];
+	}
+	float sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+	for(; n < count; n++)
+		sum = sum + a[n] * b[n];
+	return sum;
+}
+
+} // namespace reference
+
+// Vector versions: four values at a time, then the rest one at a time
+
+namespace vector4 {
+
+inline void mul(const float *a, const float *b, float *output, unsigned int count)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	for(; n + 4 <= count; n += 4)
+		store4(output + n, mul4(load4(a + n), load4(b + n)));
+#endif
+	reference::mul(a + n, b + n, output + n, count - n);
+}
+
+inline void mul(const float *input, float gain, float *output, unsigned int count)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	Float4 gain4 = set4(gain);
+	for(; n + 4 <= count; n += 4)
+		store4(output + n, mul4(load4(input + n), gain4));
+#endif
+	reference::mul(input + n, gain, output + n, count - n);
+}
+
+inline void mac(const float *a, const float *b, float * __restrict output, unsigned int count)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	for(; n + 4 <= count; n += 4)
+		store4(output + n, add4(load4(output + n), mul4(load4(a + n), load4(b + n))));
+#endif
+	reference::mac(a + n, b + n, output + n, count - n);
+}
+
+inline void mac(const float *input, float gain, float * __restrict output, unsigned int count)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	Float4 gain4 = set4(gain);
+	for(; n + 4 <= count; n += 4)
+		store4(output + n, add4(load4(output + n), mul4(load4(input + n), gain4)));
+#endif
+	reference::mac(input + n, gain, output + n, count - n);
+}
+
+// Each group of four outputs stays in a register while every input is added.
+// The output must not be one of the inputs.
+inline void mixN(const float * const *inputs, const float *gains, unsigned int numInputs,
+				 float * __restrict output, unsigned int count)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	for(; n + 4 <= count; n += 4) {
+		Float4 sum = set4(0.0f);
+		for(unsigned int i = 0; i < numInputs; i++)
+			sum = add4(sum, mul4(load4(inputs[i] + n), set4(gains[i])));
+		store4(output + n, sum);
+	}
+#endif
+	for(; n < count; n++) {
+		float sum = 0;
+		for(unsigned int i = 0; i < numInputs; i++)
+			sum = sum + inputs[i][n] * gains[i];
+		output[n] = sum;
+	}
+}
+
+// The gain is worked out from n on every frame rather than added up, so it
+// doesn't drift and both versions agree
+inline void gainRamp(const float *input, float *output, unsigned int count, float startGain, float endGain)
+{
+	float step = (endGain - startGain) / count;
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	const float lanes[4] = {0, 1, 2, 3};
+	Float4 lane4 = load4(lanes);
+	Float4 start4 = set4(startGain);
+	Float4 step4 = set4(step);
+	for(; n + 4 <= count; n += 4) {
+		Float4 gain = add4(start4, mul4(step4, add4(set4((float)n), lane4)));
+		store4(output + n, mul4(load4(input + n), gain));
+	}
+#endif
+	for(; n < count; n++)
+		output[n] = input[n] * (startGain + step * (float)n);
+}
+
+inline void clip(const float *input, float *output, unsigned int count, float low, float high)
+{
+	unsigned int n = 0;
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	Float4 low4 = set4(low);
+	Float4 high4 = set4(high);
+	for(; n + 4 <= count; n += 4)
+		store4(output + n, max4(min4(load4(input + n), high4), low4));
+#endif
+	reference::clip(input + n, output + n, count - n, low, high);
+}
+
+inline float dot(const float *a, const float *b, unsigned int count)
+{
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	Float4 sum4 = set4(0.0f);
+	unsigned int n = 0;
+	for(; n + 4 <= count; n += 4)
+		sum4 = add4(sum4, mul4(load4(a + n), load4(b + n)));
+	float sums[4];
+	store4(sums, sum4);
+	float sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+	for(; n < count; n++)
+		sum = sum + a[n] * b[n];
+	return sum;
+#else
+	return reference::dot(a, b, count);
+#endif
+}
+
+} // namespace vector4
+
+#if defined(DSPCORE_KERNELS_AVX)
+// AVX versions: eight values at a time, then the rest one at a time. There
+// are no fused multiply-adds, so the results match the other versions. dot()
+// uses the 4-value version, because eight separate sums would add the
+// products up in a different order.
+namespace avx {
+
+__attribute__((target("avx")))
+inline void mul(const float *a, const float *b, float *output, unsigned int count)
+{
+	unsigned int n = 0;
+	for(; n + 8 <= count; n += 8)
+		_mm256_storeu_ps(output + n, _mm256_mul_ps(_mm256_loadu_ps(a + n), _mm256_loadu_ps(b + n)));
+	reference::mul(a + n, b + n, output + n, count - n);
+}
+
+__attribute__((target("avx")))
+inline void mul(const float *input, float gain, float *output, unsigned int count)
+{
+	unsigned int n = 0;
+	__m256 gain8 = _mm256_set1_ps(gain);
+	for(; n + 8 <= count; n += 8)
+		_mm256_storeu_ps(output + n, _mm256_mul_ps(_mm256_loadu_ps(input + n), gain8));
+	reference::mul(input + n, gain, output + n, count - n);
+}
+
+__attribute__((target("avx")))
+inline void mac(const float *a, const float *b, float * __restrict output, unsigned int count)
+{
+	unsigned int n = 0;
+	for(; n + 8 <= count; n += 8) {
+		__m256 product = _mm256_mul_ps(_mm256_loadu_ps(a + n), _mm256_loadu_ps(b + n));
+		_mm256_storeu_ps(output + n, _mm256_add_ps(_mm256_loadu_ps(output + n), product));
+	}
+	reference::mac(a + n, b + n, output + n, count - n);
+}
+
+__attribute__((target("avx")))
+inline void mac(const float *input, float gain, float * __restrict output, unsigned int count)
+{
+	unsigned int n = 0;
+	__m256 gain8 = _mm256_set1_ps(gain);
+	for(; n + 8 <= count; n += 8) {
+		__m256 product = _mm256_mul_ps(_mm256_loadu_ps(input + n), gain8);
+		_mm256_storeu_ps(output + n, _mm256_add_ps(_mm256_loadu_ps(output + n), product));
+	}
+	reference::mac(input + n, gain, output + n, count - n);
+}
+
+__attribute__((target("avx")))
+inline void mixN(const float * const *inputs, const float *gains, unsigned int numInputs,
+				 float * __restrict output, unsigned int count)
+{
+	unsigned int n = 0;
+	for(; n + 8 <= count; n += 8) {
+		__m256 sum = _mm256_setzero_ps();
+		for(unsigned int i = 0; i < numInputs; i++)
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(inputs[i] + n), _mm256_set1_ps(gains[i])));
+		_mm256_storeu_ps(output + n, sum);
+	}
+	for(; n < count; n++) {
+		float sum = 0;
+		for(unsigned int i = 0; i < numInputs; i++)
+			sum = sum + inputs[i][n] * gains[i];
+		output[n] = sum;
+	}
+}
+
+__attribute__((target("avx")))
+inline void gainRamp(const float *input, float *output, unsigned int count, float startGain, float endGain)
+{
+	float step = (endGain - startGain) / count;
+	unsigned int n = 0;
+	__m256 lane8 = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+	__m256 start8 = _mm256_set1_ps(startGain);
+	__m256 step8 = _mm256_set1_ps(step);
+	for(; n + 8 <= count; n += 8) {
+		__m256 gain = _mm256_add_ps(start8, _mm256_mul_ps(step8, _mm256_add_ps(_mm256_set1_ps((float)n), lane8)));
+		_mm256_storeu_ps(output + n, _mm256_mul_ps(_mm256_loadu_ps(input + n), gain));
+	}
+	for(; n < count; n++)
+		output[n] = input[n] * (startGain + step * (float)n);
+}
+
+__attribute__((target("avx")))
+inline void clip(const float *input, float *output, unsigned int count, float low, float high)
+{
+	unsigned int n = 0;
+	__m256 low8 = _mm256_set1_ps(low);
+	__m256 high8 = _mm256_set1_ps(high);
+	for(; n + 8 <= count; n += 8)
+		_mm256_storeu_ps(output + n, _mm256_max_ps(_mm256_min_ps(_mm256_loadu_ps(input + n), high8), low8));
+	reference::clip(input + n, output + n, count - n, low, high);
+}
+
+} // namespace avx
+#endif
+
+// The versions, from slowest to fastest
+enum Variant {
+	kReference = 0,
+	kVector4,
+	kAvx,
+	kNumVariants
+};
+
+// The name of a version, as used in the namespaces above
+inline const char* variantName(Variant variant)
+{
+	static const char* const names[kNumVariants] = {"reference", "vector4", "avx"};
+	return variant < kNumVariants ? names[variant] : "unknown";
+}
+
+// Whether this build has a version and this processor can run it
+inline bool variantSupported(Variant variant)
+{
+	switch(variant) {
+	case kReference:
+		return true;
+	case kVector4:
+#if defined(DSPCORE_FASTMATH_NEON)
+		return cpuFeatures().neon;
+#elif defined(DSPCORE_FASTMATH_SSE2)
+		return cpuFeatures().sse2;
+#else
+		return false;
+#endif
+	case kAvx:
+#if defined(DSPCORE_KERNELS_AVX)
+		return cpuFeatures().avx;
+#else
+		return false;
+#endif
+	default:
+		return false;
+	}
+}
+
+// The function pointers for one version
+struct Table {
+	Variant variant;
+	void (*mul)(const float *a, const float *b, float *output, unsigned int count);
+	void (*mulGain)(const float *input, float gain, float *output, unsigned int count);
+	void (*mac)(const float *a, const float *b, float * __restrict output, unsigned int count);
+	void (*macGain)(const float *input, float gain, float * __restrict output, unsigned int count);
+	void (*mixN)(const float * const *inputs, const float *gains, unsigned int numInputs,
+				 float * __restrict output, unsigned int count);
+	void (*gainRamp)(const float *input, float *output, unsigned int count, float startGain, float endGain);
+	void (*clip)(const float *input, float *output, unsigned int count, float low, float high);
+	float (*dot)(const float *a, const float *b, unsigned int count);
+};
+
+// Fill in the table for a version. Assigning each overloaded function to a
+// pointer of the right type picks the overload.
+inline void fillTable(Table& table, Variant variant)
+{
+	table.variant = variant;
+	if(variant == kVector4) {
+		table.mul = vector4::mul;
+		table.mulGain = vector4::mul;
+		table.mac = vector4::mac;
+		table.macGain = vector4::mac;
+		table.mixN = vector4::mixN;
+		table.gainRamp = vector4::gainRamp;
+		table.clip = vector4::clip;
+		table.dot = vector4::dot;
+	}
+#if defined(DSPCORE_KERNELS_AVX)
+	else if(variant == kAvx) {
+		table.mul = avx::mul;
+		table.mulGain = avx::mul;
+		table.mac = avx::mac;
+		table.macGain = avx::mac;
+		table.mixN = avx::mixN;
+		table.gainRamp = avx::gainRamp;
+		table.clip = avx::clip;
+		table.dot = vector4::dot;
+	}
+#endif
+	else {
+		table.variant = kReference;
+		table.mul = reference::mul;
+		table.mulGain = reference::mul;
+		table.mac = reference::mac;
+		table.macGain = reference::mac;
+		table.mixN = reference::mixN;
+		table.gainRamp = reference::gainRamp;
+		table.clip = reference::clip;
+		table.dot = reference::dot;
+	}
+}
+
+// The fastest version this processor can run
+inline Variant bestVariant()
+{
+	for(int variant = kNumVariants - 1; variant > kReference; variant--) {
+		if(variantSupported((Variant)variant))
+			return (Variant)variant;
+	}
+	return kReference;
+}
+
+// The table in use. It starts out with the reference versions, which is a
+// constant initialisation, so reading it needs no guard on the first call
+// the way a table filled in by a function would.
+inline Table& dispatch()
+{
+	static Table table = {
+		kReference, reference::mul, reference::mul, reference::mac, reference::mac,
+		reference::mixN, reference::gainRamp, reference::clip, reference::dot
+	};
+	return table;
+}
+
+// Use the fastest version this processor can run. Call from setup().
+inline void init()
+{
+	fillTable(dispatch(), bestVariant());
+}
+
+// Use a particular version from now on. Returns false, and changes nothing,
+// if the processor can't run it.
+inline bool useVariant(Variant variant)
+{
+	if(!variantSupported(variant))
+		return false;
+	fillTable(dispatch(), variant);
+	return true;
+}
+
+// The version in use
+inline Variant currentVariant()
+{
+	return dispatch().variant;
+}
+
+// The kernels themselves, which call the version in use
+
+inline void mul(const float *a, const float *b, float *output, unsigned int count)
+{
+	dispatch().mul(a, b, output, count);
+}
+
+inline void mul(const float *input, float gain, float *output, unsigned int count)
+{
+	dispatch().mulGain(input, gain, output, count);
+}
+
+inline void mac(const float *a, const float *b, float * __restrict output, unsigned int count)
+{
+	dispatch().mac(a, b, output, count);
+}
+
+inline void mac(const float *input, float gain, float * __restrict output, unsigned int count)
+{
+	dispatch().macGain(input, gain, output, count);
+}
+
+inline void mixN(const float * const *inputs, const float *gains, unsigned int numInputs,
+				 float * __restrict output, unsigned int count)
+{
+	dispatch().mixN(inputs, gains, numInputs, output, count);
+}
+
+inline void gainRamp(const float *input, float *output, unsigned int count, float startGain, float endGain)
+{
+	dispatch().gainRamp(input, output, count, startGain, endGain);
+}
+
+inline void clip(const float *input, float *output, unsigned int count, float low, float high)
+{
+	dispatch().clip(input, output, count, low, high);
+}
+
+inline float dot(const float *a, const float *b, unsigned int count)
+{
+	return dispatch().dot(a, b, count);
+}
+
+} // namespace kernels
+
+} // namespace dsp
+
+namespace kernels = dsp::kernels;
\ No newline at end of file
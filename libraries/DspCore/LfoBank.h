@@ -0,0 +1,253 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// LfoBank.h: a set of low-frequency oscillators worked out at a control rate
+// and interpolated in between.
+//
+// An LFO changes slowly, so there is no need to work out its shape on every
+// sample. Every controlPeriod samples (16 by default), the bank works out
+// where each LFO will be at the end of the next period. In between,
+// getValue() interpolates linearly from where it is now, which costs one
+// multiply, and only for the LFOs that are read. Moving the bank on by one
+// sample with process() only counts down to the next control tick.
+//
+// Each LFO has its own shape, and runs either at a frequency in Hz or in
+// time with a tempo shared by the whole bank. Changes of shape, frequency
+// and tempo take effect at the next control tick. The random shapes use
+// WhiteNoise with a seed, so they repeat exactly from run to run.
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "FastMath.h"
+#include "Noise.h"
+
+namespace dsp {
+
+enum LfoShape {
+	kLfoSine = 0,			// Starts at 0, rising
+	kLfoTriangle,			// Starts at 0, rising
+	kLfoSaw,				// Rises from -1 to 1
+	kLfoSquare,				// 1 for the first half of the cycle, then -1
+	kLfoSampleAndHold,		// A new random value each cycle
+	kLfoSmoothRandom		// Glides to a new random value each cycle
+};
+
+class LfoBank {
+public:
+	LfoBank() {}														// Default constructor
+	LfoBank(float sampleRate, unsigned int numLfos,						// Constructor with arguments
+			unsigned int controlPeriod = 16) {
+		setup(sampleRate, numLfos, controlPeriod);
+	}
+
+	// Make numLfos LFOs, all sine waves at 1Hz, which are worked out every
+	// controlPeriod samples. This allocates memory, so call it from setup().
+	void setup(float sampleRate, unsigned int numLfos, unsigned int controlPeriod = 16) {
+		inverseSampleRate_ = 1.0f / sampleRate;
+		controlPeriod_ = std::max(controlPeriod, 1u);
+		lfos_.assign(numLfos, Lfo());
+		countdown_ = controlPeriod_;
+		for(unsigned int i = 0; i < numLfos; i++) {
+			lfos_[i].next = random_.process();
+			updateIncrement(lfos_[i]);
+			setPhase(i, 0);
+		}
+	}
+
+	unsigned int getNumLfos() { return lfos_.size(); }
+	unsigned int getControlPeriod() { return controlPeriod_; }
+
+	// Choose the shape of one LFO
+	void setShape(unsigned int lfo, LfoShape shape) {
+		if(lfo < lfos_.size())
+			lfos_[lfo].shape = shape;
+	}
+
+	// Run one LFO at a frequency in Hz
+	void setFrequency(unsigned int lfo, float frequency) {
+		if(lfo >= lfos_.size())
+			return;
+		lfos_[lfo].frequency = frequency;
+		lfos_[lfo].beats = 0;
+		updateIncrement(lfos_[lfo]);
+	}
+
+	// Run one LFO in time with the tempo, taking this many beats for each
+	// cycle: for example 0.25 for a cycle every sixteenth note or 4 for one
+	// every bar of 4/4
+	void setBeats(unsigned int lfo, float beats) {
+		if(lfo >= lfos_.size() || beats <= 0)
+			return;
+		lfos_[lfo].beats = beats;
+		updateIncrement(lfos_[lfo]);
+	}
+
+	// Set the tempo in beats per minute for all the LFOs set with setBeats()
+	void setTempo(float bpm) {
+		tempo_ = bpm;
+		for(Lfo& lfo : lfos_)
+			updateIncrement(lfo);
+	}
+	float getTempo() { return tempo_; }
+
+	// Jump to a phase from 0 to 1, for example at the start of a note.
+	// getValue() moves from the new value from the next sample on.
+	void setPhase(unsigned int lfo, float phase);
+
+	// Restart every LFO from phase 0
+	void reset() {
+		for(unsigned int i = 0; i < lfos_.size(); i++)
+			setPhase(i, 0);
+	}
+
+	// Seed the random shapes, so that they give the same values every time.
+	// Each LFO's next random value is drawn again from the new seed, and the
+	// output carries on from where it is now towards it.
+	void setSeed(uint32_t seed) {
+		random_.setSeed(seed);
+		for(Lfo& lfo : lfos_) {
+			float current = lfo.target - lfo.step * (float)countdown_;
+			lfo.next = random_.process();
+			lfo.target = shapeValue(lfo);
+			lfo.step = (lfo.target - current) / countdown_;
+		}
+	}
+
+	// Move every LFO on by one sample
+	void process() {
+		if(--countdown_ == 0)
+			controlTick();
+	}
+
+	// Move every LFO on by a block of frames samples
+	void process(unsigned int frames) {
+		while(frames >= countdown_) {
+			frames -= countdown_;
+			controlTick();
+		}
+		countdown_ -= frames;
+	}
+
+	// Get the value of one LFO now, from -1 to 1
+	float getValue(unsigned int lfo) {
+		const Lfo& state = lfos_[lfo];
+		return state.target - state.step * (float)countdown_;
+	}
+
+	~LfoBank() {}				// Destructor
+
+private:
+	struct Lfo {
+		LfoShape shape = kLfoSine;
+		float frequency = 1;		// In Hz, when beats is 0
+		float beats = 0;			// Beats per cycle, or 0 to use frequency
+		float increment = 0;		// Phase change per sample
+		float phase = 0;			// Phase at the next control tick, 0 to 1
+		float target = 0;			// Value at the next control tick
+		float step = 0;				// Change in value per sample until then
+		float previous = 0;			// Random values for the current cycle
+		float next = 0;
+	};
+
+	void updateIncrement(Lfo& lfo) {
+		float frequency = lfo.beats > 0 ? tempo_ / (60.0f * lfo.beats) : lfo.frequency;
+		lfo.increment = frequency * inverseSampleRate_;
+	}
+
+	// Move an LFO's phase on, starting a new cycle of random values each
+	// time it wraps round
+	void advance(Lfo& lfo, float amount) {
+		lfo.phase += amount;
+		if(lfo.phase >= 1.0f || lfo.phase < 0) {
+			lfo.phase -= floorf(lfo.phase);
+			lfo.previous = lfo.next;
+			lfo.next = random_.process();
+		}
+	}
+
+	inline float shapeValue(const Lfo& lfo);
+	inline void controlTick();
+
+	std::vector<Lfo> lfos_;
+	WhiteNoise random_;
+	float inverseSampleRate_ = 1.0f / 44100.0f;
+	float tempo_ = 120;
+	unsigned int controlPeriod_ = 16;
+	unsigned int countdown_ = 16;		// Samples until the next control tick
+};
+
+// The value of an LFO at its current phase
+inline float LfoBank::shapeValue(const Lfo& lfo)
+{
+	float phase = lfo.phase;
+	switch(lfo.shape) {
+		case kLfoTriangle: {
+			float shifted = phase + 0.25f;
+			shifted -= (float)(int)shifted;
+			return 1.0f - 4.0f * fabsf(shifted - 0.5f);
+		}
+		case kLfoSaw:
+			return 2.0f * phase - 1.0f;
+		case kLfoSquare:
+			return phase < 0.5f ? 1.0f : -1.0f;
+		case kLfoSampleAndHold:
+			return lfo.next;
+		case kLfoSmoothRandom:
+			// Smoothstep, so the glide starts and ends gently
+			return lfo.previous + (lfo.next - lfo.previous) * phase * phase * (3.0f - 2.0f * phase);
+		case kLfoSine:
+		default:
+			return fastSin(2.0f * (float)M_PI * phase);
+	}
+}
+
+// Work out where each LFO will be at the end of the next control period,
+// and how far to move towards it on each sample
+inline void LfoBank::controlTick()
+{
+	countdown_ = controlPeriod_;
+	float inversePeriod = 1.0f / controlPeriod_;
+	for(Lfo& lfo : lfos_) {
+		float current = lfo.target;
+		advance(lfo, lfo.increment * controlPeriod_);
+		lfo.target = shapeValue(lfo);
+		lfo.step = (lfo.target - current) * inversePeriod;
+	}
+}
+
+// Jump to a new phase, then interpolate from there to the value at the next
+// control tick, which may be less than a period away
+inline void LfoBank::setPhase(unsigned int lfo, float phase)
+{
+	if(lfo >= lfos_.size())
+		return;
+	Lfo& state = lfos_[lfo];
+	state.phase = phase - floorf(phase);
+	float current = shapeValue(state);
+	advance(state, state.increment * countdown_);
+	state.target = shapeValue(state);
+	state.step = (state.target - current) / countdown_;
+}
+
+} // namespace dsp
+
+using dsp::LfoBank;
+using dsp::LfoShape;
+using dsp::kLfoSine;
+using dsp::kLfoTriangle;
+using dsp::kLfoSaw;
+using dsp::kLfoSquare;
+using dsp::kLfoSampleAndHold;
+using dsp::kLfoSmoothRandom;
\ No newline at end of file
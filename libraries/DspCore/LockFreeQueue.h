@@ -0,0 +1,70 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// LockFreeQueue.h: a fixed-size queue for passing messages, such as note
+// events, from one thread to another without locks or allocation. There must
+// be only one thread pushing and one thread popping.
+
+#pragma once
+
+#include <atomic>
+
+namespace dsp {
+
+template<class T, unsigned int Capacity>
+class LockFreeQueue {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+				  "LockFreeQueue capacity must be a power of two");
+
+public:
+	// Constructor
+	LockFreeQueue() {}
+
+	// Add an item at the back. Returns false, dropping the item, if the
+	// queue is full. Call from the writing thread only.
+	bool push(const T& item) {
+		unsigned int write = write_.load(std::memory_order_relaxed);
+		if(write - read_.load(std::memory_order_acquire) >= Capacity)
+			return false;
+		items_[write & (Capacity - 1)] = item;
+		write_.store(write + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Take the item at the front. Returns false if the queue is empty. Call
+	// from the reading thread only.
+	bool pop(T& item) {
+		unsigned int read = read_.load(std::memory_order_relaxed);
+		if(read == write_.load(std::memory_order_acquire))
+			return false;
+		item = items_[read & (Capacity - 1)];
+		read_.store(read + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Number of items waiting. Only exact when called from one of the two threads.
+	unsigned int size() {
+		return write_.load(std::memory_order_acquire) - read_.load(std::memory_order_acquire);
+	}
+	bool empty() { return size() == 0; }
+
+private:
+	T items_[Capacity];
+	// The two counters are written by different threads: keep them on
+	// separate cache lines so the threads don't slow each other down
+	alignas(64) std::atomic<unsigned int> write_{0};	// Total items pushed
+	alignas(64) std::atomic<unsigned int> read_{0};		// Total items popped
+};
+
+} // namespace dsp
+
+using dsp::LockFreeQueue;
\ No newline at end of file
@@ -0,0 +1,126 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// MonoFilePlayer.h: playback of a sound loaded from an audio file, with
+// basic controls to loop, start and stop. It assumes a mono audio file.
+// Everything is defined in this header so that process() can be inlined.
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <libraries/AudioFile/AudioFile.h>
+
+namespace dsp {
+
+class MonoFilePlayer {
+public:
+	// Constructors: the one with arguments automatically calls setup()
+	MonoFilePlayer() {}
+	MonoFilePlayer(const std::string& filename, bool loop = true, bool autostart = true) {
+		setup(filename, loop, autostart);
+	}
+
+	// Load an audio file from the given filename. Returns true on success.
+	bool setup(const std::string& filename, bool loop = true, bool autostart = true) {
+		readPointer_ = 0;
+		isPlaying_ = autostart;
+		loop_ = loop;
+
+		// Load the file
+		sampleBuffer_ = AudioFileUtilities::loadMono(filename);
+
+		// Check for error
+		if(sampleBuffer_.empty()) {
+			isPlaying_ = false;
+			return false;
+		}
+
+		return true;
+	}
+
+	// Start or stop the playback
+	void trigger() {
+		if(sampleBuffer_.empty())
+			return;
+		readPointer_ = 0;
+		isPlaying_ = true;
+	}
+	void stop() { isPlaying_ = false; }
+
+	// Return the length of the buffer in samples
+	unsigned int size() { return sampleBuffer_.size(); }
+
+	// Return the next sample of the loaded audio file
+	inline float process();
+
+	// Fill a buffer with the next frames samples of the file
+	inline void process(float * __restrict output, unsigned int frames);
+
+	// Destructor
+	~MonoFilePlayer() {}
+
+private:
+	std::vector<float> sampleBuffer_;			// Buffer that holds the sound file
+	unsigned int readPointer_ = 0;				// Position of the last frame we played
+	bool loop_ = false;							// Whether the playback loops at the end
+	bool isPlaying_ = false;					// Whether we are currently playing
+};
+
+// Return the next sample of the loaded audio file
+inline float MonoFilePlayer::process()
+{
+	if(!isPlaying_)
+		return 0;
+
+	// Read the next sample from the buffer and move on
+	float out = sampleBuffer_[readPointer_++];
+
+	// If we reach the end, decide whether to loop or stop
+	if(readPointer_ >= sampleBuffer_.size()) {
+		readPointer_ = 0;
+		if(!loop_)
+			isPlaying_ = false;
+	}
+
+	return out;
+}
+
+// Fill a buffer, copying runs of samples up to the end of the file at once
+inline void MonoFilePlayer::process(float * __restrict output, unsigned int frames)
+{
+	unsigned int n = 0;
+	while(n < frames && isPlaying_) {
+		const float * __restrict samples = sampleBuffer_.data();
+		unsigned int count = sampleBuffer_.size() - readPointer_;
+		if(count > frames - n)
+			count = frames - n;
+		for(unsigned int i = 0; i < count; i++)
+			output[n + i] = samples[readPointer_ + i];
+		n += count;
+		readPointer_ += count;
+
+		if(readPointer_ >= sampleBuffer_.size()) {
+			readPointer_ = 0;
+			if(!loop_)
+				isPlaying_ = false;
+		}
+	}
+
+	// Silence after the end of the file
+	for(; n < frames; n++)
+		output[n] = 0;
+}
+
+} // namespace dsp
+
+using dsp::MonoFilePlayer;
\ No newline at end of file
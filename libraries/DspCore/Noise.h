@@ -0,0 +1,182 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// Noise.h: white and pink noise that is safe to generate in render().
+//
+// rand() is slow, its low bits are poor, and some C libraries take a lock
+// inside it. WhiteNoise runs four xorshift generators side by side instead,
+// one in each lane of a NEON or SSE2 register, so a block of noise costs
+// little more than writing the block. Each generator's state is 32 bits,
+// and the top 23 bits of each number become the mantissa of a float from
+// -1 to 1 directly, without a division.
+//
+// PinkNoise uses the Voss-McCartney method: 16 rows of random values, where
+// row k is replaced every 2^(k+1) samples, are added up with one new white
+// value per sample. Each row adds a band of noise an octave lower than the
+// one before, which together fall by 3dB per octave down to below 1Hz.
+//
+// Both take a seed. The same seed always gives the same noise, whether it is
+// generated one sample at a time or in blocks of any size.
+
+#pragma once
+
+#include <cstdint>
+#include "FastMath.h"
+
+namespace dsp {
+
+namespace noise {
+	// splitmix32: spreads consecutive seeds out into unrelated states, none
+	// of them 0 (which would make xorshift output 0 forever)
+	inline uint32_t mixSeed(uint32_t& seed) {
+		uint32_t z = (seed += 0x9e3779b9u);
+		z = (z ^ (z >> 16)) * 0x85ebca6bu;
+		z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+		z ^= z >> 16;
+		return z ? z : 1;
+	}
+
+	// Move one xorshift32 generator on by one step
+	inline uint32_t xorshift(uint32_t& state) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	// The top 23 bits as a float from 2 to 4, moved down to -1 to 1
+	inline float toFloat(uint32_t bits) {
+		return fastmath::bitsToFloat((bits >> 9) | 0x40000000u) - 3.0f;
+	}
+}
+
+class WhiteNoise {
+public:
+	WhiteNoise() { setSeed(1); }									// Default constructor
+	WhiteNoise(uint32_t seed) { setSeed(seed); }					// Constructor with arguments
+
+	// Start again from a seed
+	void setSeed(uint32_t seed) {
+		for(unsigned int i = 0; i < 4; i++)
+			state_[i] = noise::mixSeed(seed);
+		lane_ = 0;
+	}
+
+	// Get the next value, from -1 to 1
+	float process() {
+		float out = noise::toFloat(noise::xorshift(state_[lane_]));
+		lane_ = (lane_ + 1) & 3;
+		return out;
+	}
+
+	// Fill a buffer with the next frames values
+	inline void process(float * __restrict output, unsigned int frames);
+
+	~WhiteNoise() {}				// Destructor
+
+private:
+	uint32_t state_[4];		// One generator per lane; sample n comes from lane n % 4
+	unsigned int lane_ = 0;	// Lane for the next sample
+};
+
+class PinkNoise {
+public:
+	static const unsigned int kRows = 16;
+
+	PinkNoise() { setSeed(1); }										// Default constructor
+	PinkNoise(uint32_t seed) { setSeed(seed); }						// Constructor with arguments
+
+	// Start again from a seed
+	void setSeed(uint32_t seed) {
+		white_.setSeed(seed);
+		counter_ = 0;
+		sum_ = 0;
+		for(unsigned int i = 0; i < kRows; i++) {
+			rows_[i] = white_.process();
+			sum_ += rows_[i];
+		}
+	}
+
+	// Get the next value, from -1 to 1
+	float process() {
+		float row = white_.process();
+		return next(row, white_.process());
+	}
+
+	// Fill a buffer with the next frames values. The white noise comes
+	// from WhiteNoise's block version, in pieces that fit on the stack.
+	void process(float * __restrict output, unsigned int frames) {
+		const unsigned int kChunk = 64;
+		float white[2 * kChunk];
+		while(frames > 0) {
+			unsigned int count = frames < kChunk ? frames : kChunk;
+			white_.process(white, 2 * count);
+			for(unsigned int n = 0; n < count; n++)
+				output[n] = next(white[2 * n], white[2 * n + 1]);
+			output += count;
+			frames -= count;
+		}
+	}
+
+	~PinkNoise() {}				// Destructor
+
+private:
+	// Replace the row given by the number of trailing zeros in the counter,
+	// so row 0 changes every other sample, row 1 every fourth and so on,
+	// then add a white value which changes every sample
+	float next(float row, float white) {
+		counter_ = (counter_ + 1) & ((1u << kRows) - 1);
+		if(counter_ != 0) {
+			unsigned int index = __builtin_ctz(counter_);
+			sum_ += row - rows_[index];
+			rows_[index] = row;
+		}
+		return (sum_ + white) * (1.0f / (kRows + 1));
+	}
+
+	WhiteNoise white_;
+	float rows_[kRows];
+	float sum_ = 0;			// Sum of rows_, kept up to date as they change
+	uint32_t counter_ = 0;
+};
+
+// Fill a buffer with the next frames values: one sample at a time until the
+// next sample comes from lane 0, then four at a time
+inline void WhiteNoise::process(float * __restrict output, unsigned int frames)
+{
+	unsigned int n = 0;
+	while(lane_ != 0 && n < frames)
+		output[n++] = process();
+
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	if(n + 4 <= frames) {
+		Int4 state = loadInt4((const int32_t *)state_);
+		const Int4 exponent = setInt4(0x40000000);
+		const Float4 three = set4(3.0f);
+		for(; n + 4 <= frames; n += 4) {
+			state = xorInt4(state, shiftLeft4<13>(state));
+			state = xorInt4(state, shiftRightUnsigned4<17>(state));
+			state = xorInt4(state, shiftLeft4<5>(state));
+			store4(output + n, sub4(bitsToFloat4(orInt4(shiftRightUnsigned4<9>(state), exponent)), three));
+		}
+		storeInt4((int32_t *)state_, state);
+	}
+#endif
+	for(; n < frames; n++)
+		output[n] = process();
+}
+
+} // namespace dsp
+
+using dsp::WhiteNoise;
+using dsp::PinkNoise;
\ No newline at end of file
@@ -0,0 +1,85 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// ObjectPool.h: a fixed number of objects, such as voices or grains, that
+// are taken when needed and given back when finished, without allocating.
+// The objects in use are always the first size() in the pool, so a loop over
+// them touches one contiguous block of memory. Releasing an object moves the
+// last one in use into its place.
+//
+// A pool belongs to one thread. To start voices from the MIDI thread, send
+// the events to the audio thread through a LockFreeQueue and acquire the
+// voices there.
+
+#pragma once
+
+#include <utility>
+
+namespace dsp {
+
+template<class T, unsigned int Capacity>
+class ObjectPool {
+public:
+	// Constructor: all objects start out free
+	ObjectPool() {}
+
+	// Take a free object, or return nullptr if they are all in use. The
+	// object keeps whatever state it had when it was released, so set it up
+	// again before use. The pointer is valid until the next release().
+	T* acquire() {
+		if(size_ >= Capacity)
+			return nullptr;
+		return &objects_[size_++];
+	}
+
+	// Give back the object in use at the given index. The last object in use
+	// moves into its place, so when releasing in a loop over the pool, count
+	// downwards or don't advance the index after a release.
+	void release(unsigned int index) {
+		if(index >= size_)
+			return;
+		size_--;
+		if(index != size_) {
+			// Swapping keeps any memory the objects own inside the pool
+			using std::swap;
+			swap(objects_[index], objects_[size_]);
+		}
+	}
+
+	// Give back an object returned by acquire() or operator[]
+	void release(T* object) { release((unsigned int)(object - objects_)); }
+
+	// Give back every object
+	void clear() { size_ = 0; }
+
+	// Access the objects in use, from 0 to size() - 1
+	T& operator[](unsigned int index) { return objects_[index]; }
+	T* begin() { return objects_; }
+	T* end() { return objects_ + size_; }
+
+	// Number of objects in use, and the most there can be
+	unsigned int size() { return size_; }
+	unsigned int capacity() { return Capacity; }
+	bool empty() { return size_ == 0; }
+	bool full() { return size_ >= Capacity; }
+
+	// Every object in the pool, in use or not, for setting them all up at once
+	T& storage(unsigned int index) { return objects_[index]; }
+
+private:
+	T objects_[Capacity];			// In use first, then free
+	unsigned int size_ = 0;			// Number of objects in use
+};
+
+} // namespace dsp
+
+using dsp::ObjectPool;
\ No newline at end of file
@@ -0,0 +1,256 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// Oversampler.h: run processing at 2, 4 or 8 times the audio sample rate,
+// so that nonlinear processing (distortion, naive oscillators, hard sync)
+// has room for the harmonics it creates above the original Nyquist
+// frequency. Those harmonics are then filtered out before going back down
+// to the audio rate, instead of folding back into the audible range.
+//
+// Each factor of 2 is a half-band FIR filter. Every other coefficient of a
+// half-band filter is zero apart from the centre one, which is 0.5, so the
+// filter splits into two halves (polyphase): when going up, the new samples
+// between the old ones come from one half, and the old samples are just
+// delayed; when going down, only the samples that are kept are worked out.
+// The first stage does most of the work: it is flat to within 0.001dB up to
+// 0.41 of the audio sample rate (18kHz at 44.1kHz), and everything above
+// 0.59 of the sample rate is attenuated by at least 85dB. The later stages
+// only have to separate the audio band from images much further away, so
+// they are shorter.
+//
+// The filters are linear phase, so the output is a delayed copy of the
+// input when the processing does nothing. getLatency() says by how much.
+
+#pragma once
+
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+namespace dsp {
+
+namespace oversampler {
+	// The coefficients either side of the centre of each half-band filter,
+	// from the centre outwards: h[c-1] = h[c+1], h[c-3] = h[c+3], and so on.
+	// Kaiser-windowed sinc, scaled so that the gain at 0Hz is exactly 1.
+
+	// First stage: 63 taps, Kaiser beta 8.8
+	const float kStage1[16] = {
+		3.16939350e-01f, -1.02057253e-01f, 5.71209034e-02f, -3.67207030e-02f,
+		2.47670912e-02f, -1.68991921e-02f, 1.14377747e-02f, -7.57779735e-03f,
+		4.86097319e-03f, -2.98659276e-03f, 1.73549669e-03f, -9.37886496e-04f,
+		4.59428613e-04f, -1.94921914e-04f, 6.46650692e-05f, -1.13358920e-05f
+	};
+
+	// Second stage: 23 taps, Kaiser beta 8.6
+	const float kStage2[6] = {
+		3.07820635e-01f, -7.81272354e-02f, 2.64086672e-02f, -7.28533092e-03f,
+		1.22182141e-03f, -3.85577208e-05f
+	};
+
+	// Third stage: 19 taps, Kaiser beta 9
+	const float kStage3[5] = {
+		3.02014905e-01f, -6.53709247e-02f, 1.53697847e-02f, -2.04610521e-03f,
+		3.23402137e-05f
+	};
+}
+
+// One factor of 2, up and down, using a half-band filter with 4 * K - 1
+// taps whose K distinct coefficients are given
+template<unsigned int K>
+class HalfBandStage {
+public:
+	static const unsigned int kTaps = 4 * K - 1;
+	static const unsigned int kCentre = 2 * K - 1;
+
+	// Make room for blocks of up to maxFrames frames at the lower rate
+	void setup(const float *coefficients, unsigned int maxFrames) {
+		coefficients_ = coefficients;
+		upHistory_.assign(kUpHistory + maxFrames, 0);
+		downHistory_.assign(kDownHistory + 2 * maxFrames, 0);
+	}
+
+	// Clear the filters' memory
+	void reset() {
+		std::fill(upHistory_.begin(), upHistory_.end(), 0);
+		std::fill(downHistory_.begin(), downHistory_.end(), 0);
+	}
+
+	// Turn frames samples into 2 * frames samples
+	void up(const float *input, float *output, unsigned int frames) {
+		// Copy the input after the end of the previous block, so each
+		// output can read back into it without wrapping round
+		float *history = upHistory_.data();
+		memcpy(history + kUpHistory, input, frames * sizeof(float));
+
+		for(unsigned int n = 0; n < frames; n++) {
+			const float *x = history + kUpHistory + n;		// x[0] is input[n]
+			float sum = 0;
+			for(unsigned int k = 0; k < K; k++)
+				sum += coefficients_[k] * (x[-(int)(K - 1 - k)] + x[-(int)(K + k)]);
+			// The filter doubles the level, since half the samples going in are zero
+			output[2 * n] = 2.0f * sum;
+			output[2 * n + 1] = x[-(int)(K - 1)];
+		}
+
+		memmove(history, history + frames, kUpHistory * sizeof(float));
+	}
+
+	// Turn 2 * frames samples into frames samples
+	void down(const float *input, float *output, unsigned int frames) {
+		float *history = downHistory_.data();
+		memcpy(history + kDownHistory, input, 2 * frames * sizeof(float));
+
+		for(unsigned int n = 0; n < frames; n++) {
+			const float *v = history + kDownHistory + 2 * n - kCentre;	// v[0] is the centre tap
+			float sum = 0.5f * v[0];
+			for(unsigned int k = 0; k < K; k++)
+				sum += coefficients_[k] * (v[2 * k + 1] + v[-(int)(2 * k + 1)]);
+			output[n] = sum;
+		}
+
+		memmove(history, history + 2 * frames, kDownHistory * sizeof(float));
+	}
+
+	// Delay of going up and down again, in samples at the higher rate
+	static constexpr float latency() { return 2.0f * kCentre; }
+
+	// Multiplications for each sample at the lower rate, up and down
+	static constexpr unsigned int multiplies() { return 2 * (K + 1); }
+
+private:
+	static const unsigned int kUpHistory = 2 * K - 1;		// Earlier inputs read by up()
+	static const unsigned int kDownHistory = 4 * K - 2;		// Earlier inputs read by down()
+
+	const float *coefficients_ = nullptr;
+	std::vector<float> upHistory_;
+	std::vector<float> downHistory_;
+};
+
+class Oversampler {
+public:
+	static const unsigned int kMaxFactor = 8;
+
+	Oversampler() {}											// Default constructor
+	Oversampler(unsigned int factor, unsigned int maxBlockSize) {	// Constructor with arguments
+		setup(factor, maxBlockSize);
+	}
+
+	// Choose the factor (1, 2, 4 or 8) and the largest block that process()
+	// will be given. Returns false for any other factor.
+	bool setup(unsigned int factor, unsigned int maxBlockSize) {
+		if(factor != 1 && factor != 2 && factor != 4 && factor != 8)
+			return false;
+		factor_ = factor;
+		maxBlockSize_ = maxBlockSize;
+		stage1_.setup(oversampler::kStage1, maxBlockSize);
+		stage2_.setup(oversampler::kStage2, 2 * maxBlockSize);
+		stage3_.setup(oversampler::kStage3, 4 * maxBlockSize);
+		buffers_[0].assign(2 * maxBlockSize, 0);
+		buffers_[1].assign(4 * maxBlockSize, 0);
+		buffers_[2].assign(8 * maxBlockSize, 0);
+		return true;
+	}
+
+	// Clear the filters' memory
+	void reset() {
+		stage1_.reset();
+		stage2_.reset();
+		stage3_.reset();
+	}
+
+	// The oversampling factor
+	unsigned int getFactor() { return factor_; }
+
+	// Delay from input to output, in samples at the audio rate. It can be a
+	// fraction of a sample.
+	float getLatency() {
+		float latency = 0;
+		if(factor_ >= 2)
+			latency += stage1_.latency() / 2;
+		if(factor_ >= 4)
+			latency += stage2_.latency() / 4;
+		if(factor_ >= 8)
+			latency += stage3_.latency() / 8;
+		return latency;
+	}
+
+	// Multiplications in the filters for each sample at the audio rate, as
+	// a guide to their cost next to the processing itself
+	unsigned int getMultipliesPerSample() {
+		unsigned int multiplies = 0;
+		if(factor_ >= 2)
+			multiplies += stage1_.multiplies();
+		if(factor_ >= 4)
+			multiplies += 2 * stage2_.multiplies();
+		if(factor_ >= 8)
+			multiplies += 4 * stage3_.multiplies();
+		return multiplies;
+	}
+
+	// Go up to the higher rate, call processBlock(buffer, frames * factor)
+	// to process the samples in place, then come back down. processBlock can
+	// be a lambda or any object with an operator(). frames must be no more
+	// than the block size given to setup().
+	template<class ProcessBlock>
+	void process(const float *input, float *output, unsigned int frames, ProcessBlock&& processBlock);
+
+private:
+	HalfBandStage<16> stage1_;		// Audio rate <-> 2x
+	HalfBandStage<6> stage2_;		// 2x <-> 4x
+	HalfBandStage<5> stage3_;		// 4x <-> 8x
+	std::vector<float> buffers_[3];	// Blocks at 2x, 4x and 8x
+	unsigned int factor_ = 1;
+	unsigned int maxBlockSize_ = 0;
+};
+
+template<class ProcessBlock>
+void Oversampler::process(const float *input, float *output, unsigned int frames, ProcessBlock&& processBlock)
+{
+	if(frames > maxBlockSize_)
+		frames = maxBlockSize_;
+
+	if(factor_ == 1) {
+		if(output != input)
+			memmove(output, input, frames * sizeof(float));
+		processBlock(output, frames);
+		return;
+	}
+
+	// Up through as many stages as the factor needs
+	float *x2 = buffers_[0].data();
+	float *x4 = buffers_[1].data();
+	float *x8 = buffers_[2].data();
+	stage1_.up(input, x2, frames);
+	float *buffer = x2;
+	if(factor_ >= 4) {
+		stage2_.up(x2, x4, 2 * frames);
+		buffer = x4;
+	}
+	if(factor_ >= 8) {
+		stage3_.up(x4, x8, 4 * frames);
+		buffer = x8;
+	}
+
+	processBlock(buffer, frames * factor_);
+
+	// Then back down again
+	if(factor_ >= 8)
+		stage3_.down(x8, x4, 4 * frames);
+	if(factor_ >= 4)
+		stage2_.down(x4, x2, 2 * frames);
+	stage1_.down(x2, output, frames);
+}
+
+} // namespace dsp
+
+using dsp::Oversampler;
\ No newline at end of file
@@ -0,0 +1,215 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// ParallelScheduler.h: runs the independent parts of one block's processing,
+// such as separate voices or effect chains, on several cores at once. A pool
+// of worker threads, each fixed to its own core at a real-time priority,
+// steals tasks from a WorkStealingDeque filled by run(). The thread calling
+// run() works on the tasks too, and run() returns once all of them are done.
+//
+// Idle workers sleep on a semaphore, which run() posts when it has work, so
+// they don't hold their cores at a real-time priority between blocks. They
+// can be told to spin for a while first, which saves the wake-up time at the
+// cost of those cores. A board with one core gets nothing from workers: use
+// std::thread::hardware_concurrency() - 1 of them, which may be none.
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <system_error>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include "WorkStealingDeque.h"
+
+namespace dsp {
+
+class ParallelScheduler {
+public:
+	// Function run for each task: the argument given to run() and the task number
+	typedef void (*TaskFunction)(void *arg, unsigned int task);
+
+	// Most tasks handed to the workers by one run(); any more run on the calling thread
+	static const unsigned int kMaxTasks = 64;
+
+	// Constructor
+	ParallelScheduler() {}
+
+	// Start numWorkers threads at the given SCHED_FIFO priority, on cores
+	// firstCore, firstCore + 1 and so on (wrapping round). Returns false if
+	// the threads couldn't be started. If the priority or core couldn't be
+	// set, the threads still run and isRealTime() returns false.
+	bool setup(unsigned int numWorkers, int priority = 90, unsigned int firstCore = 1) {
+		cleanup();
+		stop_ = false;
+		realTime_ = true;
+		if(numWorkers == 0)
+			return true;
+		if(sem_init(&wake_, 0, 0) != 0)
+			return false;
+		semaphoreReady_ = true;
+		unsigned int cores = std::thread::hardware_concurrency();
+		if(cores == 0)
+			cores = 1;
+		try {
+			for(unsigned int i = 0; i < numWorkers; i++) {
+				workers_.emplace_back(&ParallelScheduler::workerLoop, this);
+				pthread_t handle = workers_.back().native_handle();
+
+				sched_param parameters = {};
+				parameters.sched_priority = priority;
+				if(pthread_setschedparam(handle, SCHED_FIFO, &parameters) != 0)
+					realTime_ = false;
+
+				cpu_set_t cpus;
+				CPU_ZERO(&cpus);
+				CPU_SET((firstCore + i) % cores, &cpus);
+				if(pthread_setaffinity_np(handle, sizeof(cpus), &cpus) != 0)
+					realTime_ = false;
+			}
+		}
+		catch(const std::system_error&) {
+			cleanup();
+			return false;
+		}
+		return true;
+	}
+
+	// Stop the worker threads
+	void cleanup() {
+		stop_ = true;
+		for(unsigned int i = 0; i < workers_.size(); i++)
+			sem_post(&wake_);
+		for(std::thread& worker : workers_)
+			worker.join();
+		workers_.clear();
+		if(semaphoreReady_) {
+			sem_destroy(&wake_);
+			semaphoreReady_ = false;
+		}
+	}
+
+	// Call function(arg, task) for task = 0 to count - 1, spread across the
+	// workers and the calling thread, and return when all have finished.
+	// Doesn't allocate or lock. Call from one thread at a time.
+	void run(TaskFunction function, void *arg, unsigned int count) {
+		if(workers_.empty() || count < 2) {
+			for(unsigned int task = 0; task < count; task++)
+				function(arg, task);
+			return;
+		}
+
+		function_ = function;
+		arg_ = arg;
+		remaining_.store(count, std::memory_order_relaxed);
+		for(unsigned int task = count; task-- > 0;) {
+			if(!deque_.push(task))
+				runTask(function, arg, task);
+		}
+
+		// Wake the workers, then work alongside them. A worker counts itself
+		// in sleeping_ before checking generation_ one last time, so either it
+		// sees this run or it is counted here and gets a post.
+		generation_.fetch_add(1, std::memory_order_seq_cst);
+		for(unsigned int sleepers = sleeping_.exchange(0, std::memory_order_seq_cst); sleepers > 0; sleepers--)
+			sem_post(&wake_);
+		unsigned int task;
+		while(deque_.pop(task))
+			runTask(function, arg, task);
+
+		// Wait for tasks the workers are still running
+		while(remaining_.load(std::memory_order_acquire) > 0)
+			relax();
+	}
+
+	// How long idle workers spin before sleeping (none by default). Spinning
+	// for a little longer than one block saves waking them for each block,
+	// but keeps their cores busy at a real-time priority. Call before setup().
+	void setSpinTime(std::chrono::microseconds time) { spinTime_ = time; }
+
+	unsigned int numWorkers() { return workers_.size(); }
+	bool isRealTime() { return realTime_ && !workers_.empty(); }
+
+	// Destructor
+	~ParallelScheduler() { cleanup(); }
+
+	ParallelScheduler(const ParallelScheduler&) = delete;
+	ParallelScheduler& operator=(const ParallelScheduler&) = delete;
+
+private:
+	// Tell the processor this is a busy-wait loop
+	static void relax() {
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__arm__) || defined(__aarch64__)
+		asm volatile("yield");
+#endif
+	}
+
+	void runTask(TaskFunction function, void *arg, unsigned int task) {
+		function(arg, task);
+		remaining_.fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	void workerLoop() {
+		unsigned int seen = generation_.load(std::memory_order_acquire);
+		auto lastWork = std::chrono::steady_clock::now();
+		unsigned int spins = 0;
+
+		while(!stop_.load(std::memory_order_relaxed)) {
+			unsigned int generation = generation_.load(std::memory_order_acquire);
+			if(generation == seen) {
+				// Nothing new: spin, checking the clock now and then, and
+				// sleep once there has been no work for a while. A post left
+				// over from a run this worker saw anyway only wakes it once.
+				relax();
+				if(++spins % 1024 == 0 && std::chrono::steady_clock::now() - lastWork > spinTime_) {
+					sleeping_.fetch_add(1, std::memory_order_seq_cst);
+					if(generation_.load(std::memory_order_seq_cst) == seen && !stop_.load(std::memory_order_relaxed))
+						while(sem_wait(&wake_) != 0 && !stop_.load(std::memory_order_relaxed)) {}
+				}
+				continue;
+			}
+			seen = generation;
+
+			// Steal until the deque is empty. A steal can fail because
+			// another thread got there first, so check again.
+			unsigned int task;
+			while(!deque_.empty()) {
+				if(deque_.steal(task))
+					runTask(function_, arg_, task);
+			}
+			lastWork = std::chrono::steady_clock::now();
+			spins = 0;
+		}
+	}
+
+	WorkStealingDeque<kMaxTasks> deque_;
+	std::vector<std::thread> workers_;
+	std::atomic<unsigned int> generation_{0};		// Incremented by each run()
+	std::atomic<unsigned int> remaining_{0};		// Tasks not yet finished
+	std::atomic<unsigned int> sleeping_{0};		// Workers about to wait on wake_
+	std::atomic<bool> stop_{false};
+	sem_t wake_;									// Posted by run() for each sleeping worker
+	bool semaphoreReady_ = false;					// Whether wake_ needs destroying
+	TaskFunction function_ = nullptr;				// Set before the tasks are pushed
+	void *arg_ = nullptr;
+	std::chrono::microseconds spinTime_{0};
+	bool realTime_ = false;
+};
+
+} // namespace dsp
+
+using dsp::ParallelScheduler;
\ No newline at end of file
@@ -0,0 +1,378 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// PolyBlep.h: sawtooth, square (pulse) and triangle oscillators with very
+// little aliasing, worked out directly instead of read from a table.
+//
+// A naive sawtooth, such as a ramp from -1 to 1, jumps back down instantly
+// once per cycle. That jump has harmonics all the way up, and the ones above
+// the Nyquist frequency fold back down as aliasing. PolyBLEP (polynomial
+// band-limited step) smooths the jump by adjusting the one sample either
+// side of it with a short polynomial, which removes most of the aliasing.
+// The triangle has no jumps but sharp corners, which PolyBLAMP (the same
+// idea, integrated once) smooths in the same way. Nothing is stored apart
+// from the phase, so there are no tables to build for each note or range.
+//
+// PolyBlepOscillator is one oscillator, with optional hard sync: the phase
+// restarts every cycle of a second (silent) frequency, and the jump that
+// causes is smoothed too. PolyBlepOscillator4 runs four oscillators at once,
+// one in each lane of a NEON or SSE2 register, for the voices of a synth.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include "FastMath.h"
+
+namespace dsp {
+
+namespace polyblep {
+	// The correction to subtract from a waveform falling by 2 at phase 0,
+	// where t is the phase (0 to 1) and inverseIncrement is 1 / (phase
+	// change per sample). It is only non-zero within one sample of the jump.
+	// Written with max() so it has no branches:
+	//   a = 1 - t / increment (positive just after the jump)
+	//   b = 1 + (t - 1) / increment (positive just before it)
+	inline float blep(float t, float inverseIncrement) {
+		float a = std::max(0.0f, 1.0f - t * inverseIncrement);
+		float b = std::max(0.0f, (t - 1.0f) * inverseIncrement + 1.0f);
+		return b * b - a * a;
+	}
+
+	// The integral of blep(), for a change of slope at phase 0
+	inline float blamp(float t, float inverseIncrement) {
+		float a = std::max(0.0f, 1.0f - t * inverseIncrement);
+		float b = std::max(0.0f, (t - 1.0f) * inverseIncrement + 1.0f);
+		return (a * a * a + b * b * b) * (1.0f / 3.0f);
+	}
+
+	// Wrap a phase from 0 to 2 back into 0 to 1
+	inline float fraction(float t) { return t - (float)(int)t; }
+
+	// Lowest and highest frequency as a fraction of the sample rate: the
+	// corrections need the phase to move less than half a cycle per sample
+	const float kMinIncrement = 1e-6f;
+	const float kMaxIncrement = 0.49f;
+}
+
+enum PolyBlepWaveform {
+	kPolyBlepSaw = 0,		// Rising from -1 to 1
+	kPolyBlepSquare,		// 1 for the first part of the cycle (the pulse width), then -1
+	kPolyBlepTriangle		// -1 at phase 0, up to 1 at phase 0.5
+};
+
+class PolyBlepOscillator {
+public:
+	PolyBlepOscillator() {}													// Default constructor
+	PolyBlepOscillator(float sampleRate, PolyBlepWaveform waveform = kPolyBlepSaw) {	// Constructor with arguments
+		setup(sampleRate, waveform);
+	}
+
+	// Set parameters
+	void setup(float sampleRate, PolyBlepWaveform waveform = kPolyBlepSaw) {
+		inverseSampleRate_ = 1.0 / sampleRate;
+		waveform_ = waveform;
+		reset();
+		setFrequency(frequency_);
+		setSyncFrequency(syncFrequency_);
+	}
+
+	// Start again from phase 0
+	void reset() {
+		phase_ = 0;
+		syncPhase_ = 0;
+		pendingCorrection_ = 0;
+	}
+
+	// Choose the waveform
+	void setWaveform(PolyBlepWaveform waveform) { waveform_ = waveform; }
+
+	// Set the oscillator frequency, which must be below half the sample rate
+	void setFrequency(float f) {
+		frequency_ = f;
+		increment_ = std::min(std::max(frequency_ * inverseSampleRate_, polyblep::kMinIncrement),
+							  polyblep::kMaxIncrement);
+		inverseIncrement_ = 1.0f / increment_;
+	}
+
+	// Get the oscillator frequency
+	float getFrequency() { return frequency_; }
+
+	// Set the fraction of the cycle (0 to 1) for which the square wave is high
+	void setPulseWidth(float width) { pulseWidth_ = std::min(std::max(width, 0.0f), 1.0f); }
+
+	// Restart the phase at this frequency, for hard sync; 0 turns it off.
+	// The jump at each restart is smoothed, but for the triangle the change
+	// of slope is not.
+	void setSyncFrequency(float f) {
+		syncFrequency_ = f;
+		syncIncrement_ = f > 0 ? std::min(f * inverseSampleRate_, polyblep::kMaxIncrement) : 0;
+		inverseSyncIncrement_ = syncIncrement_ > 0 ? 1.0f / syncIncrement_ : 0;
+	}
+
+	// Get the next sample and update the phase
+	inline float process();
+
+	// Fill a buffer with the next frames samples
+	inline void process(float * __restrict output, unsigned int frames);
+
+	~PolyBlepOscillator() {}		// Destructor
+
+private:
+	// The waveform without corrections, at phase t
+	inline float naive(float t);
+
+	// The jump the waveform makes by itself at phase 0, which the
+	// corrections in process() already allow for
+	inline float naturalStep();
+
+	PolyBlepWaveform waveform_ = kPolyBlepSaw;
+	float inverseSampleRate_ = 1.0 / 44100.0;	// 1 divided by the audio sample rate
+	float frequency_ = 0;						// Frequency of the oscillator
+	float increment_ = polyblep::kMinIncrement;	// Phase change per sample
+	float inverseIncrement_ = 1.0 / polyblep::kMinIncrement;
+	float phase_ = 0;							// Phase, 0 to 1
+	float pulseWidth_ = 0.5;					// Fraction of the cycle the square wave is high
+	float syncFrequency_ = 0;					// Frequency of the hard sync, or 0
+	float syncIncrement_ = 0;					// Phase change per sample of the hard sync
+	float inverseSyncIncrement_ = 0;
+	float syncPhase_ = 0;						// Phase of the hard sync, 0 to 1
+	float pendingCorrection_ = 0;				// Correction for the sample after a restart
+};
+
+inline float PolyBlepOscillator::naive(float t)
+{
+	switch(waveform_) {
+	case kPolyBlepSquare:
+		return t < pulseWidth_ ? 1.0f : -1.0f;
+	case kPolyBlepTriangle:
+		return 1.0f - 4.0f * fabsf(t - 0.5f);
+	default:
+		return 2.0f * t - 1.0f;
+	}
+}
+
+inline float PolyBlepOscillator::naturalStep()
+{
+	switch(waveform_) {
+	case kPolyBlepSquare:
+		return 2.0f;
+	case kPolyBlepTriangle:
+		return 0.0f;
+	default:
+		return -2.0f;
+	}
+}
+
+// Get the next sample and update the phase
+inline float PolyBlepOscillator::process()
+{
+	using namespace polyblep;
+	float t = phase_;
+	float out;
+
+	switch(waveform_) {
+	case kPolyBlepSquare: {
+		// The difference between two sawtooth waves, the second one behind
+		// by the pulse width, plus an offset
+		float t2 = fraction(t + 1.0f - pulseWidth_);
+		out = 2.0f * (t2 - t) + (2.0f * pulseWidth_ - 1.0f)
+			  - blep(t2, inverseIncrement_) + blep(t, inverseIncrement_);
+		break;
+	}
+	case kPolyBlepTriangle:
+		// The slope changes by +8 at phase 0 and -8 at phase 0.5
+		out = 1.0f - 4.0f * fabsf(t - 0.5f)
+			  + 4.0f * increment_ * (blamp(t, inverseIncrement_) - blamp(fraction(t + 0.5f), inverseIncrement_));
+		break;
+	default:
+		out = 2.0f * t - 1.0f - blep(t, inverseIncrement_);
+		break;
+	}
+
+	out += pendingCorrection_;
+	pendingCorrection_ = 0;
+
+	if(syncIncrement_ > 0) {
+		float nextSyncPhase = syncPhase_ + syncIncrement_;
+		if(nextSyncPhase >= 1.0f) {
+			// The phase restarts before the next sample, this fraction of a
+			// sample from now. Smooth the jump from where the waveform would
+			// have been to phase 0: half the correction goes on this sample,
+			// and half on the next one.
+			float d = (1.0f - syncPhase_) * inverseSyncIncrement_;
+			float step = naive(0) - naive(fraction(t + d * increment_));
+			out += 0.5f * step * (1.0f - d) * (1.0f - d);
+			pendingCorrection_ = -0.5f * (step - naturalStep()) * d * d;
+
+			syncPhase_ = nextSyncPhase - 1.0f;
+			phase_ = (1.0f - d) * increment_;
+			return out;
+		}
+		syncPhase_ = nextSyncPhase;
+	}
+
+	// A branch is quicker than fraction() here, and gives the same result
+	phase_ = t + increment_;
+	if(phase_ >= 1.0f)
+		phase_ -= 1.0f;
+	return out;
+}
+
+// Fill a buffer with the next frames samples
+inline void PolyBlepOscillator::process(float * __restrict output, unsigned int frames)
+{
+	for(unsigned int n = 0; n < frames; n++)
+		output[n] = process();
+}
+
+// Four oscillators with the same waveform, each with its own frequency and
+// pulse width. The output is interleaved: frame n of oscillator i is at
+// output[4 * n + i].
+class PolyBlepOscillator4 {
+public:
+	PolyBlepOscillator4() {}												// Default constructor
+	PolyBlepOscillator4(float sampleRate, PolyBlepWaveform waveform = kPolyBlepSaw) {	// Constructor with arguments
+		setup(sampleRate, waveform);
+	}
+
+	// Set parameters
+	void setup(float sampleRate, PolyBlepWaveform waveform = kPolyBlepSaw) {
+		inverseSampleRate_ = 1.0 / sampleRate;
+		waveform_ = waveform;
+		for(unsigned int i = 0; i < 4; i++) {
+			phase_[i] = 0;
+			pulseWidth_[i] = 0.5;
+			setFrequency(i, frequency_[i]);
+		}
+	}
+
+	// Choose the waveform for all four oscillators
+	void setWaveform(PolyBlepWaveform waveform) { waveform_ = waveform; }
+
+	// Set the frequency of one oscillator (0 to 3)
+	void setFrequency(unsigned int oscillator, float f) {
+		frequency_[oscillator] = f;
+		increment_[oscillator] = std::min(std::max(f * inverseSampleRate_, polyblep::kMinIncrement),
+										  polyblep::kMaxIncrement);
+		inverseIncrement_[oscillator] = 1.0f / increment_[oscillator];
+	}
+
+	// Get the frequency of one oscillator
+	float getFrequency(unsigned int oscillator) { return frequency_[oscillator]; }
+
+	// Set the pulse width of one oscillator, for the square wave
+	void setPulseWidth(unsigned int oscillator, float width) {
+		pulseWidth_[oscillator] = std::min(std::max(width, 0.0f), 1.0f);
+	}
+
+	// Fill a buffer with the next frames frames of all four oscillators
+	inline void process(float * __restrict output, unsigned int frames);
+
+	~PolyBlepOscillator4() {}		// Destructor
+
+private:
+	PolyBlepWaveform waveform_ = kPolyBlepSaw;
+	float inverseSampleRate_ = 1.0 / 44100.0;
+	alignas(16) float frequency_[4] = {0, 0, 0, 0};
+	alignas(16) float increment_[4];
+	alignas(16) float inverseIncrement_[4];
+	alignas(16) float phase_[4];
+	alignas(16) float pulseWidth_[4];
+};
+
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+namespace polyblep {
+	// Four-value versions of the corrections above
+	inline fastmath::Float4 blep4(fastmath::Float4 t, fastmath::Float4 inverseIncrement) {
+		using namespace fastmath;
+		Float4 zero = set4(0.0f), one = set4(1.0f);
+		Float4 a = max4(zero, sub4(one, mul4(t, inverseIncrement)));
+		Float4 b = max4(zero, add4(mul4(sub4(t, one), inverseIncrement), one));
+		return sub4(mul4(b, b), mul4(a, a));
+	}
+
+	inline fastmath::Float4 blamp4(fastmath::Float4 t, fastmath::Float4 inverseIncrement) {
+		using namespace fastmath;
+		Float4 zero = set4(0.0f), one = set4(1.0f);
+		Float4 a = max4(zero, sub4(one, mul4(t, inverseIncrement)));
+		Float4 b = max4(zero, add4(mul4(sub4(t, one), inverseIncrement), one));
+		return mul4(add4(mul4(mul4(a, a), a), mul4(mul4(b, b), b)), set4(1.0f / 3.0f));
+	}
+}
+#endif
+
+// The same steps as PolyBlepOscillator::process(), four oscillators at a time
+inline void PolyBlepOscillator4::process(float * __restrict output, unsigned int frames)
+{
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	using namespace polyblep;
+	Float4 t = load4(phase_);
+	Float4 increment = load4(increment_);
+	Float4 inverseIncrement = load4(inverseIncrement_);
+	Float4 pulseWidth = load4(pulseWidth_);
+	Float4 one = set4(1.0f), two = set4(2.0f), four = set4(4.0f), half = set4(0.5f);
+
+	for(unsigned int n = 0; n < frames; n++) {
+		Float4 out;
+		if(waveform_ == kPolyBlepSquare) {
+			Float4 t2 = fraction4(sub4(add4(t, one), pulseWidth));
+			out = add4(mul4(two, sub4(t2, t)), sub4(mul4(two, pulseWidth), one));
+			out = add4(sub4(out, blep4(t2, inverseIncrement)), blep4(t, inverseIncrement));
+		}
+		else if(waveform_ == kPolyBlepTriangle) {
+			Float4 centred = sub4(t, half);
+			Float4 magnitude = max4(centred, sub4(set4(0.0f), centred));
+			Float4 corners = sub4(blamp4(t, inverseIncrement), blamp4(fraction4(add4(t, half)), inverseIncrement));
+			out = add4(sub4(one, mul4(four, magnitude)), mul4(mul4(four, increment), corners));
+		}
+		else {
+			out = sub4(sub4(mul4(two, t), one), blep4(t, inverseIncrement));
+		}
+		store4(output + 4 * n, out);
+		t = fraction4(add4(t, increment));
+	}
+	store4(phase_, t);
+#else
+	using namespace polyblep;
+	for(unsigned int n = 0; n < frames; n++) {
+		for(unsigned int i = 0; i < 4; i++) {
+			float t = phase_[i];
+			float out;
+			if(waveform_ == kPolyBlepSquare) {
+				float t2 = fraction(t + 1.0f - pulseWidth_[i]);
+				out = 2.0f * (t2 - t) + (2.0f * pulseWidth_[i] - 1.0f)
+					  - blep(t2, inverseIncrement_[i]) + blep(t, inverseIncrement_[i]);
+			}
+			else if(waveform_ == kPolyBlepTriangle) {
+				out = 1.0f - 4.0f * fabsf(t - 0.5f) + 4.0f * increment_[i]
+					  * (blamp(t, inverseIncrement_[i]) - blamp(fraction(t + 0.5f), inverseIncrement_[i]));
+			}
+			else {
+				out = 2.0f * t - 1.0f - blep(t, inverseIncrement_[i]);
+			}
+			output[4 * n + i] = out;
+			phase_[i] = fraction(t + increment_[i]);
+		}
+	}
+#endif
+}
+
+} // namespace dsp
+
+using dsp::PolyBlepOscillator;
+using dsp::PolyBlepOscillator4;
+using dsp::PolyBlepWaveform;
+using dsp::kPolyBlepSaw;
+using dsp::kPolyBlepSquare;
+using dsp::kPolyBlepTriangle;
\ No newline at end of file
@@ -0,0 +1,82 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// Ramp.h: a simple line segment generator, defined entirely in this header
+// so that process() can be inlined
+
+#pragma once
+
+namespace dsp {
+
+class Ramp {
+
+public:
+	// Constructor
+	Ramp() {}
+
+	// Constructor specifying a sample rate
+	Ramp(float sampleRate) : sampleRate_(sampleRate) {}
+
+	// Set the sample rate, used for all calculations
+	void setSampleRate(float rate) { sampleRate_ = rate; }
+
+	// Jump to a value
+	void setValue(float value) {
+		currentValue_ = value;
+		increment_ = 0;
+		counter_ = 0;
+	}
+
+	// Ramp to a value over a period of time
+	void rampTo(float value, float time) {
+		// Calculate the increment to get from the current value to the target
+		// in the specified amount of time
+		increment_ = (value - currentValue_) / (sampleRate_ * time);
+		counter_ = (int)(sampleRate_ * time);
+	}
+
+	// Generate and return the next ramp output
+	float process() {
+		if(counter_ > 0) {
+			counter_--;
+			currentValue_ += increment_;
+		}
+
+		return currentValue_;
+	}
+
+	// Fill a buffer with the next frames outputs
+	void process(float * __restrict output, unsigned int frames) {
+		for(unsigned int n = 0; n < frames; n++)
+			output[n] = process();
+	}
+
+	// Return whether the ramp is finished
+	bool finished() {
+		// The ramp is finished when the counter has counted down to 0
+		return (counter_ == 0);
+	}
+
+	// Destructor
+	~Ramp() {}
+
+private:
+	// State variables, not accessible to the outside world
+	float sampleRate_ = 1;
+	float currentValue_ = 0;
+	float increment_ = 0;
+	int   counter_ = 0;
+};
+
+} // namespace dsp
+
+using dsp::Ramp;
\ No newline at end of file
@@ -0,0 +1,386 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// RenderProfiler.h: measure how long render() and named zones within it take
+// compared to the time available for each block. Timings are collected into
+// histograms on the audio thread without locks, and a low-priority thread
+// periodically prints the median (p50), 99th percentile (p99) and maximum
+// of each zone to the console and optionally to a CSV file.
+
+#pragma once
+
+#include <Bela.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
+#include <cmath>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace dsp {
+
+// Read a free-running counter that increases at a constant rate. Where the CPU
+// gives user code access to a cycle or timer register we read it directly,
+// which takes only a few cycles. On the BeagleBone (ARMv7) the cycle counter
+// is normally locked to the kernel, so we fall back to the monotonic clock.
+inline uint64_t readCycleCounter()
+{
+#if defined(__aarch64__)
+	uint64_t value;
+	asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+	return value;
+#elif defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+// Histogram of durations measured in counter ticks. Each power of two is split
+// into 8 buckets, so any value can be recovered to within about 6%. Only one
+// thread may call record(); any other thread may read the counts at the same
+// time without taking a lock.
+class ProfilerHistogram {
+public:
+	static const int kSubBuckets = 8;					// Buckets per power of two
+	static const int kNumBuckets = 48 * kSubBuckets;	// Enough for 2^48 ticks
+
+	ProfilerHistogram() { reset(); }
+
+	// Add one measurement to the histogram (audio thread only)
+	void record(uint64_t ticks);
+
+	// Clear all the measurements (only when nobody is recording)
+	void reset();
+
+	// Number of measurements so far
+	uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+	// Largest measurement so far
+	uint64_t maximum() const { return max_.load(std::memory_order_relaxed); }
+
+	// Value below which the given fraction (0-1) of measurements fall
+	uint64_t percentile(float fraction) const;
+
+	// Number of measurements in one bucket, for exporting the whole histogram
+	uint32_t bucketCount(int bucket) const { return buckets_[bucket].load(std::memory_order_relaxed); }
+
+	// Convert a value to a bucket and a bucket back to its lowest value
+	static int bucketForValue(uint64_t ticks);
+	static uint64_t valueForBucket(int bucket);
+
+private:
+	std::atomic<uint32_t> buckets_[kNumBuckets];
+	std::atomic<uint64_t> count_;
+	std::atomic<uint64_t> max_;
+};
+
+class RenderProfiler {
+public:
+	// Zone 0 is always the whole of render(); other zones are named in setup()
+	static const int kRenderZone = 0;
+
+	// Constructor
+	RenderProfiler() {}
+
+	// Prepare the profiler for the given zone names. A report is produced every
+	// reportInterval seconds; if filename is not empty, reports are also
+	// written to that file in CSV format. Returns true on success.
+	bool setup(BelaContext *context, const std::vector<std::string>& zoneNames,
+			   float reportInterval = 1.0, const std::string& filename = "");
+
+	// Call at the very start and end of render()
+	void beginRender() { begin(kRenderZone); }
+	void endRender();
+
+	// Call around a section of code inside render()
+	void begin(int zone) { zoneStart_[zone] = readCycleCounter(); }
+	void end(int zone) { zones_[zone].record(readCycleCounter() - zoneStart_[zone]); }
+
+	// Number of blocks where render() took longer than the block period
+	unsigned int overruns() { return overruns_.load(std::memory_order_relaxed); }
+
+	// Print the current statistics (called automatically in the background,
+	// and can be called from cleanup() for a final summary after stop())
+	void report();
+
+	// Stop starting background reports and wait for one in progress to
+	// finish, so that report() can safely be called from cleanup()
+	void stop();
+
+	// Measure how many counter ticks there are per microsecond
+	static double calibrate();
+
+	// Destructor
+	~RenderProfiler();
+
+private:
+	// Callback that runs in the auxiliary task
+	static void reportCallback(void *arg);
+
+	std::vector<std::string> zoneNames_;		// Name of each zone, including render
+	std::vector<ProfilerHistogram> zones_;		// Histogram of durations for each zone
+	std::vector<uint64_t> zoneStart_;			// Counter value at the start of each zone
+	std::atomic<unsigned int> overruns_{0};		// Number of blocks that missed the deadline
+
+	double ticksPerMicrosecond_ = 1.0;			// Conversion from counter ticks to time
+	double blockPeriod_ = 0;					// Time available per block, in microseconds
+	uint64_t blockPeriodTicks_ = 0;				// Same thing in counter ticks
+	unsigned int blocksPerReport_ = 0;			// How often to produce a report
+	unsigned int blockCounter_ = 0;				// Blocks since the last report
+	unsigned int reportCounter_ = 0;			// Number of reports so far
+
+	AuxiliaryTask reportTask_ = 0;				// Background thread for reporting
+	std::atomic<bool> reportBusy_{false};		// A report is scheduled or running
+	std::atomic<bool> stopped_{false};			// Set by stop(): no more background reports
+	FILE *file_ = nullptr;						// CSV output, if requested
+};
+
+// Helper which measures the zone for as long as it stays in scope, e.g.
+// { ProfilerZone zone(gProfiler, kZoneFilter); ... }
+class ProfilerZone {
+public:
+	ProfilerZone(RenderProfiler& profiler, int zone) : profiler_(profiler), zone_(zone) {
+		profiler_.begin(zone_);
+	}
+	~ProfilerZone() { profiler_.end(zone_); }
+
+private:
+	RenderProfiler& profiler_;
+	int zone_;
+};
+
+// Add one measurement to the histogram. Only the audio thread writes, so
+// a plain load and store is enough; the atomics make sure the reporting
+// thread never sees a half-written value.
+inline void ProfilerHistogram::record(uint64_t ticks)
+{
+	std::atomic<uint32_t>& bucket = buckets_[bucketForValue(ticks)];
+	bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	if(ticks > max_.load(std::memory_order_relaxed))
+		max_.store(ticks, std::memory_order_relaxed);
+
+	// Publish the count last so a reader never sees more measurements than buckets
+	count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+// Clear all the measurements
+inline void ProfilerHistogram::reset()
+{
+	for(int i = 0; i < kNumBuckets; i++)
+		buckets_[i].store(0, std::memory_order_relaxed);
+	count_.store(0, std::memory_order_relaxed);
+	max_.store(0, std::memory_order_relaxed);
+}
+
+// Values below 8 get a bucket each. Above that, the bucket is chosen by the
+// position of the highest bit (which power of two) and the next three bits.
+inline int ProfilerHistogram::bucketForValue(uint64_t ticks)
+{
+	if(ticks < kSubBuckets)
+		return (int)ticks;
+
+	int highestBit = 63 - __builtin_clzll(ticks);
+	int subBucket = (ticks >> (highestBit - 3)) & (kSubBuckets - 1);
+	int bucket = (highestBit - 2) * kSubBuckets + subBucket;
+
+	if(bucket >= kNumBuckets)
+		bucket = kNumBuckets - 1;
+	return bucket;
+}
+
+// Lowest value which falls in the given bucket
+inline uint64_t ProfilerHistogram::valueForBucket(int bucket)
+{
+	if(bucket < kSubBuckets)
+		return bucket;
+
+	int highestBit = bucket / kSubBuckets + 2;
+	uint64_t subBucket = bucket % kSubBuckets;
+	return (kSubBuckets + subBucket) << (highestBit - 3);
+}
+
+// Walk through the buckets until we have seen the requested fraction of
+// the measurements
+inline uint64_t ProfilerHistogram::percentile(float fraction) const
+{
+	uint64_t total = count_.load(std::memory_order_acquire);
+	if(total == 0)
+		return 0;
+
+	uint64_t target = (uint64_t)ceilf(fraction * total);
+	if(target < 1)
+		target = 1;
+
+	uint64_t seen = 0;
+	for(int i = 0; i < kNumBuckets; i++) {
+		seen += buckets_[i].load(std::memory_order_relaxed);
+		if(seen >= target) {
+			// Report the middle of the bucket, but never more than the maximum
+			uint64_t value = (valueForBucket(i) + valueForBucket(i + 1)) / 2;
+			uint64_t maxValue = maximum();
+			return (value < maxValue) ? value : maxValue;
+		}
+	}
+	return maximum();
+}
+
+// Prepare the profiler for the given zone names
+inline bool RenderProfiler::setup(BelaContext *context, const std::vector<std::string>& zoneNames,
+						   float reportInterval, const std::string& filename)
+{
+	// Zone 0 is render() itself, followed by the zones given by the user
+	zoneNames_.clear();
+	zoneNames_.push_back("render");
+	zoneNames_.insert(zoneNames_.end(), zoneNames.begin(), zoneNames.end());
+
+	// Allocate everything here so nothing needs allocating in render()
+	zones_ = std::vector<ProfilerHistogram>(zoneNames_.size());
+	zoneStart_.assign(zoneNames_.size(), 0);
+
+	// Work out how much time each block has to be calculated in
+	ticksPerMicrosecond_ = calibrate();
+	blockPeriod_ = 1000000.0 * context->audioFrames / context->audioSampleRate;
+	blockPeriodTicks_ = (uint64_t)(blockPeriod_ * ticksPerMicrosecond_);
+
+	blocksPerReport_ = (unsigned int)(reportInterval * context->audioSampleRate / context->audioFrames);
+	if(blocksPerReport_ < 1)
+		blocksPerReport_ = 1;
+	blockCounter_ = 0;
+
+	// Open the output file if one was requested
+	if(filename != "") {
+		file_ = fopen(filename.c_str(), "w");
+		if(file_ == nullptr) {
+			rt_printf("RenderProfiler: unable to open '%s'\n", filename.c_str());
+			return false;
+		}
+		fprintf(file_, "report,zone,count,p50_us,p99_us,max_us,p99_percent,overruns\n");
+	}
+
+	// Reporting happens in a low-priority thread so it never disturbs the audio
+	reportTask_ = Bela_createAuxiliaryTask(reportCallback, 1, "bela-render-profiler", this);
+	if(reportTask_ == 0)
+		return false;
+
+	rt_printf("RenderProfiler: %.1fus per block, %.1f counter ticks per us\n",
+			  blockPeriod_, ticksPerMicrosecond_);
+	return true;
+}
+
+// Call at the very end of render()
+inline void RenderProfiler::endRender()
+{
+	uint64_t duration = readCycleCounter() - zoneStart_[kRenderZone];
+	zones_[kRenderZone].record(duration);
+
+	// Count the blocks that took longer than they were allowed
+	if(duration > blockPeriodTicks_)
+		overruns_.store(overruns_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	// Start a report from time to time, unless the last one is still going
+	if(++blockCounter_ >= blocksPerReport_) {
+		blockCounter_ = 0;
+		if(!stopped_.load(std::memory_order_relaxed) &&
+		   !reportBusy_.exchange(true, std::memory_order_acq_rel)) {
+			if(Bela_scheduleAuxiliaryTask(reportTask_) != 0)
+				reportBusy_.store(false, std::memory_order_release);
+		}
+	}
+}
+
+// Print the current statistics
+inline void RenderProfiler::report()
+{
+	reportCounter_++;
+	rt_printf("--- Render profile %u (%u overruns) ---\n", reportCounter_, overruns());
+
+	for(unsigned int i = 0; i < zones_.size(); i++) {
+		ProfilerHistogram& h = zones_[i];
+		double p50 = h.percentile(0.5) / ticksPerMicrosecond_;
+		double p99 = h.percentile(0.99) / ticksPerMicrosecond_;
+		double max = h.maximum() / ticksPerMicrosecond_;
+		double percent = 100.0 * p99 / blockPeriod_;
+
+		rt_printf("%-16s p50 %8.2fus  p99 %8.2fus (%5.1f%%)  max %8.2fus\n",
+				  zoneNames_[i].c_str(), p50, p99, percent, max);
+
+		if(file_ != nullptr) {
+			fprintf(file_, "%u,%s,%llu,%.3f,%.3f,%.3f,%.2f,%u\n", reportCounter_,
+					zoneNames_[i].c_str(), (unsigned long long)h.count(),
+					p50, p99, max, percent, overruns());
+		}
+	}
+
+	if(file_ != nullptr)
+		fflush(file_);
+}
+
+// Callback that runs in the auxiliary task
+inline void RenderProfiler::reportCallback(void *arg)
+{
+	RenderProfiler *profiler = static_cast<RenderProfiler*>(arg);
+	profiler->report();
+	profiler->reportBusy_.store(false, std::memory_order_release);
+}
+
+// Wait for the background report to finish. Bela only stops auxiliary
+// tasks after cleanup() returns, so a report that has been scheduled always
+// runs, and there is no need for a timeout. Giving up early would let the
+// destructor close the file while the report is still writing to it.
+inline void RenderProfiler::stop()
+{
+	stopped_.store(true, std::memory_order_relaxed);
+	while(reportBusy_.load(std::memory_order_acquire))
+		usleep(1000);
+}
+
+// Compare the counter against the system clock over a short period
+inline double RenderProfiler::calibrate()
+{
+	struct timespec startTime, endTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &startTime);
+	uint64_t startTicks = readCycleCounter();
+	usleep(20000);
+	uint64_t endTicks = readCycleCounter();
+	clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+	double elapsed = (endTime.tv_sec - startTime.tv_sec) * 1000000.0 +
+					 (endTime.tv_nsec - startTime.tv_nsec) / 1000.0;
+	if(elapsed <= 0)
+		return 1.0;
+	return (endTicks - startTicks) / elapsed;
+}
+
+// Destructor: close the output file, unless stop() wasn't called and a
+// background report could still be writing to it
+inline RenderProfiler::~RenderProfiler()
+{
+	if(file_ != nullptr && !reportBusy_.load(std::memory_order_acquire))
+		fclose(file_);
+}
+
+} // namespace dsp
+
+using dsp::readCycleCounter;
+using dsp::ProfilerHistogram;
+using dsp::RenderProfiler;
+using dsp::ProfilerZone;
\ No newline at end of file
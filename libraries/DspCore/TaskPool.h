@@ -0,0 +1,412 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// TaskPool.h: a shared pool of background threads for the jobs that would
+// otherwise each need their own AuxiliaryTask, such as FFT processing, file
+// loading or sending data to the GUI. Tasks are created in setup() with a
+// priority, then scheduled from render() without allocating or locking.
+//
+// Each task waits in a WorkStealingDeque belonging to one worker, chosen in
+// turn, with one deque per priority. A worker takes the most urgent task from
+// its own deques, or steals one from another worker's if its own are empty.
+// Priorities decide which task runs next; a running task is never
+// interrupted for a more urgent one.
+//
+// A task can also be scheduled with a deadline, in audio frames, by which it
+// needs to have finished: for example the frame at which render() starts
+// reading the output of an FFT hop. Tasks with deadlines run before all
+// others, earliest deadline first, so that when several jobs share the
+// workers the one closest to running out of time goes next. A task which
+// finishes after its deadline is counted as a miss.
+//
+// Like an AuxiliaryTask, a task never runs on two threads at once: scheduling
+// a task which is waiting does nothing, and scheduling one which is running
+// makes it run again when it finishes.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <string>
+#include <pthread.h>
+#include <semaphore.h>
+#include "WorkStealingDeque.h"
+
+namespace dsp {
+
+class TaskPool {
+public:
+	// How urgent a task is, most urgent first
+	enum Priority {
+		kPriorityHigh = 0,
+		kPriorityNormal,
+		kPriorityLow,
+		kNumPriorities
+	};
+
+	// Most tasks a pool can have
+	static const unsigned int kMaxTasks = 64;
+
+	// A task created by createTask()
+	class Task;
+
+	// Constructor
+	TaskPool() {}
+
+	// Start numWorkers threads at the given real-time priority. Returns false
+	// if the threads couldn't be started.
+	bool setup(unsigned int numWorkers, int threadPriority = 50);
+
+	// Stop the workers once the tasks they are running have finished
+	void cleanup();
+
+	// Create a task which calls callback(arg). Call from setup(). Returns
+	// nullptr if the pool already has kMaxTasks tasks.
+	Task* createTask(void (*callback)(void*), void *arg, Priority priority, const char *name);
+
+	// Ask for a task to run. Safe to call from render(), but only from one
+	// thread. Returns false if the task was already waiting to run.
+	bool schedule(Task *task);
+
+	// Ask for a task to finish by the given frame, comparable with
+	// setCurrentFrame(). If the task is already waiting with a deadline, its
+	// deadline becomes the earlier of the two. If it is waiting without one,
+	// from schedule(task), it stays where it is and the new deadline is
+	// ignored. Same rules as schedule() otherwise.
+	bool schedule(Task *task, uint64_t deadlineFrame);
+
+	// Tell the pool the time, in frames: call at the start of each render()
+	// with context->audioFramesElapsed when using deadlines
+	void setCurrentFrame(uint64_t frame) { currentFrame_.store(frame, std::memory_order_relaxed); }
+
+	// Number of times a task has finished running
+	unsigned int numRuns(Task *task);
+
+	// Number of times a task finished after its deadline, and the latest it
+	// has been, in frames
+	unsigned int numMisses(Task *task);
+	unsigned int maxLateness(Task *task);
+
+	unsigned int numWorkers() { return workers_.size(); }
+
+	// Destructor
+	~TaskPool() { cleanup(); }
+
+	TaskPool(const TaskPool&) = delete;
+	TaskPool& operator=(const TaskPool&) = delete;
+
+	class Task {
+		friend class TaskPool;
+		enum State {
+			kIdle = 0,			// Not waiting or running
+			kQueued,			// Waiting for a worker
+			kRunning,			// Being run by a worker
+			kRunningQueued		// Being run, and scheduled again since it started
+		};
+		void (*callback_)(void*);
+		void *arg_;
+		Priority priority_;
+		unsigned int index_;	// Position in the pool's list of tasks
+		std::string name_;
+		std::atomic<int> state_{kIdle};
+		std::atomic<unsigned int> runs_{0};
+		std::atomic<bool> hasDeadline_{false};	// Whether it waits for the deadline scan rather than in a deque
+		std::atomic<uint64_t> deadline_{0};		// Frame by which it should finish
+		std::atomic<unsigned int> misses_{0};
+		std::atomic<unsigned int> maxLateness_{0};
+	};
+
+private:
+	struct Worker {
+		TaskPool *pool;
+		unsigned int index;
+		pthread_t thread;
+		WorkStealingDeque<kMaxTasks> deques[kNumPriorities];	// Filled by schedule()
+	};
+
+	static void* workerLoop(void *arg);
+	bool takeDeadlineTask(unsigned int& task);
+	bool takeTask(unsigned int worker, unsigned int& task);
+	void runTask(Task& task);
+	void finishRun(Task& task, bool hasDeadline, uint64_t deadline);
+
+	std::vector<std::unique_ptr<Task>> tasks_;
+	std::vector<std::unique_ptr<Worker>> workers_;
+	unsigned int nextWorker_ = 0;				// Where schedule() puts the next task
+	sem_t waiting_;								// Counts tasks waiting for a worker
+	bool semaphoreReady_ = false;				// Whether waiting_ needs destroying
+	std::atomic<bool> stop_{false};
+	std::atomic<uint64_t> currentFrame_{0};		// Time given by setCurrentFrame()
+};
+
+inline bool TaskPool::setup(unsigned int numWorkers, int threadPriority)
+{
+	cleanup();
+	if(numWorkers == 0 || sem_init(&waiting_, 0, 0) != 0)
+		return false;
+	semaphoreReady_ = true;
+	stop_ = false;
+
+	for(unsigned int i = 0; i < numWorkers; i++) {
+		std::unique_ptr<Worker> worker(new Worker);
+		worker->pool = this;
+		worker->index = i;
+
+		// Ask for a real-time thread, falling back to an ordinary one
+		pthread_attr_t attributes;
+		pthread_attr_init(&attributes);
+		sched_param parameters = {};
+		parameters.sched_priority = threadPriority;
+		pthread_attr_setinheritsched(&attributes, PTHREAD_EXPLICIT_SCHED);
+		pthread_attr_setschedpolicy(&attributes, SCHED_FIFO);
+		pthread_attr_setschedparam(&attributes, &parameters);
+		int result = pthread_create(&worker->thread, &attributes, workerLoop, worker.get());
+		if(result != 0)
+			result = pthread_create(&worker->thread, nullptr, workerLoop, worker.get());
+		pthread_attr_destroy(&attributes);
+		if(result != 0) {
+			cleanup();
+			return false;
+		}
+
+		std::string name = "bela-task-pool-" + std::to_string(i);
+		pthread_setname_np(worker->thread, name.c_str());
+		workers_.push_back(std::move(worker));
+	}
+	return true;
+}
+
+inline void TaskPool::cleanup()
+{
+	if(!workers_.empty()) {
+		stop_ = true;
+		for(unsigned int i = 0; i < workers_.size(); i++)
+			sem_post(&waiting_);
+		for(std::unique_ptr<Worker>& worker : workers_)
+			pthread_join(worker->thread, nullptr);
+		workers_.clear();
+	}
+
+	// The semaphore has to go even if setup() failed before starting a worker
+	if(semaphoreReady_) {
+		sem_destroy(&waiting_);
+		semaphoreReady_ = false;
+	}
+}
+
+inline TaskPool::Task* TaskPool::createTask(void (*callback)(void*), void *arg, Priority priority, const char *name)
+{
+	if(tasks_.size() >= kMaxTasks)
+		return nullptr;
+	Task *task = new Task;
+	task->callback_ = callback;
+	task->arg_ = arg;
+	task->priority_ = priority;
+	task->index_ = tasks_.size();
+	task->name_ = name;
+	tasks_.emplace_back(task);
+	return task;
+}
+
+inline bool TaskPool::schedule(Task *task)
+{
+	if(task == nullptr || workers_.empty())
+		return false;
+
+	// Mark the task as waiting, unless it already is. Without a deadline it
+	// waits in a deque, where the deadline scan doesn't see it.
+	int state = task->state_.load(std::memory_order_acquire);
+	if(state == Task::kQueued || state == Task::kRunningQueued)
+		return false;
+	task->hasDeadline_.store(false, std::memory_order_relaxed);
+	while(true) {
+		if(state == Task::kQueued || state == Task::kRunningQueued)
+			return false;
+		int next = (state == Task::kIdle) ? Task::kQueued : Task::kRunningQueued;
+		if(task->state_.compare_exchange_weak(state, next, std::memory_order_acq_rel))
+			break;
+	}
+
+	// A running task is run again by its worker when it finishes
+	if(state == Task::kRunning)
+		return true;
+
+	// Each task is in a deque at most once, so the deques never fill up
+	Worker& worker = *workers_[nextWorker_];
+	nextWorker_ = (nextWorker_ + 1) % workers_.size();
+	worker.deques[task->priority_].push(task->index_);
+	sem_post(&waiting_);
+	return true;
+}
+
+inline bool TaskPool::schedule(Task *task, uint64_t deadlineFrame)
+{
+	if(task == nullptr || workers_.empty())
+		return false;
+
+	// Set the deadline before the task can be seen as waiting. If it is
+	// already waiting, only ever bring its deadline forward. A task waiting in
+	// a deque can't be taken out of it, and giving it a deadline there would
+	// let the deadline scan run it a second time, so it keeps no deadline.
+	int state = task->state_.load(std::memory_order_acquire);
+	if(state == Task::kQueued || state == Task::kRunningQueued) {
+		if(task->hasDeadline_.load(std::memory_order_relaxed) &&
+		   deadlineFrame < task->deadline_.load(std::memory_order_relaxed))
+			task->deadline_.store(deadlineFrame, std::memory_order_relaxed);
+		return false;
+	}
+	task->deadline_.store(deadlineFrame, std::memory_order_relaxed);
+	task->hasDeadline_.store(true, std::memory_order_relaxed);
+
+	while(true) {
+		if(state == Task::kQueued || state == Task::kRunningQueued)
+			return false;
+		int next = (state == Task::kIdle) ? Task::kQueued : Task::kRunningQueued;
+		if(task->state_.compare_exchange_weak(state, next, std::memory_order_acq_rel))
+			break;
+	}
+
+	// Workers find queued tasks with deadlines by looking at every task, so
+	// there is no deque to add it to. A running task is re-queued by its worker.
+	if(state == Task::kIdle)
+		sem_post(&waiting_);
+	return true;
+}
+
+inline unsigned int TaskPool::numRuns(Task *task)
+{
+	return task->runs_.load(std::memory_order_relaxed);
+}
+
+inline unsigned int TaskPool::numMisses(Task *task)
+{
+	return task->misses_.load(std::memory_order_relaxed);
+}
+
+inline unsigned int TaskPool::maxLateness(Task *task)
+{
+	return task->maxLateness_.load(std::memory_order_relaxed);
+}
+
+// Claim the waiting task with the earliest deadline. The pool has few tasks,
+// so looking at all of them is quicker than keeping them sorted.
+inline bool TaskPool::takeDeadlineTask(unsigned int& task)
+{
+	while(true) {
+		int earliest = -1;
+		uint64_t earliestDeadline = UINT64_MAX;
+		for(unsigned int i = 0; i < tasks_.size(); i++) {
+			Task& candidate = *tasks_[i];
+			if(candidate.state_.load(std::memory_order_acquire) != Task::kQueued ||
+			   !candidate.hasDeadline_.load(std::memory_order_relaxed))
+				continue;
+			uint64_t deadline = candidate.deadline_.load(std::memory_order_relaxed);
+			if(deadline < earliestDeadline) {
+				earliest = i;
+				earliestDeadline = deadline;
+			}
+		}
+		if(earliest < 0)
+			return false;
+
+		// Another worker may claim it first, in which case look again
+		int state = Task::kQueued;
+		if(tasks_[earliest]->state_.compare_exchange_strong(state, Task::kRunning, std::memory_order_acq_rel)) {
+			task = earliest;
+			return true;
+		}
+	}
+}
+
+// Take the task with the earliest deadline, or else the most urgent task from
+// this worker's deques, or else from another's
+inline bool TaskPool::takeTask(unsigned int worker, unsigned int& task)
+{
+	if(takeDeadlineTask(task))
+		return true;
+	for(unsigned int priority = 0; priority < kNumPriorities; priority++) {
+		for(unsigned int i = 0; i < workers_.size(); i++) {
+			Worker& victim = *workers_[(worker + i) % workers_.size()];
+			while(!victim.deques[priority].empty()) {
+				if(victim.deques[priority].steal(task))
+					return true;
+			}
+		}
+	}
+	return false;
+}
+
+inline void TaskPool::runTask(Task& task)
+{
+	task.state_.store(Task::kRunning, std::memory_order_release);
+	while(true) {
+		bool hasDeadline = task.hasDeadline_.load(std::memory_order_relaxed);
+		uint64_t deadline = task.deadline_.load(std::memory_order_relaxed);
+		task.callback_(task.arg_);
+		finishRun(task, hasDeadline, deadline);
+
+		// Finish, unless the task was scheduled again while it ran
+		int state = Task::kRunning;
+		if(task.state_.compare_exchange_strong(state, Task::kIdle, std::memory_order_acq_rel))
+			return;
+
+		// With a deadline, it waits its turn among the other deadlines
+		if(task.hasDeadline_.load(std::memory_order_relaxed)) {
+			task.state_.store(Task::kQueued, std::memory_order_release);
+			sem_post(&waiting_);
+			return;
+		}
+		task.state_.store(Task::kRunning, std::memory_order_release);
+	}
+}
+
+// Count the run, and whether it missed its deadline
+inline void TaskPool::finishRun(Task& task, bool hasDeadline, uint64_t deadline)
+{
+	task.runs_.fetch_add(1, std::memory_order_relaxed);
+	if(!hasDeadline)
+		return;
+	uint64_t now = currentFrame_.load(std::memory_order_relaxed);
+	if(now > deadline) {
+		unsigned int lateness = now - deadline;
+		task.misses_.fetch_add(1, std::memory_order_relaxed);
+		if(lateness > task.maxLateness_.load(std::memory_order_relaxed))
+			task.maxLateness_.store(lateness, std::memory_order_relaxed);
+	}
+}
+
+inline void* TaskPool::workerLoop(void *arg)
+{
+	Worker& worker = *(Worker *)arg;
+	TaskPool& pool = *worker.pool;
+
+	while(true) {
+		// Each post of the semaphore is one task to run (or a request to stop)
+		while(sem_wait(&pool.waiting_) != 0)
+			;
+		if(pool.stop_.load(std::memory_order_acquire))
+			break;
+
+		// The task posted might have been taken already by a worker that
+		// woke for another one, in which case there is nothing to do
+		unsigned int task;
+		if(pool.takeTask(worker.index, task))
+			pool.runTask(*pool.tasks_[task]);
+	}
+	return nullptr;
+}
+
+} // namespace dsp
+
+using dsp::TaskPool;
\ No newline at end of file
@@ -0,0 +1,271 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// UnisonOscillator.h: a sawtooth played by up to 16 detuned copies at once,
+// spread across the stereo field, for the thick "supersaw" sound.
+//
+// All the copies read the same band-limited sawtooth table, with as many
+// harmonics as fit below the Nyquist frequency at the pitch of the highest
+// copy. The tables for every octave are made in setup(). The copies are
+// worked out four at a time, one in each lane of a NEON or SSE2 register,
+// so each extra copy costs a fraction of a separate oscillator: the phase
+// update, interpolation and panning of four copies take one instruction
+// each, and the table they read stays in the cache.
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include "FastMath.h"
+
+namespace dsp {
+
+class UnisonOscillator {
+public:
+	static const unsigned int kMaxVoices = 16;
+
+	// Every table has 2^kTableBits points, plus a copy of the first. Level
+	// k has harmonics up to 1024 / 2^k (1023 for level 0).
+	static const unsigned int kTableBits = 11;
+	static const unsigned int kTableSize = 1 << kTableBits;
+	static const unsigned int kNumLevels = kTableBits;
+
+	UnisonOscillator() {}											// Default constructor
+	UnisonOscillator(float sampleRate) { setup(sampleRate); }		// Constructor with arguments
+
+	// Make the tables. This allocates memory, so call it from setup().
+	void setup(float sampleRate) {
+		sampleRate_ = sampleRate;
+		buildTables();
+		updateVoices();
+		reset();
+	}
+
+	// Seed the generator used to choose random starting phases, so that a
+	// sequence of notes sounds the same every time it is played
+	void setSeed(uint32_t seed) { random_ = seed ? seed : 1; }
+
+	// Start a note: every copy starts from phase 0, plus a random amount
+	// set by setPhaseRandomness(). The scaling is done in 64-bit integers,
+	// since a float product could round up to 2^32, which doesn't fit.
+	void reset() {
+		uint64_t scale = (uint64_t)(phaseRandomness_ * 65536.0f);
+		for(unsigned int i = 0; i < kMaxVoices; i++)
+			phase_[i] = (uint32_t)(((uint64_t)nextRandom() * scale) >> 16);
+	}
+
+	// Set the frequency of the centre of the detuned copies
+	void setFrequency(float f) {
+		frequency_ = f;
+		updateVoices();
+	}
+	float getFrequency() { return frequency_; }
+
+	// Set how many copies play, from 1 to 16
+	void setNumVoices(unsigned int voices) {
+		numVoices_ = std::min(std::max(voices, 1u), kMaxVoices);
+		updateVoices();
+	}
+	unsigned int getNumVoices() { return numVoices_; }
+
+	// Set the spread between the lowest and highest copies, in cents
+	void setDetune(float cents) {
+		detune_ = std::max(cents, 0.0f);
+		updateVoices();
+	}
+
+	// Set how far the copies are spread across the stereo field, from 0
+	// (all in the centre) to 1 (the outermost copies fully left and right)
+	void setStereoWidth(float width) {
+		width_ = std::min(std::max(width, 0.0f), 1.0f);
+		updateVoices();
+	}
+
+	// Set how much of a cycle each copy's starting phase can be moved by at
+	// random when a note starts, from 0 (all in phase) to 1
+	void setPhaseRandomness(float amount) {
+		phaseRandomness_ = std::min(std::max(amount, 0.0f), 1.0f);
+	}
+
+	// The level used for the current frequency and detune (0 has every
+	// harmonic)
+	unsigned int getLevel() { return level_; }
+
+	// Fill two buffers with the next frames samples of the left and right
+	// channels
+	inline void process(float * __restrict left, float * __restrict right, unsigned int frames);
+
+	~UnisonOscillator() {}				// Destructor
+
+private:
+	void buildTables();
+	void updateVoices();
+
+	// xorshift32: fast, and good enough for starting phases
+	uint32_t nextRandom() {
+		random_ ^= random_ << 13;
+		random_ ^= random_ >> 17;
+		random_ ^= random_ << 5;
+		return random_;
+	}
+
+	std::vector<float> tables_;		// kNumLevels tables of kTableSize + 1 points
+
+	float sampleRate_ = 44100;
+	float frequency_ = 0;
+	unsigned int numVoices_ = 7;
+	float detune_ = 50;
+	float width_ = 1;
+	float phaseRandomness_ = 1;
+	uint32_t random_ = 1;
+	unsigned int level_ = 0;
+
+	// One entry per copy, in groups of four for the vector registers.
+	// Copies beyond numVoices_ have zero gain.
+	uint32_t phase_[kMaxVoices] = {};
+	uint32_t increment_[kMaxVoices] = {};
+	float leftGain_[kMaxVoices] = {};
+	float rightGain_[kMaxVoices] = {};
+};
+
+// Sum the harmonics of a rising sawtooth, -2/pi * sin(2 pi h t) / h. The
+// sines are read from one cycle of kTableSize points, since h * n wraps
+// round it exactly.
+inline void UnisonOscillator::buildTables()
+{
+	std::vector<double> sine(kTableSize);
+	for(unsigned int n = 0; n < kTableSize; n++)
+		sine[n] = sin(2.0 * M_PI * n / kTableSize);
+
+	tables_.assign(kNumLevels * (kTableSize + 1), 0);
+	std::vector<double> sum(kTableSize);
+	for(unsigned int level = 0; level < kNumLevels; level++) {
+		unsigned int harmonics = std::min((kTableSize / 2) >> level, kTableSize / 2 - 1);
+		std::fill(sum.begin(), sum.end(), 0.0);
+		for(unsigned int h = 1; h <= harmonics; h++) {
+			double amplitude = -2.0 / (M_PI * h);
+			for(unsigned int n = 0; n < kTableSize; n++)
+				sum[n] += amplitude * sine[(h * n) & (kTableSize - 1)];
+		}
+		float *table = &tables_[level * (kTableSize + 1)];
+		for(unsigned int n = 0; n < kTableSize; n++)
+			table[n] = sum[n];
+		table[kTableSize] = table[0];
+	}
+}
+
+// Work out the frequency and pan of each copy. The copies are spaced evenly
+// from the lowest to the highest, and alternate between left and right so
+// that both sides get low and high copies.
+inline void UnisonOscillator::updateVoices()
+{
+	float gain = 1.0f / sqrtf((float)numVoices_);
+	float highest = frequency_;
+	for(unsigned int i = 0; i < kMaxVoices; i++) {
+		if(i >= numVoices_) {
+			increment_[i] = 0;
+			leftGain_[i] = rightGain_[i] = 0;
+			continue;
+		}
+		// Position from -1 (lowest) to 1 (highest)
+		float position = numVoices_ > 1 ? 2.0f * i / (numVoices_ - 1) - 1.0f : 0;
+		float f = frequency_ * fastExp2(position * detune_ * (0.5f / 1200.0f));
+		highest = std::max(highest, f);
+		float increment = std::min(std::max(f / sampleRate_, 0.0f), 0.49f);
+		increment_[i] = (uint32_t)(increment * 4294967296.0);
+
+		// Equal-power panning
+		float pan = width_ * ((i & 1) ? -position : position);
+		float angle = (pan + 1.0f) * (float)(M_PI / 4.0);
+		leftGain_[i] = gain * cosf(angle);
+		rightGain_[i] = gain * sinf(angle);
+	}
+
+	// Choose the table with the most harmonics that stay below the Nyquist
+	// frequency for the highest copy
+	level_ = 0;
+	while(level_ + 1 < kNumLevels
+		  && std::min((kTableSize / 2) >> level_, kTableSize / 2 - 1) * highest > 0.5f * sampleRate_)
+		level_++;
+}
+
+// Fill two buffers with the next frames samples. Each group of four copies
+// reads the same table: the top kTableBits of the phase are the index and
+// the next 16 the fraction between points.
+inline void UnisonOscillator::process(float * __restrict left, float * __restrict right, unsigned int frames)
+{
+	if(tables_.empty()) {
+		std::fill(left, left + frames, 0.0f);
+		std::fill(right, right + frames, 0.0f);
+		return;
+	}
+	const float *table = &tables_[level_ * (kTableSize + 1)];
+	const unsigned int numGroups = (numVoices_ + 3) / 4;
+
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	Int4 phase[kMaxVoices / 4], increment[kMaxVoices / 4];
+	Float4 leftGain[kMaxVoices / 4], rightGain[kMaxVoices / 4];
+	for(unsigned int g = 0; g < numGroups; g++) {
+		phase[g] = loadInt4((const int32_t *)&phase_[4 * g]);
+		increment[g] = loadInt4((const int32_t *)&increment_[4 * g]);
+		leftGain[g] = load4(&leftGain_[4 * g]);
+		rightGain[g] = load4(&rightGain_[4 * g]);
+	}
+	const Int4 fractionMask = setInt4(0xFFFF);
+	const Float4 fractionScale = set4(1.0f / 65536.0f);
+
+	for(unsigned int n = 0; n < frames; n++) {
+		Float4 leftSum = set4(0.0f), rightSum = set4(0.0f);
+		for(unsigned int g = 0; g < numGroups; g++) {
+			int32_t index[4];
+			storeInt4(index, shiftRightUnsigned4<32 - kTableBits>(phase[g]));
+			Float4 fraction = mul4(toFloat4(andInt4(shiftRightUnsigned4<16 - kTableBits>(phase[g]), fractionMask)),
+								   fractionScale);
+			Float4 below = set4(table[index[0]], table[index[1]], table[index[2]], table[index[3]]);
+			Float4 above = set4(table[index[0] + 1], table[index[1] + 1], table[index[2] + 1], table[index[3] + 1]);
+			Float4 value = add4(below, mul4(fraction, sub4(above, below)));
+			leftSum = add4(leftSum, mul4(value, leftGain[g]));
+			rightSum = add4(rightSum, mul4(value, rightGain[g]));
+			phase[g] = addInt4(phase[g], increment[g]);
+		}
+		float lanes[8];
+		store4(lanes, leftSum);
+		store4(lanes + 4, rightSum);
+		left[n] = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+		right[n] = (lanes[4] + lanes[5]) + (lanes[6] + lanes[7]);
+	}
+
+	for(unsigned int g = 0; g < numGroups; g++)
+		storeInt4((int32_t *)&phase_[4 * g], phase[g]);
+#else
+	for(unsigned int n = 0; n < frames; n++) {
+		float leftSum = 0, rightSum = 0;
+		for(unsigned int i = 0; i < 4 * numGroups; i++) {
+			uint32_t index = phase_[i] >> (32 - kTableBits);
+			float fraction = (float)((phase_[i] >> (16 - kTableBits)) & 0xFFFF) * (1.0f / 65536.0f);
+			float value = table[index] + fraction * (table[index + 1] - table[index]);
+			leftSum += value * leftGain_[i];
+			rightSum += value * rightGain_[i];
+			phase_[i] += increment_[i];
+		}
+		left[n] = leftSum;
+		right[n] = rightSum;
+	}
+#endif
+}
+
+} // namespace dsp
+
+using dsp::UnisonOscillator;
\ No newline at end of file
@@ -0,0 +1,115 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// Wavetable.h: wavetable oscillator. Everything is defined in this header so
+// that the compiler can inline process() into the loop in render().
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+
+namespace dsp {
+
+class Wavetable {
+public:
+	Wavetable() {}													// Default constructor
+	Wavetable(float sampleRate, std::vector<float>& table, 			// Constructor with arguments
+			  bool useInterpolation = true) {
+		setup(sampleRate, table, useInterpolation);
+	}
+
+	// Set parameters
+	void setup(float sampleRate, std::vector<float>& table, bool useInterpolation = true) {
+		// It's faster to multiply than to divide on most platforms, so we save the inverse
+		// of the sample rate for use in the phase calculation later
+		inverseSampleRate_ = 1.0 / sampleRate;
+
+		// Copy other parameters
+		table_ = table;
+		tableSize_ = table_.size();
+		useInterpolation_ = useInterpolation;
+
+		// Initialise the starting state
+		readPointer_ = 0;
+		setFrequency(frequency_);
+	}
+
+	// Set the oscillator frequency. The phase increment is worked out here
+	// rather than on every sample.
+	void setFrequency(float f) {
+		frequency_ = f;
+		phaseIncrement_ = tableSize_ * frequency_ * inverseSampleRate_;
+	}
+
+	// Get the oscillator frequency
+	float getFrequency() { return frequency_; }
+
+	// Get the next sample and update the phase
+	inline float process();
+
+	// Fill a buffer with the next frames samples
+	inline void process(float * __restrict output, unsigned int frames);
+
+	~Wavetable() {}				// Destructor
+
+private:
+	std::vector<float> table_;	// Buffer holding the wavetable
+
+	float inverseSampleRate_ = 1.0;	// 1 divided by the audio sample rate
+	float frequency_ = 0;			// Frequency of the oscillator
+	float phaseIncrement_ = 0;		// Amount the read pointer moves each sample
+	float readPointer_ = 0;			// Location of the read pointer (phase of oscillator)
+	int tableSize_ = 0;				// Number of samples in the table
+	bool useInterpolation_ = true;	// Whether to use linear interpolation
+};
+
+// Get the next sample and update the phase
+inline float Wavetable::process() {
+	// Make sure we have a valid table
+	if(tableSize_ == 0)
+		return 0;
+
+	const float * __restrict table = table_.data();
+
+	// Increment and wrap the phase
+	readPointer_ += phaseIncrement_;
+	while(readPointer_ >= tableSize_)
+		readPointer_ -= tableSize_;
+	while(readPointer_ < 0)
+		readPointer_ += tableSize_;
+
+	if(!useInterpolation_) {
+		// Read the table without interpolation
+		return table[(int)readPointer_];
+	}
+
+	// Linear interpolation between the samples either side of the read
+	// pointer, wrapping around to 0 at the end of the table
+	int indexBelow = (int)readPointer_;
+	int indexAbove = indexBelow + 1;
+	if(indexAbove >= tableSize_)
+		indexAbove = 0;
+	float fractionAbove = readPointer_ - indexBelow;
+
+	return table[indexBelow] + fractionAbove * (table[indexAbove] - table[indexBelow]);
+}
+
+// Fill a buffer with the next frames samples
+inline void Wavetable::process(float * __restrict output, unsigned int frames) {
+	for(unsigned int n = 0; n < frames; n++)
+		output[n] = process();
+}
+
+} // namespace dsp
+
+using dsp::Wavetable;
\ No newline at end of file
@@ -0,0 +1,124 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// WavetableQ15.h: the wavetable oscillator from Wavetable.h in fixed point.
+// The table holds Q15 values and the phase is a 32-bit integer which wraps
+// round by itself at the end of the table, so no comparisons are needed.
+// Frequencies are exact to within sampleRate / 2^32 (about 0.00001Hz at
+// 44.1kHz) and the table can be any size.
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include "FixedPoint.h"
+
+namespace dsp {
+
+class WavetableQ15 {
+public:
+	WavetableQ15() {}												// Default constructor
+	WavetableQ15(float sampleRate, std::vector<float>& table,		// Constructor with arguments
+				 bool useInterpolation = true) {
+		setup(sampleRate, table, useInterpolation);
+	}
+
+	// Set parameters. The table is converted to Q15, so it must stay within
+	// -1 to 1.
+	void setup(float sampleRate, std::vector<float>& table, bool useInterpolation = true) {
+		inverseSampleRate_ = 1.0 / sampleRate;
+
+		table_.resize(table.size());
+		toFixed(table.data(), table_.data(), table.size());
+		tableSize_ = table_.size();
+		useInterpolation_ = useInterpolation;
+
+		// Initialise the starting state
+		phase_ = 0;
+		setFrequency(frequency_);
+	}
+
+	// Set the oscillator frequency. The phase increment is a fraction of a
+	// whole cycle, in units of 2^-32; a negative frequency wraps round to a
+	// large increment, which has the same effect.
+	void setFrequency(float f) {
+		frequency_ = f;
+		double cycles = fmod(frequency_ * inverseSampleRate_, 1.0);
+		phaseIncrement_ = (uint32_t)(int64_t)llrint(cycles * 4294967296.0);
+	}
+
+	// Get the oscillator frequency
+	float getFrequency() { return frequency_; }
+
+	// Get the next sample and update the phase
+	inline Q15 process();
+
+	// Fill a buffer with the next frames samples
+	inline void process(Q15 * __restrict output, unsigned int frames);
+
+	~WavetableQ15() {}			// Destructor
+
+private:
+	std::vector<Q15> table_;	// Buffer holding the wavetable
+
+	double inverseSampleRate_ = 1.0;	// 1 divided by the audio sample rate
+	float frequency_ = 0;				// Frequency of the oscillator
+	uint32_t phaseIncrement_ = 0;		// Amount the phase moves each sample
+	uint32_t phase_ = 0;				// Phase of the oscillator, 2^32 for a whole cycle
+	uint32_t tableSize_ = 0;			// Number of samples in the table
+	bool useInterpolation_ = true;		// Whether to use linear interpolation
+};
+
+// Get the next sample and update the phase
+inline Q15 WavetableQ15::process() {
+	// Make sure we have a valid table
+	if(tableSize_ == 0)
+		return Q15();
+
+	const Q15 * __restrict table = table_.data();
+
+	// Increment the phase, which wraps round by itself
+	phase_ += phaseIncrement_;
+
+	// Scale the phase to the table size: the top 32 bits of the product are
+	// the table index, and the next 15 are the fraction for interpolation
+	uint64_t position = (uint64_t)phase_ * tableSize_;
+	uint32_t indexBelow = position >> 32;
+
+	if(!useInterpolation_) {
+		// Read the table without interpolation
+		return table[indexBelow];
+	}
+
+	// Linear interpolation between the samples either side, wrapping round to
+	// 0 at the end of the table. The result lies between the two samples, so
+	// it can't overflow.
+	uint32_t indexAbove = indexBelow + 1;
+	if(indexAbove >= tableSize_)
+		indexAbove = 0;
+	int32_t fractionAbove = (position >> 17) & 0x7fff;
+	int32_t below = table[indexBelow].raw();
+	int32_t above = table[indexAbove].raw();
+
+	return Q15::fromRaw(below + ((fractionAbove * (above - below) + (1 << 14)) >> 15));
+}
+
+// Fill a buffer with the next frames samples
+inline void WavetableQ15::process(Q15 * __restrict output, unsigned int frames) {
+	for(unsigned int n = 0; n < frames; n++)
+		output[n] = process();
+}
+
+} // namespace dsp
+
+using dsp::WavetableQ15;
\ No newline at end of file
@@ -0,0 +1,371 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// WavetableScanner.h: an oscillator that moves smoothly through a stack of
+// single-cycle waveforms (frames), for example 64 frames of 2048 samples
+// each. The frames can be arranged in a grid and scanned in two dimensions.
+//
+// Each frame is stored at several sizes with fewer and fewer harmonics
+// (mipmaps), one for every octave. The oscillator reads the version with the
+// most harmonics that still all lie below the Nyquist frequency at the current
+// pitch, so even a frame with sharp edges doesn't alias. The versions are
+// made with the Fft class in setup(): each frame is transformed once, then for
+// each level the harmonics above the limit are removed and the inverse
+// transform is taken. The DC offset of each frame is removed too.
+//
+// The position between frames is worked out once per block: process() reads
+// the two frames either side of it (four in a grid) and crossfades between
+// them, with weights that move in a straight line from where the last block
+// ended to the position set by setPosition(). The phase is a 32-bit integer
+// that wraps round by itself, and the interpolation and crossfade work on four
+// samples at a time with NEON or SSE2.
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <libraries/AudioFile/AudioFile.h>
+#include <libraries/Fft/Fft.h>
+#include "FastMath.h"
+
+namespace dsp {
+
+class WavetableScanner {
+public:
+	// Smallest table stored for any level, so that linear interpolation stays
+	// accurate for the levels with only a few harmonics
+	static const unsigned int kMinTableSize = 256;
+
+	WavetableScanner() {}													// Default constructor
+	WavetableScanner(float sampleRate, const std::vector<float>& frames,	// Constructor with arguments
+					 unsigned int frameSize, unsigned int columns = 0) {
+		setup(sampleRate, frames, frameSize, columns);
+	}
+
+	// Build the tables from frames, which holds the frames one after another.
+	// frameSize must be a power of 2. With columns > 0 the frames form a grid
+	// of that many columns, and any frames left over after the last full row
+	// are ignored; with 0 they form a single row. Returns true on success.
+	// This allocates memory and runs several FFTs for each frame, so call it
+	// from setup() or a background task, never from render().
+	bool setup(float sampleRate, const std::vector<float>& frames, unsigned int frameSize,
+			   unsigned int columns = 0) {
+		sampleRate_ = sampleRate;
+		numFrames_ = 0;
+		tables_.clear();
+		levels_.clear();
+		if(!Fft::isPowerOfTwo(frameSize) || frameSize < 4 || frames.size() < frameSize)
+			return false;
+
+		unsigned int numFrames = frames.size() / frameSize;
+		columns_ = (columns == 0 || columns > numFrames) ? numFrames : columns;
+		rows_ = numFrames / columns_;
+		numFrames_ = columns_ * rows_;
+		frameSize_ = frameSize;
+
+		buildLevels(frames.data());
+
+		reset();
+		x_ = targetX_;
+		y_ = targetY_;
+		setFrequency(frequency_);
+		return true;
+	}
+
+	// Load the frames from a mono audio file, such as a wavetable exported
+	// from another synth, then build the tables as above. The frames are
+	// frameSize samples each, one after another in the file.
+	bool load(float sampleRate, const std::string& filename, unsigned int frameSize = 2048,
+			  unsigned int columns = 0) {
+		std::vector<float> frames = AudioFileUtilities::loadMono(filename);
+		return setup(sampleRate, frames, frameSize, columns);
+	}
+
+	// Start again from phase 0
+	void reset() { phase_ = 0; }
+
+	// Set the oscillator frequency, which also chooses the level to read from
+	void setFrequency(float f) {
+		frequency_ = f;
+		float increment = std::min(std::max(f / sampleRate_, 0.0f), 0.5f);
+		phaseIncrement_ = (uint32_t)(increment * 4294967296.0);
+		level_ = 0;
+		while(level_ + 1 < levels_.size() && levels_[level_].harmonics * f > 0.5f * sampleRate_)
+			level_++;
+	}
+
+	// Get the oscillator frequency
+	float getFrequency() { return frequency_; }
+
+	// Set the position to move to by the end of the next block, from 0 (the
+	// first frame) to 1 (the last). In a grid, x chooses the column and y the
+	// row. The position can move through several frames in one step, but each
+	// block only crossfades between neighbouring frames, so a big jump takes
+	// one block for each frame it passes.
+	void setPosition(float x, float y = 0) {
+		targetX_ = std::min(std::max(x, 0.0f), 1.0f) * (columns_ - 1);
+		targetY_ = std::min(std::max(y, 0.0f), 1.0f) * (rows_ - 1);
+	}
+
+	// Get the position reached at the end of the last block, from 0 to 1
+	float getPositionX() { return columns_ > 1 ? x_ / (columns_ - 1) : 0; }
+	float getPositionY() { return rows_ > 1 ? y_ / (rows_ - 1) : 0; }
+
+	unsigned int getNumFrames() { return numFrames_; }
+	unsigned int getColumns() { return columns_; }
+	unsigned int getRows() { return rows_; }
+	unsigned int getFrameSize() { return frameSize_; }
+	unsigned int getNumLevels() { return levels_.size(); }
+
+	// The level used at the current frequency (0 has every harmonic), and the
+	// number of harmonics it keeps
+	unsigned int getLevel() { return level_; }
+	unsigned int getHarmonics() { return levels_.empty() ? 0 : levels_[level_].harmonics; }
+
+	// Fill a buffer with the next frames samples, moving the position from
+	// where the last block ended to the one set by setPosition()
+	inline void process(float * __restrict output, unsigned int frames);
+
+	~WavetableScanner() {}				// Destructor
+
+private:
+	struct Level {
+		unsigned int harmonics;		// Highest harmonic kept
+		unsigned int bits;			// log2 of the table size
+		unsigned int offset;		// Start of this level's tables in tables_
+	};
+
+	// The frames to read in one block, and the weight of each at the start
+	// and its change per sample
+	struct Block {
+		const float *table[4];
+		float weight[4];
+		float step[4];
+	};
+
+	void buildLevels(const float *frames);
+	static void stepAxis(float& position, float target, unsigned int count,
+						 unsigned int& cell, float& startWeight, float& endWeight);
+	template<unsigned int kCorners>
+	inline void render(float * __restrict output, unsigned int frames, const Block& block);
+
+	std::vector<float> tables_;		// Every level of every frame
+	std::vector<Level> levels_;
+
+	float sampleRate_ = 44100;
+	unsigned int frameSize_ = 0;
+	unsigned int numFrames_ = 0;
+	unsigned int columns_ = 1;		// Frames in each row of the grid
+	unsigned int rows_ = 1;
+	unsigned int level_ = 0;		// Level chosen for the current frequency
+
+	float frequency_ = 0;
+	uint32_t phase_ = 0;			// Phase: a whole cycle is 2^32
+	uint32_t phaseIncrement_ = 0;
+
+	float x_ = 0, y_ = 0;			// Position reached, in frames
+	float targetX_ = 0, targetY_ = 0;	// Position to move to, in frames
+};
+
+// Make the tables. Level k keeps harmonics up to frameSize / 2^(k+1) (below
+// the Nyquist frequency of the frame, for level 0), in a table with at least 4
+// samples per cycle of its highest harmonic where the frame size allows, and
+// the last level is a sine wave. Each table has one
+// more sample at the end, a copy of the first, so reads never wrap.
+inline void WavetableScanner::buildLevels(const float *frames)
+{
+	unsigned int halfSize = frameSize_ / 2;
+	unsigned int totalSize = 0;
+	for(unsigned int harmonics = halfSize; harmonics >= 1; harmonics /= 2) {
+		Level level;
+		level.harmonics = std::min(harmonics, halfSize - 1);
+		unsigned int size = std::min(frameSize_, std::max(4 * harmonics, kMinTableSize));
+		level.bits = 0;
+		while((1u << level.bits) < size)
+			level.bits++;
+		level.offset = totalSize;
+		totalSize += numFrames_ * (size + 1);
+		levels_.push_back(level);
+	}
+	tables_.assign(totalSize, 0);
+
+	Fft fft(frameSize_);
+	std::vector<float> input(frameSize_);
+	std::vector<float> real(halfSize + 1), imaginary(halfSize + 1);
+
+	for(unsigned int frame = 0; frame < numFrames_; frame++) {
+		// Transform the frame once, and keep its spectrum
+		std::copy(frames + frame * frameSize_, frames + (frame + 1) * frameSize_, input.begin());
+		fft.fft(input);
+		for(unsigned int k = 0; k <= halfSize; k++) {
+			real[k] = fft.fdr(k);
+			imaginary[k] = fft.fdi(k);
+		}
+
+		for(const Level& level : levels_) {
+			// Keep the harmonics up to the limit, on both halves of the
+			// spectrum, and clear everything else
+			for(unsigned int k = 0; k < frameSize_; k++) {
+				fft.fdr(k) = 0;
+				fft.fdi(k) = 0;
+			}
+			for(unsigned int k = 1; k <= level.harmonics; k++) {
+				fft.fdr(k) = real[k];
+				fft.fdi(k) = imaginary[k];
+				fft.fdr(frameSize_ - k) = real[k];
+				fft.fdi(frameSize_ - k) = -imaginary[k];
+			}
+			fft.ifft();
+
+			// The result has no harmonics at or above the Nyquist frequency
+			// of the smaller table, so it can be decimated by just taking
+			// every step-th sample
+			unsigned int size = 1u << level.bits;
+			unsigned int step = frameSize_ / size;
+			float *table = &tables_[level.offset + frame * (size + 1)];
+			for(unsigned int n = 0; n < size; n++)
+				table[n] = fft.td(n * step);
+			table[size] = table[0];
+		}
+	}
+}
+
+// Move position towards target on one axis, but no further than the end of
+// the cell (pair of neighbouring frames) it starts in. When moving down from
+// a whole number, the cell below is used, so that the position can move.
+inline void WavetableScanner::stepAxis(float& position, float target, unsigned int count,
+									   unsigned int& cell, float& startWeight, float& endWeight)
+{
+	if(count < 2) {
+		cell = 0;
+		startWeight = endWeight = 0;
+		return;
+	}
+	int c = target >= position ? (int)floorf(position) : (int)ceilf(position) - 1;
+	c = std::min(std::max(c, 0), (int)count - 2);
+	float end = std::min(std::max(target, (float)c), (float)(c + 1));
+	startWeight = position - c;
+	endWeight = end - c;
+	position = end;
+	cell = c;
+}
+
+// Fill a buffer with the next frames samples
+inline void WavetableScanner::process(float * __restrict output, unsigned int frames)
+{
+	if(numFrames_ == 0 || frames == 0) {
+		std::fill(output, output + frames, 0.0f);
+		return;
+	}
+
+	// Choose the frames for this block and the weights at each end
+	unsigned int cellX, cellY;
+	float startX, endX, startY, endY;
+	stepAxis(x_, targetX_, columns_, cellX, startX, endX);
+	stepAxis(y_, targetY_, rows_, cellY, startY, endY);
+
+	const Level& level = levels_[level_];
+	unsigned int stride = (1u << level.bits) + 1;
+	const float *base = &tables_[level.offset];
+	unsigned int nextX = std::min(cellX + 1, columns_ - 1);
+	float inverseFrames = 1.0f / frames;
+
+	Block block;
+	if(rows_ == 1) {
+		block.table[0] = base + cellX * stride;
+		block.table[1] = base + nextX * stride;
+		block.weight[0] = 1.0f - startX;
+		block.weight[1] = startX;
+		block.step[0] = (startX - endX) * inverseFrames;
+		block.step[1] = (endX - startX) * inverseFrames;
+		render<2>(output, frames, block);
+	}
+	else {
+		unsigned int nextY = cellY + 1;
+		block.table[0] = base + (cellY * columns_ + cellX) * stride;
+		block.table[1] = base + (cellY * columns_ + nextX) * stride;
+		block.table[2] = base + (nextY * columns_ + cellX) * stride;
+		block.table[3] = base + (nextY * columns_ + nextX) * stride;
+		float start[4] = {(1.0f - startX) * (1.0f - startY), startX * (1.0f - startY),
+						  (1.0f - startX) * startY, startX * startY};
+		float end[4] = {(1.0f - endX) * (1.0f - endY), endX * (1.0f - endY),
+						(1.0f - endX) * endY, endX * endY};
+		for(unsigned int c = 0; c < 4; c++) {
+			block.weight[c] = start[c];
+			block.step[c] = (end[c] - start[c]) * inverseFrames;
+		}
+		render<4>(output, frames, block);
+	}
+}
+
+// Read kCorners frames with linear interpolation and mix them. The weights
+// are worked out from n on every frame rather than added up, so they end the
+// block exactly on the new position.
+template<unsigned int kCorners>
+inline void WavetableScanner::render(float * __restrict output, unsigned int frames, const Block& block)
+{
+	const unsigned int bits = levels_[level_].bits;
+	const unsigned int shift = 32 - bits;
+	const float kFractionScale = 1.0f / 16777216.0f;	// 2^-24
+	uint32_t phase = phase_;
+	unsigned int n = 0;
+
+#if defined(DSPCORE_FASTMATH_NEON) || defined(DSPCORE_FASTMATH_SSE2)
+	using namespace fastmath;
+	const float lanes[4] = {1, 2, 3, 4};
+	Float4 lane4 = load4(lanes);
+	for(; n + 4 <= frames; n += 4) {
+		// The integer part of the phase is the index, and the next 24 bits
+		// are the fraction between it and the sample above
+		unsigned int index[4];
+		float fraction[4];
+		for(unsigned int i = 0; i < 4; i++) {
+			index[i] = phase >> shift;
+			fraction[i] = (float)((phase << bits) >> 8) * kFractionScale;
+			phase += phaseIncrement_;
+		}
+		Float4 fraction4 = load4(fraction);
+		Float4 position4 = add4(set4((float)n), lane4);
+		Float4 out = set4(0.0f);
+		for(unsigned int c = 0; c < kCorners; c++) {
+			const float *table = block.table[c];
+			float below[4] = {table[index[0]], table[index[1]], table[index[2]], table[index[3]]};
+			float above[4] = {table[index[0] + 1], table[index[1] + 1], table[index[2] + 1], table[index[3] + 1]};
+			Float4 below4 = load4(below);
+			Float4 value = add4(below4, mul4(fraction4, sub4(load4(above), below4)));
+			Float4 weight = add4(set4(block.weight[c]), mul4(set4(block.step[c]), position4));
+			out = add4(out, mul4(weight, value));
+		}
+		store4(output + n, out);
+	}
+#endif
+	for(; n < frames; n++) {
+		unsigned int index = phase >> shift;
+		float fraction = (float)((phase << bits) >> 8) * kFractionScale;
+		phase += phaseIncrement_;
+		float out = 0;
+		for(unsigned int c = 0; c < kCorners; c++) {
+			const float *table = block.table[c];
+			float value = table[index] + fraction * (table[index + 1] - table[index]);
+			out += (block.weight[c] + block.step[c] * (float)(n + 1)) * value;
+		}
+		output[n] = out;
+	}
+	phase_ = phase;
+}
+
+} // namespace dsp
+
+using dsp::WavetableScanner;
\ No newline at end of file
@@ -0,0 +1,96 @@
+/*
+ ____  _____ _        _    
+| __ )| ____| |      / \   
+|  _ \|  _| | |     / _ \  
+| |_) | |___| |___ / ___ \ 
+|____/|_____|_____/_/   \_\
+
+http://bela.io
+
+C++ Real-Time Audio Programming with Bela - DspCore library
+*/
+
+// WorkStealingDeque.h: a fixed-size queue of task numbers for sharing work
+// between threads without locks (the Chase-Lev deque). One thread, the
+// owner, adds and takes tasks at the bottom. Any other thread can steal
+// tasks from the top, so idle threads take the oldest work first.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace dsp {
+
+template<unsigned int Capacity>
+class WorkStealingDeque {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+				  "WorkStealingDeque capacity must be a power of two");
+
+public:
+	// Constructor
+	WorkStealingDeque() {}
+
+	// Add a task at the bottom. Returns false if the deque is full. Owner only.
+	bool push(unsigned int task) {
+		int64_t bottom = bottom_.load(std::memory_order_relaxed);
+		int64_t top = top_.load(std::memory_order_acquire);
+		if(bottom - top >= (int64_t)Capacity)
+			return false;
+		tasks_[bottom & (Capacity - 1)].store(task, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom_.store(bottom + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	// Take the newest task. Returns false if there are none left. Owner only.
+	bool pop(unsigned int& task) {
+		int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+		bottom_.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = top_.load(std::memory_order_relaxed);
+
+		if(top > bottom) {
+			// Empty
+			bottom_.store(bottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+		task = tasks_[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+		if(top < bottom)
+			return true;
+
+		// Last task: a thief might be taking it at the same time
+		bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+												std::memory_order_relaxed);
+		bottom_.store(bottom + 1, std::memory_order_relaxed);
+		return won;
+	}
+
+	// Take the oldest task. Returns false if there are none, or if another
+	// thread took it first. Any thread.
+	bool steal(unsigned int& task) {
+		int64_t top = top_.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t bottom = bottom_.load(std::memory_order_acquire);
+		if(top >= bottom)
+			return false;
+		task = tasks_[top & (Capacity - 1)].load(std::memory_order_relaxed);
+		return top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+											std::memory_order_relaxed);
+	}
+
+	// Whether there appear to be no tasks. Only a hint while others are stealing.
+	bool empty() {
+		return bottom_.load(std::memory_order_acquire) <= top_.load(std::memory_order_acquire);
+	}
+
+private:
+	std::atomic<unsigned int> tasks_[Capacity] = {};
+	// Counters only ever increase, so 64 bits never wrap
+	alignas(64) std::atomic<int64_t> top_{0};		// Next task to steal
+	alignas(64) std::atomic<int64_t> bottom_{0};	// Next free slot
+};
+
+} // namespace dsp
+
+using dsp::WorkStealingDeque;
\ No newline at end of file